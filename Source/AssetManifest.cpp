@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    AssetManifest.cpp
+    Created: 20 Oct 2026 1:22:47am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "WdtpHeader.h"
+
+/** how many chars of the md5 will be a part of the copy's name */
+enum { hashLength = 10 };
+
+AssetManifest::AssetManifest()
+    : hashChanged (false)
+{
+}
+
+//=================================================================================================
+AssetManifest::~AssetManifest()
+{
+    clearSingletonInstance();
+}
+
+juce_ImplementSingleton (AssetManifest);
+
+//=================================================================================================
+void AssetManifest::refresh()
+{
+    const ScopedLock sl (lock);
+
+    Array<File> files;
+    getAddInDir().findChildFiles (files, File::findFiles, false);
+
+    HashMap<String, int> existingNames;
+    bool changed = false;
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        const File& file (files.getReference (i));
+        const String name (file.getFileName());
+
+        // a file without extension couldn't be told from its copy
+        if (isCopy (file) || file.isHidden() || file.getFileExtension().isEmpty())
+            continue;
+
+        existingNames.set (name, i);
+        const String stamp (getStamp (file));
+
+        if (assets.contains (name)
+            && assets[name].stamp == stamp
+            && file.getSiblingFile (getCopyName (name, assets[name].hash)).existsAsFile())
+            continue;
+
+        Asset asset;
+        asset.stamp = stamp;
+        asset.hash = MD5 (file).toHexString().substring (0, hashLength);
+
+        const File copyFile (file.getSiblingFile (getCopyName (name, asset.hash)));
+
+        // it'll be used without fingerprint
+        if (!copyFile.existsAsFile() && !file.copyFileTo (copyFile))
+            continue;
+
+        changed = changed || !assets.contains (name) || assets[name].hash != asset.hash;
+        assets.set (name, asset);
+    }
+
+    // the files which have been removed
+    StringArray removedNames;
+
+    for (HashMap<String, Asset>::Iterator itr (assets); itr.next(); )
+    {
+        if (!existingNames.contains (itr.getKey()))
+            removedNames.add (itr.getKey());
+    }
+
+    for (int i = removedNames.size(); --i >= 0; )
+        assets.remove (removedNames[i]);
+
+    if (changed || removedNames.size() > 0)
+    {
+        hashChanged = true;
+        rebuildReplacer();
+    }
+    else if (replacer == nullptr && assets.size() > 0)
+    {
+        rebuildReplacer();
+    }
+}
+
+//=================================================================================================
+void AssetManifest::rebuildReplacer()
+{
+    StringArray targets, replacements;
+
+    for (HashMap<String, Asset>::Iterator itr (assets); itr.next(); )
+    {
+        const String copyName (getCopyName (itr.getKey(), itr.getValue().hash));
+
+        targets.add ("add-in/" + itr.getKey() + "\"");
+        replacements.add ("add-in/" + copyName + "\"");
+
+        targets.add ("add-in/" + itr.getKey() + "'");
+        replacements.add ("add-in/" + copyName + "'");
+    }
+
+    replacer = (targets.size() > 0) ? new MultiReplacer (targets, replacements) : nullptr;
+}
+
+//=================================================================================================
+const String AssetManifest::rewriteUrls (const String& html) const
+{
+    MultiReplacer::Ptr currentReplacer;
+
+    {
+        const ScopedLock sl (lock);
+        currentReplacer = replacer;
+    }
+
+    return (currentReplacer != nullptr) ? currentReplacer->replaceAll (html) : html;
+}
+
+//=================================================================================================
+const bool AssetManifest::needsFullUpdate() const
+{
+    const ScopedLock sl (lock);
+    return hashChanged;
+}
+
+//=================================================================================================
+void AssetManifest::fullUpdateDone()
+{
+    const ScopedLock sl (lock);
+
+    HashMap<String, int> copyNames;
+
+    for (HashMap<String, Asset>::Iterator itr (assets); itr.next(); )
+        copyNames.set (getCopyName (itr.getKey(), itr.getValue().hash), 0);
+
+    Array<File> files;
+    getAddInDir().findChildFiles (files, File::findFiles, false);
+
+    for (int i = files.size(); --i >= 0; )
+    {
+        if (isCopy (files[i]) && !copyNames.contains (files[i].getFileName()))
+            files[i].deleteFile();
+    }
+
+    hashChanged = false;
+}
+
+//=================================================================================================
+const String AssetManifest::getCopyName (const String& fileName, const String& hash)
+{
+    return fileName.upToLastOccurrenceOf (".", false, false) + "." + hash
+        + fileName.fromLastOccurrenceOf (".", true, false);
+}
+
+//=================================================================================================
+const bool AssetManifest::isCopy (const File& file)
+{
+    const String nameWithoutExtension (file.getFileNameWithoutExtension());
+    const String hash (nameWithoutExtension.fromLastOccurrenceOf (".", false, false));
+
+    return nameWithoutExtension.containsChar ('.')
+        && hash.length() == hashLength
+        && hash.containsOnly ("0123456789abcdef");
+}
+
+//=================================================================================================
+const String AssetManifest::getStamp (const File& file)
+{
+    return String (file.getSize()) + "|" + String (file.getLastModificationTime().toMilliseconds());
+}
+
+//=================================================================================================
+const File AssetManifest::getAddInDir()
+{
+    return FileTreeContainer::projectFile.getSiblingFile ("site").getChildFile ("add-in");
+}
+
+//=================================================================================================
+void AssetManifest::loadForProject()
+{
+    const ScopedLock sl (lock);
+    clear();
+
+    const File manifestFile (FileTreeContainer::projectFile.withFileExtension ("assets"));
+
+    if (!manifestFile.existsAsFile())
+        return;
+
+    const ValueTree manifestTree (SwingUtilities::readValueTreeFromFile (manifestFile, true));
+
+    if (manifestTree.getType().toString() != "assetManifest")
+        return;
+
+    for (int i = 0; i < manifestTree.getNumChildren(); ++i)
+    {
+        const ValueTree assetTree (manifestTree.getChild (i));
+
+        Asset asset;
+        asset.stamp = assetTree.getProperty ("stamp").toString();
+        asset.hash = assetTree.getProperty ("hash").toString();
+
+        assets.set (assetTree.getProperty ("name").toString(), asset);
+    }
+
+    hashChanged = (bool)manifestTree.getProperty ("hashChanged");
+    rebuildReplacer();
+}
+
+//=================================================================================================
+void AssetManifest::saveForProject()
+{
+    const ScopedLock sl (lock);
+
+    if (!FileTreeContainer::projectTree.isValid() || assets.size() == 0)
+        return;
+
+    ValueTree manifestTree ("assetManifest");
+    manifestTree.setProperty ("hashChanged", hashChanged, nullptr);
+
+    for (HashMap<String, Asset>::Iterator itr (assets); itr.next(); )
+    {
+        ValueTree assetTree ("asset");
+        assetTree.setProperty ("name", itr.getKey(), nullptr);
+        assetTree.setProperty ("stamp", itr.getValue().stamp, nullptr);
+        assetTree.setProperty ("hash", itr.getValue().hash, nullptr);
+
+        manifestTree.addChild (assetTree, -1, nullptr);
+    }
+
+    SwingUtilities::writeValueTreeToFile (manifestTree,
+                                          FileTreeContainer::projectFile.withFileExtension ("assets"),
+                                          true);
+}
+
+//=================================================================================================
+void AssetManifest::clear()
+{
+    const ScopedLock sl (lock);
+
+    assets.clear();
+    replacer = nullptr;
+    hashChanged = false;
+}
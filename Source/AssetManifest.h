@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    AssetManifest.h
+    Created: 20 Oct 2026 1:22:47am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef ASSETMANIFEST_H_INCLUDED
+#define ASSETMANIFEST_H_INCLUDED
+
+/** Fingerprinted copies of the files in 'site/add-in' (css, js, logo, ad images...),
+    so that the server could let the browsers cache them forever.
+
+    For 'add-in/style.css', a copy named 'add-in/style.<hash>.css' will be written, the hash
+    is the first 10 chars of the md5 of its content. When a page is written, the urls of
+    these files (the ones inside "" or '') will be replaced with their copies'.
+
+    A file's md5 will only be computed again after its size or modified time changed.
+    If any hash has changed, all pages need to be regenerated (see needsFullUpdate()),
+    but the pages which don't use that file won't be written since their content is the same.
+    The out-of-date copies will be removed after that.
+
+    The manifest will be saved beside the project file (xxx.assets).
+*/
+class AssetManifest
+{
+public:
+    ~AssetManifest();
+    juce_DeclareSingleton (AssetManifest, true);
+
+    /** check the add-in files, write the copies of the new or changed ones */
+    void refresh();
+
+    /** replace the urls of the add-in files in the arg html with their copies' */
+    const String rewriteUrls (const String& html) const;
+
+    /** true if a hash has changed after the last time all pages were generated */
+    const bool needsFullUpdate() const;
+
+    /** all pages have been generated, the out-of-date copies could be removed now */
+    void fullUpdateDone();
+
+    void loadForProject();
+    void saveForProject();
+    void clear();
+
+private:
+    AssetManifest();
+
+    struct Asset
+    {
+        String stamp, hash;
+    };
+
+    /** e.g. 'style.css' -> 'style.0123456789.css' */
+    static const String getCopyName (const String& fileName, const String& hash);
+    static const bool isCopy (const File& file);
+    static const String getStamp (const File& file);
+    static const File getAddInDir();
+
+    /** the caller must hold the lock */
+    void rebuildReplacer();
+
+    //=================================================================================================
+    CriticalSection lock;
+    HashMap<String, Asset> assets;  // key: the file name in add-in dir
+    MultiReplacer::Ptr replacer;
+    bool hashChanged;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AssetManifest)
+};
+
+
+#endif  // ASSETMANIFEST_H_INCLUDED
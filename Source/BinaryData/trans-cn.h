@@ -16,6 +16,7 @@ countries: cn
 "Pack All Data" = "全部打包"
 "Export Single Big-Html..." = "文档批量集成..."
 "Import External Data" = "导入外部数据"
+"Importing..." = "正在导入..."
 "UTF-8 Text Doc(s)..." = "文本文档（UTF-8格式）..."
 "ANSI Text Doc(s)..." = "文本文档（ANSI格式）..."
 "Get Path" = "获取路径"
@@ -50,6 +51,7 @@ countries: cn
 "This file already exists, want to overwrite it?" = "此文件已存在，是否覆盖?"
 "Can\'t write to this file! " = "无法写入此文件! "
 "Export Failed." = "导出失败."
+"Exporting..." = "正在导出..."
 "Create a new document" = "新建新文档"
 "Please input the new doc\'s name." = "请输入新文档的名称."
 "Create a new folder" = "新建文件夹"
@@ -72,6 +74,10 @@ countries: cn
 "Sub-dirs: " = "子目录: "
 "Docs: " = "文档数: "
 "Total Words: " = "总字数: "
+"Chars: " = "字符数: "
+"CJK Chars: " = "中日韩字符: "
+"Audios: " = "音频: "
+"Videos: " = "视频: "
 "already exists. So what do you want? " = "已存在，您打算怎么做? "
 "Keep Both" = "二者均保留"
 "Overwrite" = "覆盖"
@@ -170,6 +176,11 @@ countries: cn
 "Yes" = "是的"
 "Create Date: " = "创建日期: "
 "Folder Setup" = "目录设置"
+"Docs Per Page: " = "每页文档数: "
+"List Order: " = "列表顺序: "
+"Newest First" = "最新创建优先"
+"Oldest First" = "最早创建优先"
+"Latest Modified First" = "最近修改优先"
 "Word Count: " = "字数统计: "
 "Title Image: " = "标题图片: "
 "Image File: " = "图片文件: "
@@ -199,6 +210,10 @@ countries: cn
 "Open/Add External Resource" = "打开/添加项目外源"
 "An external resource has been added successful" = "成功添加了一个项目外源"
 "Ex-resources: " = "项目外源: "
+"Minify Html: " = "压缩网页: "
+"Minify and write .gz" = "精简并生成 .gz"
+"Profile Generation: " = "生成性能分析: "
+"Write report and trace" = "写入报告和跟踪文件"
 "About..." = "关于..."
 "Silent Mode" = "安静模式"
 "Show File Tree Panel" = "文件树面板"
@@ -210,6 +225,8 @@ countries: cn
 "Cleanup all needless medias and regenerate the site?" = "确实要清理冗余数据并重新生成整站？"
 "The site regenerate successful!" = "整站生成完毕!"
 "All changed items regenerate successful!" = "所有已改变的条目重新生成完毕!"
+"Generating the changed pages..." = "正在生成已修改的页面..."
+"The generation has been cancelled." = "已取消生成。"
 "Do you want to reset the UI\'s color?" = "将界面背景颜色重置为默认吗?"
 "Export successful!" = "导出成功!"
 "Somehow the export failed." = "导出失败."
@@ -289,6 +306,7 @@ countries: cn
 "User cancelled" = "用户取消"
 "Error writing to file..." = "文件写入错误..."
 "An error occurred while trying to save \"DCNM\" to the file: FLNM" = "将 \"DCNM\" 保存到文件: FLNM 时出现错误."
+"Can't save these docs, and they can't be recovered next time:" = "无法保存以下文档, 且下次启动时也无法恢复:"
 "Closing document..." = "关闭文档..."
 "Do you want to save the changes to \"DCNM\"?" = "将已改变的数据保存到 \"DCNM\" 吗?"
 "Discard changes" = "放弃"
@@ -304,9 +322,12 @@ countries: cn
 "Somehow the project's data packed failed." = "不知为何，项目数据打包失败了……"
 "Pack successful!" = "打包成功!"
 "Somehow pack failed." = "不知为何，打包失败了……"
+"Packing the project..." = "正在打包项目..."
+"Packing..." = "正在打包..."
 "Pack Project" = "项目打包"
 "Invalid packed project." = "无效的打包项目."
 "Unpack failed: " = "打包项目解包失败："
+"The project is still being unpacked, please wait a moment." = "项目仍在解包中, 请稍候."
 "Internal Link" = "粘贴内部链接"
 "Click here" = "点此访问"
 "Abbrev: " = "缩略语: "
@@ -317,7 +338,7 @@ countries: cn
 "Description of this doc..." = "此文档的摘要……"
 "Can\'t import doc(s) inside the current project!" = "无需导入本项目内部的文档."
 "Can\'t import media file(s) inside the current project!" = "无需导入本项目内部的媒体文件."
-"Can\'t import a file which more than 512K :)" = "无法导入大小超过512K的文件 :)"
+"Can\'t import a file which more than 64M :)" = "无法导入大小超过64M的文件 :)"
 "No neeed to import a file which can't/no need to read :)" = "没必要导入无法阅读或缺乏实际内容的文件."
 "Identifier" = "标识符"
 " Walden Trip is GPL (v2) licensed." =" 本软件遵循GPL (v2)开源协议."
@@ -349,6 +370,11 @@ countries: cn
 "Audio: " = "音频："
 "Can\'t insert this Audio: " = "无法插入此音频："
 "Setup Audio Device..." = "设置音频驱动..."
+"Cancel Audio Encoding" = "取消音频编码"
+"Encoding the recorded audio..." = "正在编码录制的音频..."
+"The audio which hasn't been encoded will be lost, and its mark in the doc will point to a missing file." = "尚未编码的音频将丢失, 文档中的音频标记将指向不存在的文件."
+"Can't save this audio, the mark in this doc points to a missing file:" = "无法保存此音频, 此文档中的音频标记指向了不存在的文件:"
+"The disk was too slow while recording, SECS seconds of audio were lost. They were cut out rather than replaced by silence, so the recording is shorter and the audio after them comes earlier." = "录音时磁盘写入过慢, 丢失了 SECS 秒音频. 丢失的部分被直接删除而非以静音填充, 因此录音变短, 其后的音频会提前."
 "Show advanced settings..." = "显示高级设置..."
 "Error when trying to open audio device!" = "打开音频驱动时出现错误!"
 "(no audio output channels found)" = "(没找到音频输出通道)"
@@ -464,6 +490,7 @@ countries: cn
 "Rotate Right 90 Degress" = "向右旋转90度"
 "Width Decrease a Quarter" = "宽度减少1/4"
 "Half Width" = "宽度减少1/2"
+"Processing the image..." = "正在处理图像..."
 "View Html Code of Current Page" = "查看当前页的HTML源码"
 "Hide / Minimize" = "隐藏/最小化"
 "Root Path" = "根目录路径"
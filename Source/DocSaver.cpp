@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+    DocSaver.cpp
+    Created: 20 Oct 2026 2:05:31am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "WdtpHeader.h"
+
+/** the journal will be cleared once all the docs were written and it's larger than this */
+enum { maxJournalSize = 1024 * 1024 };
+
+DocSaver::DocSaver()
+    : Thread ("DocSaverThread"),
+      nextId (0),
+      writtenEvent (true),
+      listener (nullptr)
+{
+}
+
+//=================================================================================================
+DocSaver::~DocSaver()
+{
+    stopThread (5000);
+    cancelPendingUpdate();
+    clearSingletonInstance();
+}
+
+juce_ImplementSingleton (DocSaver);
+
+//=================================================================================================
+void DocSaver::saveInBackground (const File& docFile, const String& content)
+{
+    Snapshot snapshot;
+    snapshot.docFile = docFile;
+    snapshot.path = docFile.getRelativePathFrom (FileTreeContainer::projectFile.getParentDirectory());
+    snapshot.content = content;
+
+    {
+        const ScopedLock sl (lock);
+
+        // the older one which hasn't been written is needless now
+        for (int i = snapshots.size(); --i >= 0; )
+        {
+            if (snapshots.getReference (i).docFile == docFile)
+                snapshots.remove (i);
+        }
+
+        snapshots.add (snapshot);
+        writtenEvent.reset();
+    }
+
+    if (!isThreadRunning())
+        startThread();
+
+    notify();
+}
+
+//=================================================================================================
+const bool DocSaver::waitUntilSaved (const File& docFile)
+{
+    while (isPending (docFile))
+        writtenEvent.wait (50);
+
+    const ScopedLock sl (lock);
+    return !failedDocs.contains (docFile);
+}
+
+//=================================================================================================
+const bool DocSaver::isPending (const File& docFile) const
+{
+    const ScopedLock sl (lock);
+
+    if (writingDoc == docFile)
+        return true;
+
+    for (int i = snapshots.size(); --i >= 0; )
+    {
+        if (snapshots.getReference (i).docFile == docFile)
+            return true;
+    }
+
+    return false;
+}
+
+//=================================================================================================
+void DocSaver::run()
+{
+    while (!threadShouldExit())
+    {
+        Snapshot snapshot;
+        File journal;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (snapshots.size() > 0)
+            {
+                snapshot = snapshots.getReference (0);
+                snapshots.remove (0);
+                writingDoc = snapshot.docFile;
+                journal = journalFile;
+            }
+        }
+
+        // nothing to do, wait for the next one
+        if (snapshot.docFile == File::nonexistent)
+        {
+            writtenEvent.signal();
+            wait (-1);
+            continue;
+        }
+
+        const bool saved = writeSnapshot (snapshot, journal);
+        const DocStatistics::Stats stats (DocStatistics::scan (snapshot.content));
+
+        if (saved)
+            DocStatistics::getInstance()->updateDoc (snapshot.docFile, stats);
+
+        {
+            const ScopedLock sl (lock);
+            writingDoc = File::nonexistent;
+
+            if (saved)
+                failedDocs.removeAllInstancesOf (snapshot.docFile);
+            else
+                failedDocs.addIfNotAlreadyThere (snapshot.docFile);
+
+            SavedDoc savedDoc;
+            savedDoc.docFile = snapshot.docFile;
+            savedDoc.wordCount = stats.words;
+            savedDoc.saved = saved;
+            savedDocs.add (savedDoc);
+
+            // nothing could be recovered from it now
+            if (snapshots.size() == 0 && failedDocs.size() == 0
+                && journal.getSize() > maxJournalSize)
+                journal.deleteFile();
+        }
+
+        writtenEvent.signal();
+        triggerAsyncUpdate();
+    }
+}
+
+//=================================================================================================
+const bool DocSaver::writeSnapshot (const Snapshot& snapshot, const File& journal)
+{
+    const int64 id = ++nextId;
+
+    // record format: 'doc <id> <numBytes> <path>\n<content>\n' and 'saved <id> <path>\n'
+    const bool inJournal = (journal != File::nonexistent)
+        && appendToJournal (journal, "doc " + String (id) + " "
+                            + String ((int) snapshot.content.getNumBytesAsUTF8()) + " "
+                            + snapshot.path + "\n" + snapshot.content + "\n");
+
+    if (!writeDoc (snapshot.docFile, snapshot.content))
+    {
+        // it can't be recovered next time, the user must know it now
+        if (!inJournal)
+        {
+            const ScopedLock sl (lock);
+            lostDocs.addIfNotAlreadyThere (snapshot.docFile);
+        }
+
+        return false;
+    }
+
+    // a missing 'saved' record only makes the same content be written again next time
+    if (inJournal)
+        appendToJournal (journal, "saved " + String (id) + " " + snapshot.path + "\n");
+
+    return true;
+}
+
+//=================================================================================================
+const bool DocSaver::appendToJournal (const File& journal, const String& record)
+{
+    FileOutputStream out (journal);
+
+    if (out.failedToOpen())
+        return false;
+
+    out.writeText (record, false, false);
+    out.flush();
+
+    return !out.getStatus().failed();
+}
+
+//=================================================================================================
+const bool DocSaver::writeDoc (const File& docFile, const String& content)
+{
+    TemporaryFile tempFile (docFile);
+
+    return tempFile.getFile().appendText (content)
+        && tempFile.overwriteTargetFileWithTemporary();
+}
+
+//=================================================================================================
+void DocSaver::handleAsyncUpdate()
+{
+    Array<SavedDoc> docs;
+    Array<File> lost;
+
+    {
+        const ScopedLock sl (lock);
+        docs.swapWith (savedDocs);
+        lost.swapWith (lostDocs);
+    }
+
+    for (int i = 0; i < docs.size() && listener != nullptr; ++i)
+    {
+        const SavedDoc& doc (docs.getReference (i));
+
+        if (doc.saved)
+            listener->docSaved (doc.docFile, doc.wordCount);
+        else
+            listener->docSaveFailed (doc.docFile);
+    }
+
+    if (lost.size() > 0)
+    {
+        String info (TRANS ("Can't save these docs, and they can't be recovered next time:"));
+
+        for (int i = 0; i < lost.size(); ++i)
+            info << newLine << lost.getReference (i).getFullPathName();
+
+        // not a splash, it must be seen
+        AlertWindow::showMessageBoxAsync (AlertWindow::WarningIcon, TRANS ("Message"), info);
+    }
+}
+
+//=================================================================================================
+void DocSaver::loadForProject()
+{
+    const File projectDir (FileTreeContainer::projectFile.getParentDirectory());
+    const File journal (FileTreeContainer::projectFile.withFileExtension ("journal"));
+
+    {
+        const ScopedLock sl (lock);
+        journalFile = journal;
+    }
+
+    if (!journal.existsAsFile())
+        return;
+
+    MemoryBlock data;
+    journal.loadFileAsData (data);
+
+    const char* p = static_cast<const char*> (data.getData());
+    const char* const end = p + data.getSize();
+
+    // key: the doc's path, the last snapshot which hasn't been saved and its id
+    HashMap<String, String> unsavedContents;
+    HashMap<String, int64> unsavedIds;
+
+    while (p < end)
+    {
+        const char* lineEnd = p;
+
+        while (lineEnd < end && *lineEnd != '\n')
+            ++lineEnd;
+
+        // the last record was broken by the crash
+        if (lineEnd == end)
+            break;
+
+        const String line (String::fromUTF8 (p, (int) (lineEnd - p)));
+        p = lineEnd + 1;
+
+        const String type (line.upToFirstOccurrenceOf (" ", false, false));
+        String rest (line.fromFirstOccurrenceOf (" ", false, false));
+
+        const int64 id = rest.upToFirstOccurrenceOf (" ", false, false).getLargeIntValue();
+        rest = rest.fromFirstOccurrenceOf (" ", false, false);
+
+        if (type == "doc")
+        {
+            const int numBytes = rest.upToFirstOccurrenceOf (" ", false, false).getIntValue();
+            const String path (rest.fromFirstOccurrenceOf (" ", false, false));
+
+            if (numBytes < 0 || end - p < numBytes + 1)
+                break;
+
+            unsavedContents.set (path, String::fromUTF8 (p, numBytes));
+            unsavedIds.set (path, id);
+            p += numBytes + 1;
+        }
+        else if (type == "saved")
+        {
+            if (unsavedIds.contains (rest) && unsavedIds[rest] <= id)
+            {
+                unsavedContents.remove (rest);
+                unsavedIds.remove (rest);
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    for (HashMap<String, String>::Iterator itr (unsavedContents); itr.next(); )
+    {
+        const File docFile (projectDir.getChildFile (itr.getKey()));
+        FileTreeContainer::makeSureFileUnpacked (docFile);
+
+        if (docFile.loadFileAsString() != itr.getValue())
+            writeDoc (docFile, itr.getValue());
+    }
+
+    journal.deleteFile();
+}
+
+//=================================================================================================
+void DocSaver::saveForProject()
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (snapshots.size() == 0 && writingDoc == File::nonexistent)
+            {
+                // the failed ones will be recovered next time
+                if (failedDocs.size() == 0)
+                    journalFile.deleteFile();
+
+                failedDocs.clear();
+                journalFile = File::nonexistent;
+                return;
+            }
+        }
+
+        writtenEvent.wait (50);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    DocSaver.h
+    Created: 20 Oct 2026 2:05:31am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef DOCSAVER_H_INCLUDED
+#define DOCSAVER_H_INCLUDED
+
+/** Write the docs in background, so that autosaving a long doc won't block the editor.
+
+    The caller hands over a snapshot of the doc's content (a String, which is cheap to copy),
+    only the latest snapshot of a doc which hasn't been written will be kept.
+
+    Before a doc is written, its snapshot will be appended to a journal beside the project
+    file (xxx.journal), and a 'saved' record will be appended after it has been written.
+    If the app crashed (or the doc couldn't be written), the snapshots which haven't been
+    saved will be written to their docs when the project is opened next time.
+*/
+class DocSaver : private Thread,
+                 private AsyncUpdater
+{
+public:
+    ~DocSaver();
+    juce_DeclareSingleton (DocSaver, true);
+
+    /** write the arg content to the doc in background */
+    void saveInBackground (const File& docFile, const String& content);
+
+    /** wait until the last snapshot of the doc has been written.
+        return false if it couldn't be written. */
+    const bool waitUntilSaved (const File& docFile);
+
+    //=================================================================================================
+    class Listener
+    {
+    public:
+        virtual ~Listener() { }
+
+        /** they'll be called on the message thread. the word count doesn't include ' ' and newLine.
+            a failed snapshot won't be written again, the listener should hand it over once more. */
+        virtual void docSaved (const File& docFile, const int wordCount) = 0;
+        virtual void docSaveFailed (const File& docFile) = 0;
+    };
+
+    void setListener (Listener* newListener)       { listener = newListener; }
+
+    //=================================================================================================
+    /** write the snapshots left by a crash to their docs */
+    void loadForProject();
+
+    /** wait for all the snapshots have been written, then remove the journal */
+    void saveForProject();
+
+private:
+    DocSaver();
+
+    struct Snapshot
+    {
+        File docFile;
+        String path;        // relative to the project's dir, for the journal
+        String content;
+    };
+
+    struct SavedDoc
+    {
+        File docFile;
+        int wordCount;
+        bool saved;
+    };
+
+    virtual void run() override;
+    void handleAsyncUpdate() override;
+
+    const bool writeSnapshot (const Snapshot& snapshot, const File& journal);
+    const bool isPending (const File& docFile) const;
+
+    static const bool appendToJournal (const File& journal, const String& record);
+    static const bool writeDoc (const File& docFile, const String& content);
+
+    //=================================================================================================
+    CriticalSection lock;
+    Array<Snapshot> snapshots;
+    Array<SavedDoc> savedDocs;
+    Array<File> failedDocs;
+    Array<File> lostDocs;       // failed and couldn't be written to the journal either
+    File writingDoc, journalFile;
+    int64 nextId;
+
+    WaitableEvent writtenEvent;
+    Listener* listener;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DocSaver)
+};
+
+
+#endif  // DOCSAVER_H_INCLUDED
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+    DocStatistics.cpp
+    Created: 20 Oct 2026 2:41:09am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "WdtpHeader.h"
+
+DocStatistics::Stats::Stats()
+    : chars (0), cjkChars (0), words (0),
+      innerImgs (0), exImgs (0), audios (0), videos (0)
+{
+}
+
+//=================================================================================================
+DocStatistics::Stats& DocStatistics::Stats::operator+= (const Stats& other)
+{
+    chars += other.chars;
+    cjkChars += other.cjkChars;
+    words += other.words;
+    innerImgs += other.innerImgs;
+    exImgs += other.exImgs;
+    audios += other.audios;
+    videos += other.videos;
+
+    return *this;
+}
+
+//=================================================================================================
+DocStatistics::DocStatistics()
+{
+}
+
+//=================================================================================================
+DocStatistics::~DocStatistics()
+{
+    clearSingletonInstance();
+}
+
+juce_ImplementSingleton (DocStatistics);
+
+//=================================================================================================
+const DocStatistics::Stats DocStatistics::scan (const String& content)
+{
+    Stats stats;
+
+    for (String::CharPointerType p (content.getCharPointer()); !p.isEmpty(); )
+    {
+        const juce_wchar c = p.getAndAdvance();
+        ++stats.chars;
+
+        if (c != ' ' && c != '\r' && c != '\n')
+            ++stats.words;
+
+        if (isCjkChar (c))
+            ++stats.cjkChars;
+    }
+
+    // for markdown img
+    int index = content.indexOf (0, "![");
+
+    while (index != -1)
+    {
+        if (content.substring (index - 1, index) != "\\")
+        {
+            if (content.substring (index + 2, index + 6).toLowerCase() == "http")
+                ++stats.exImgs;
+            else
+                ++stats.innerImgs;
+        }
+
+        index = content.indexOf (index + 2, "![");
+    }
+
+    // for html img, count as external image
+    index = content.indexOf (0, "<img src=");
+
+    while (index != -1)
+    {
+        ++stats.exImgs;
+        index = content.indexOf (index + 9, "<img src=");
+    }
+
+    // ~[](media/xxx.mp3) and @[](media/xxx.mp4 = 680)
+    stats.audios = countMarks (content, "~[](");
+    stats.videos = countMarks (content, "@[](");
+
+    return stats;
+}
+
+//=================================================================================================
+const int DocStatistics::countMarks (const String& content, const String& mark)
+{
+    int nums = 0;
+    int index = content.indexOf (0, mark);
+
+    while (index != -1)
+    {
+        if (content.substring (index - 1, index) != "\\")
+            ++nums;
+
+        index = content.indexOf (index + mark.length(), mark);
+    }
+
+    return nums;
+}
+
+//=================================================================================================
+const bool DocStatistics::isCjkChar (const juce_wchar c)
+{
+    return (c >= 0x4e00 && c <= 0x9fff)     // CJK unified ideographs
+        || (c >= 0x3400 && c <= 0x4dbf)     // extension A
+        || (c >= 0x20000 && c <= 0x2fa1f)   // extension B... and compatibility supplement
+        || (c >= 0xf900 && c <= 0xfaff)     // compatibility ideographs
+        || (c >= 0x3040 && c <= 0x30ff)     // hiragana and katakana
+        || (c >= 0xac00 && c <= 0xd7af);    // hangul syllables
+}
+
+//=================================================================================================
+void DocStatistics::updateDoc (const File& mdFile, const Stats& stats)
+{
+    DocRecord record;
+    record.stamp = getStamp (mdFile);
+    record.stats = stats;
+
+    const ScopedLock sl (lock);
+    docs.set (getKey (mdFile), record);
+}
+
+//=================================================================================================
+const DocStatistics::Stats DocStatistics::getDocStats (const File& mdFile)
+{
+    if (!mdFile.existsAsFile())
+        return Stats();
+
+    const String key (getKey (mdFile));
+    const String stamp (getStamp (mdFile));
+
+    {
+        const ScopedLock sl (lock);
+
+        if (docs.contains (key) && docs[key].stamp == stamp)
+            return docs[key].stats;
+    }
+
+    const Stats stats (scan (mdFile.loadFileAsString()));
+    updateDoc (mdFile, stats);
+
+    return stats;
+}
+
+//=================================================================================================
+const DocStatistics::Stats DocStatistics::getTreeStats (const ValueTree& tree, int& dirNums)
+{
+    if (tree.getType().toString() == "doc")
+        return getDocStats (DocTreeViewItem::getMdFileOrDir (tree));
+
+    ++dirNums;
+    Stats stats;
+
+    for (int i = tree.getNumChildren(); --i >= 0; )
+        stats += getTreeStats (tree.getChild (i), dirNums);
+
+    return stats;
+}
+
+//=================================================================================================
+const String DocStatistics::getKey (const File& mdFile)
+{
+    const String key (mdFile.getRelativePathFrom (FileTreeContainer::projectFile.getParentDirectory())
+                      .replace ("\\", "/"));
+
+    return File::areFileNamesCaseSensitive() ? key : key.toLowerCase();
+}
+
+//=================================================================================================
+const String DocStatistics::getStamp (const File& mdFile)
+{
+    return String (mdFile.getSize()) + "|" + String (mdFile.getLastModificationTime().toMilliseconds());
+}
+
+//=================================================================================================
+void DocStatistics::loadForProject()
+{
+    const ScopedLock sl (lock);
+    clear();
+
+    const File statisFile (FileTreeContainer::projectFile.withFileExtension ("statis"));
+
+    if (!statisFile.existsAsFile())
+        return;
+
+    const ValueTree statisTree (SwingUtilities::readValueTreeFromFile (statisFile, true));
+
+    if (statisTree.getType().toString() != "docStatistics")
+        return;
+
+    for (int i = 0; i < statisTree.getNumChildren(); ++i)
+    {
+        const ValueTree doc (statisTree.getChild (i));
+
+        DocRecord record;
+        record.stamp = doc.getProperty ("stamp").toString();
+        record.stats.chars = doc.getProperty ("chars");
+        record.stats.cjkChars = doc.getProperty ("cjkChars");
+        record.stats.words = doc.getProperty ("words");
+        record.stats.innerImgs = doc.getProperty ("innerImgs");
+        record.stats.exImgs = doc.getProperty ("exImgs");
+        record.stats.audios = doc.getProperty ("audios");
+        record.stats.videos = doc.getProperty ("videos");
+
+        docs.set (doc.getProperty ("key").toString(), record);
+    }
+}
+
+//=================================================================================================
+void DocStatistics::saveForProject()
+{
+    const ScopedLock sl (lock);
+
+    if (!FileTreeContainer::projectTree.isValid() || docs.size() == 0)
+        return;
+
+    const File projectDir (FileTreeContainer::projectFile.getParentDirectory());
+    ValueTree statisTree ("docStatistics");
+
+    for (HashMap<String, DocRecord>::Iterator itr (docs); itr.next(); )
+    {
+        // the docs which have been deleted or moved
+        if (!projectDir.getChildFile (itr.getKey()).existsAsFile())
+            continue;
+
+        const Stats& stats (itr.getValue().stats);
+        ValueTree doc ("doc");
+
+        doc.setProperty ("key", itr.getKey(), nullptr);
+        doc.setProperty ("stamp", itr.getValue().stamp, nullptr);
+        doc.setProperty ("chars", stats.chars, nullptr);
+        doc.setProperty ("cjkChars", stats.cjkChars, nullptr);
+        doc.setProperty ("words", stats.words, nullptr);
+        doc.setProperty ("innerImgs", stats.innerImgs, nullptr);
+        doc.setProperty ("exImgs", stats.exImgs, nullptr);
+        doc.setProperty ("audios", stats.audios, nullptr);
+        doc.setProperty ("videos", stats.videos, nullptr);
+
+        statisTree.addChild (doc, -1, nullptr);
+    }
+
+    SwingUtilities::writeValueTreeToFile (statisTree,
+                                          FileTreeContainer::projectFile.withFileExtension ("statis"),
+                                          true);
+}
+
+//=================================================================================================
+void DocStatistics::clear()
+{
+    const ScopedLock sl (lock);
+    docs.clear();
+}
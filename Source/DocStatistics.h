@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    DocStatistics.h
+    Created: 20 Oct 2026 2:41:09am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef DOCSTATISTICS_H_INCLUDED
+#define DOCSTATISTICS_H_INCLUDED
+
+/** The statistics of each doc (chars, words, images, audios and videos),
+    so that the statistics of a dir or the whole project needn't read all its docs again.
+
+    A doc's statistics are computed when it has been saved (see DocSaver), or when it's
+    asked for but the doc has been changed outside (its size or modified time isn't the same).
+    The ones of a dir or the project are the sum of its docs' in the project tree.
+
+    The statistics will be saved beside the project file (xxx.statis).
+*/
+class DocStatistics
+{
+public:
+    ~DocStatistics();
+    juce_DeclareSingleton (DocStatistics, true);
+
+    struct Stats
+    {
+        Stats();
+        Stats& operator+= (const Stats& other);
+
+        int chars;          // all the chars
+        int cjkChars;       // Chinese, Japanese and Korean chars
+        int words;          // the chars except ' ' and newLine, same as the editor's word count
+        int innerImgs, exImgs, audios, videos;
+    };
+
+    /** scan the md content, it doesn't touch any file */
+    static const Stats scan (const String& content);
+
+    /** the doc has just been written with the content which arg-2 is computed from.
+        it could be called on any thread. */
+    void updateDoc (const File& mdFile, const Stats& stats);
+
+    /** the doc will be read and scanned only if it has been changed since the last time */
+    const Stats getDocStats (const File& mdFile);
+
+    /** the sum of the docs in the arg tree (a doc, dir or the project).
+        arg-2 will be added the number of the dirs in it (including itself). */
+    const Stats getTreeStats (const ValueTree& tree, int& dirNums);
+
+    void loadForProject();
+    void saveForProject();
+    void clear();
+
+private:
+    DocStatistics();
+
+    /** based on the project dir, e.g. 'docs/dir/doc.md' */
+    static const String getKey (const File& mdFile);
+    static const String getStamp (const File& mdFile);
+
+    static const bool isCjkChar (const juce_wchar c);
+
+    /** the number of arg-2 which isn't escaped by a '\' */
+    static const int countMarks (const String& content, const String& mark);
+
+    //=================================================================================================
+    struct DocRecord
+    {
+        String stamp;
+        Stats stats;
+    };
+
+    CriticalSection lock;
+    HashMap<String, DocRecord> docs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DocStatistics)
+};
+
+
+#endif  // DOCSTATISTICS_H_INCLUDED
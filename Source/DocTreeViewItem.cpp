@@ -210,13 +210,35 @@ const int DocTreeViewItem::getHtmlMediaFiles (const File& htmlFile, Array<File>&
             indexEnd = htmlStr.indexOf (indexStart + 5, "\"");
     }
 
+    // the responsive copies, e.g. srcset="media/a-w600.jpg 600w, media/a.jpg 1200w"
+    for (int start = htmlStr.indexOf (0, "srcset=\""); start != -1; start = htmlStr.indexOf (start + 8, "srcset=\""))
+    {
+        const int end = htmlStr.indexOf (start + 8, "\"");
+
+        if (end == -1)
+            break;
+
+        StringArray candidates;
+        candidates.addTokens (htmlStr.substring (start + 8, end), ",", String());
+
+        for (int i = 0; i < candidates.size(); ++i)
+        {
+            const File& f (htmlFile.getSiblingFile ("media")
+                           .getChildFile (candidates[i].trim().upToFirstOccurrenceOf (" ", false, false)
+                                          .fromFirstOccurrenceOf ("media/", false, false)));
+
+            if (f.existsAsFile() && f.getSize() > 0)
+                files.addIfNotAlreadyThere (f);
+        }
+    }
+
     return files.size();
 }
 
 //=================================================================================================
-const int DocTreeViewItem::getMdMediaFiles (const File& doc, Array<File>& files)
+const int DocTreeViewItem::getMdMediaFiles (const File& doc, Array<File>& files, const bool onlyExisting)
 {
-    if (doc.isDirectory() || !doc.getSiblingFile ("media").exists())
+    if (doc.isDirectory() || (onlyExisting && !doc.getSiblingFile ("media").exists()))
         return 0;
 
     String htmlStr = Md2Html::imageParse (doc.loadFileAsString());
@@ -234,7 +256,7 @@ const int DocTreeViewItem::getMdMediaFiles (const File& doc, Array<File>& files)
                        .getChildFile (htmlStr.substring (indexStart + 11, indexEnd) // 11: src="media/
                                       .trimCharactersAtStart ("/")));
 
-        if (f.existsAsFile() && f.getSize() > 0)
+        if (!onlyExisting || (f.existsAsFile() && f.getSize() > 0))
             files.add (f);
 
         indexStart = htmlStr.indexOf (indexEnd + 2, "src=\"");
@@ -255,24 +277,56 @@ void DocTreeViewItem::needCreate (ValueTree tree)
     ValueTree parentTree = tree;
     const String modifyDate (SwingUtilities::getTimeStringWithSeparator (SwingUtilities::getCurrentTimeString(), true));
 
-    parentTree.setProperty ("needCreateHtml", true, nullptr);
-    parentTree.setProperty ("modifyDate", modifyDate, nullptr);
+    // the changed item and all its parents have been modified
+    Array<ValueTree> modifiedTrees;
+    modifiedTrees.add (tree);
+    tree.setProperty ("modifyDate", modifyDate, nullptr);
 
     while (parentTree.getParent().isValid())
     {
         parentTree = parentTree.getParent();
-        parentTree.setProperty ("needCreateHtml", true, nullptr);
         parentTree.setProperty ("modifyDate", modifyDate, nullptr);
+        modifiedTrees.add (parentTree);
 
         ValueTree indexTree (parentTree.getChildWithProperty ("name", var ("index")));
 
         if (indexTree.isValid())
         {
-            indexTree.setProperty ("needCreateHtml", true, nullptr);
             indexTree.setProperty ("modifyDate", modifyDate, nullptr);
+            modifiedTrees.add (indexTree);
         }
     }
 
+    // only regenerate the pages which have read the changed properties of them
+    Array<ValueTree> affectedPages (modifiedTrees);
+    bool graphKnowsAll = true;
+
+    for (int i = 0; i < modifiedTrees.size() && graphKnowsAll; ++i)
+    {
+        // the project's modified date only shows on its own index
+        if (i > 0 && modifiedTrees[i].getType().toString() == "wdtpProject")
+            continue;
+
+        graphKnowsAll = PageDependencies::getInstance()->getAffectedPages (modifiedTrees[i], affectedPages);
+    }
+
+    if (graphKnowsAll)
+    {
+        ValueTree indexTree (tree.getChildWithProperty ("name", var ("index")));
+
+        if (indexTree.isValid())
+            affectedPages.add (indexTree);
+
+        for (int i = affectedPages.size(); --i >= 0; )
+            affectedPages.getReference (i).setProperty ("needCreateHtml", true, nullptr);
+
+        return;
+    }
+
+    // there's no dependencies to know which pages, so all its parents and children
+    for (int i = modifiedTrees.size(); --i >= 0; )
+        modifiedTrees.getReference (i).setProperty ("needCreateHtml", true, nullptr);
+
     allChildrenNeedCreate (tree);
 }
 
@@ -488,7 +542,7 @@ void DocTreeViewItem::packSiteData (const bool includeHtmls, const bool includeM
     TopToolBar::generateHtmlFilesIfNeeded (tree);
 
     const File thisDir (getHtmlFile (tree).getParentDirectory());
-    ZipFile::Builder builder;
+    ZipPacker packer;
     Array<File> htmlFiles;
     thisDir.findChildFiles (htmlFiles, File::findFiles, true, "*");
 
@@ -513,7 +567,7 @@ void DocTreeViewItem::packSiteData (const bool includeHtmls, const bool includeM
             // Note: it'll include 'add-in' when pack the root-item
             // and perhaps include other data. for example:
             // user created or copied some data
-            builder.addFile (htmlFiles[i], 9, pathStr);
+            packer.addFile (htmlFiles[i], pathStr);
         }
     }
 
@@ -526,15 +580,10 @@ void DocTreeViewItem::packSiteData (const bool includeHtmls, const bool includeM
         postfix = "-medias";
 
     const File packZipFile (thisDir.getChildFile (tree.getProperty ("name").toString() + postfix + ".zip"));
-    packZipFile.deleteFile();
-    packZipFile.create();
 
-    ScopedPointer<FileOutputStream> out = packZipFile.createOutputStream();
-
-    if (builder.writeToStream (*out, nullptr))
+    // the last pack of this dir is the previous archive, its unchanged entries will be reused
+    if (packer.writeToFileWithProgress (packZipFile, TRANS ("Packing..."), packZipFile))
     {
-        out->flush();
-        out = nullptr;
         SHOW_MESSAGE (TRANS ("Pack successful!"));
 
         packZipFile.revealToUser();
@@ -646,6 +695,10 @@ void DocTreeViewItem::renameSelectedItem()
             if (siteOldFile.exists())
                 siteOldFile.moveFileTo (siteNewFile);
 
+            // the page will be generated again, so will its .gz
+            if (!newDocFile.isDirectory())
+                File (siteOldFile.getFullPathName() + ".gz").deleteFile();
+
             // here must re-select this item
             setSelected (false, false, dontSendNotification);
             setSelected (true, true);
@@ -691,36 +744,66 @@ void DocTreeViewItem::exportAsHtml()
         return;
     }
 
-    htmlFile.create();
-    
-    // create a md-text file temporarily, then gathering all medias of this dir
-    File mdFile (File::getSpecialLocation (File::tempDirectory).getSiblingFile ("wdtpExport.md"));
-    mdFile.deleteFile();
-    mdFile.create();
+    // the docs of this dir and their medias
+    Array<ValueTree> docs;
     Array<File> allMedias;
-            
-    if (getDirDocsAndAllMedias (this, mdFile, allMedias))
-    {
-        // add title, description and [TOC], then generate the html file
-        const String titleStr (tree.getProperty ("title").toString());
-        const String descStr (tree.getProperty ("description").toString());
-        const String contentStr = "# " + titleStr + newLine + newLine
-            + descStr + newLine + newLine
-            + "[TOC]" + newLine + newLine + mdFile.loadFileAsString();
-
-        htmlFile.appendText ("<!doctype html>\n"
-                             "<html lang = \"en\">\n"
-                             "<head>\n"
-                             "<meta charset = \"UTF-8\">\n"
-                             "  <link rel = \"stylesheet\" type = \"text/css\" href = \"media/style.css\"/>\n"
-                             "  <script src = \"media/hl.js\"></script>\n"
-                             "  <script>hljs.initHighlightingOnLoad(); </script>\n"
-                             "<title>" + titleStr + "</title>\n"
-                             "</head>\n"
-                             "<body>\n\n" + Md2Html::mdStringToHtml (contentStr) + "\n\n"
-                             "</body>\n"
-                             "</html>");
+    getDirDocs (this, docs);
+
+    // the docs are rendered in parallel and streamed into the file in background
+    struct ExportThread : public ThreadWithProgressWindow
+    {
+        ExportThread (const ValueTree& dirTree_, const Array<ValueTree>& docs_, 
+                      const File& htmlFile_, Array<File>& medias_)
+            : ThreadWithProgressWindow (TRANS ("Exporting..."), true, true),
+            dirTree (dirTree_), docs (docs_), htmlFile (htmlFile_), medias (medias_), exported (false)
+        {
+        }
+
+        void run() override
+        {
+            FileOutputStream out (htmlFile);
+            const String titleStr (dirTree.getProperty ("title").toString());
+
+            if (out.failedToOpen())
+                return;
+
+            out << "<!doctype html>\n"
+                   "<html lang = \"en\">\n"
+                   "<head>\n"
+                   "<meta charset = \"UTF-8\">\n"
+                   "  <link rel = \"stylesheet\" type = \"text/css\" href = \"media/style.css\"/>\n"
+                   "<title>" << titleStr << "</title>\n"
+                   "</head>\n"
+                   "<body>\n\n";
+
+            exported = HtmlProcessor::writeSingleHtmlBody (dirTree, docs, out, medias, this);
+
+            out << "\n\n"
+                   "</body>\n"
+                   "</html>";
 
+            out.flush();
+            exported = exported && !out.getStatus().failed();
+        }
+
+        const ValueTree dirTree;
+        const Array<ValueTree>& docs;
+        const File htmlFile;
+        Array<File>& medias;
+        bool exported;
+    };
+
+    ExportThread thread (tree, docs, htmlFile, allMedias);
+
+    // cancelled, the file is incomplete
+    if (!thread.runThread())
+    {
+        htmlFile.deleteFile();
+        return;
+    }
+
+    if (thread.exported)
+    {
         // create its media folder and copy all medias into it
         const File mediaDir (htmlFile.getSiblingFile ("media"));
         mediaDir.createDirectory();
@@ -732,20 +815,13 @@ void DocTreeViewItem::exportAsHtml()
             allMedias[i].copyFileTo (targetFile);
         }
 
-        // copy stylesheet into the media folder
+        // copy stylesheet into the media folder, the code has been highlighted, needn't hl.js
         const File& styleCss (FileTreeContainer::projectFile.getSiblingFile ("site")
                                .getChildFile ("add-in").getChildFile ("style.css"));
 
-        const File& hlJs (FileTreeContainer::projectFile.getSiblingFile ("site")
-                          .getChildFile ("add-in").getChildFile ("hl.js"));
-
         const File targetCss (mediaDir.getChildFile (styleCss.getFileName()));
-        const File targetJs (mediaDir.getChildFile (hlJs.getFileName()));
         targetCss.create();
-        targetJs.create();
-
         styleCss.copyFileTo (targetCss);
-        hlJs.copyFileTo (targetJs);
 
         // when all above has done, browse it in an external browser..
         htmlFile.startAsProcess();
@@ -754,8 +830,6 @@ void DocTreeViewItem::exportAsHtml()
     {
         SHOW_MESSAGE (TRANS ("Export Failed."));
     }
-
-    mdFile.deleteFile();
 }
 
 //=================================================================================================
@@ -787,23 +861,48 @@ const File DocTreeViewItem::createDoc (const String& docName,
                                        const ValueTree& docProperties,
                                        const bool selectAfterCreated)
 {
-    String docFileName (docName);
-
-    if (docFileName.isEmpty())
-        docFileName = TRANS ("Untitled");    
-    else if (docFileName == "site")
-        docFileName = "site-doc";
-    else if (docFileName == "docs")
-        docFileName = "docs-1";
-    else if (docFileName == "media")
-        docFileName = "media-doc";
-
     // create this doc on disk
-    const File& thisDoc (getMdFileOrDir (tree).getChildFile (docFileName + ".md")
+    const File& thisDoc (getMdFileOrDir (tree).getChildFile (getValidDocName (docName) + ".md")
                          .getNonexistentSibling (false));
     thisDoc.create();
     thisDoc.appendText (content);
+    MediaIndex::getInstance()->updateDoc (thisDoc);
 
+    ValueTree docTree (createDocTree (thisDoc, docProperties));
+
+    // must update this tree before show this new item
+    tree.removeListener (this);
+    tree.addChild (docTree, 0, nullptr);
+    needCreate (docTree);
+    tree.addListener (this);
+
+    // add and select the new item 
+    setOpen (true);
+    DocTreeViewItem* docItem = new DocTreeViewItem (docTree, treeContainer, sorter);
+    addSubItemSorted (*sorter, docItem);
+    docItem->setSelected (selectAfterCreated, selectAfterCreated);
+
+    return thisDoc;
+}
+
+//=================================================================================================
+const String DocTreeViewItem::getValidDocName (const String& docName)
+{
+    if (docName.isEmpty())
+        return TRANS ("Untitled");    
+    else if (docName == "site")
+        return "site-doc";
+    else if (docName == "docs")
+        return "docs-1";
+    else if (docName == "media")
+        return "media-doc";
+
+    return docName;
+}
+
+//=================================================================================================
+const ValueTree DocTreeViewItem::createDocTree (const File& thisDoc, const ValueTree& docProperties)
+{
     String titleStr (thisDoc.getFileNameWithoutExtension());
     String dateStr (SwingUtilities::getTimeStringWithSeparator (SwingUtilities::getCurrentTimeString(), true));
     String descStr (TRANS ("Description of this doc..."));
@@ -846,19 +945,7 @@ const File DocTreeViewItem::createDoc (const String& docName,
         docTree.setProperty ("hide", true, nullptr);
     }
 
-    // must update this tree before show this new item
-    tree.removeListener (this);
-    tree.addChild (docTree, 0, nullptr);
-    needCreate (docTree);
-    tree.addListener (this);
-
-    // add and select the new item 
-    setOpen (true);
-    DocTreeViewItem* docItem = new DocTreeViewItem (docTree, treeContainer, sorter);
-    addSubItemSorted (*sorter, docItem);
-    docItem->setSelected (selectAfterCreated, selectAfterCreated);
-
-    return thisDoc;
+    return docTree;
 }
 
 //=================================================================================================
@@ -976,7 +1063,12 @@ void DocTreeViewItem::deleteSelected()
 
                 // delete the two-files
                 mdFile.moveToTrash();
-                siteFile.deleteRecursively();
+
+                if (siteFile.isDirectory())
+                    siteFile.deleteRecursively();
+                else
+                    HtmlProcessor::deletePage (siteFile);
+
                 v.getParent().removeChild (v, nullptr);
             }
         }
@@ -992,38 +1084,38 @@ void DocTreeViewItem::statistics()
     String staStr;
     const bool isDoc = (tree.getType().toString() == "doc");
 
+    // only the docs which have been changed outside will be read
+    int dirNums = -1;  // non-include itself
+    const DocStatistics::Stats stats (DocStatistics::getInstance()->getTreeStats (tree, dirNums));
+
     if (isDoc)
     {
-        int words = 0, innerImgNums = 0, exImgNums = 0;
-        getWordsAndImgNumsInDoc (tree, words, innerImgNums, exImgNums);
-
         staStr = TRANS ("File: ") + tree.getProperty ("name").toString() + newLine
             + TRANS ("Title: ") + tree.getProperty ("title").toString() + newLine
-            + TRANS ("Words: ") + String (words) + "  "
-            + TRANS ("Inner Images: ") + String (innerImgNums) + "  "
-            + TRANS ("External Images: ") + String (exImgNums);
+            + TRANS ("Words: ") + String (stats.words) + "  ";
     }
     else
     {
         int docNums = 0;
         HtmlProcessor::getDocNumbersOfTheDir (tree, docNums);
 
-        int dirNums = -1;  // non-include itself
-        int totalWords = 0, totalInnerImgs = 0, totalExImgs = 0;
         const bool isDir = (tree.getType().toString() == "dir");
 
-        statis (tree, dirNums, totalWords, totalInnerImgs, totalExImgs);
-
         staStr = (isDir ? (TRANS ("Dir: ") + tree.getProperty ("name").toString() + "  ") : String())
             + (isDir ? TRANS ("Title: ") : TRANS ("Project: "))
             + tree.getProperty ("title").toString() + newLine
             + TRANS ("Sub-dirs: ") + String (dirNums) + "  "
             + TRANS ("Docs: ") + String (docNums) + newLine
-            + TRANS ("Total Words: ") + String (totalWords) + "  "
-            + TRANS ("Inner Images: ") + String (totalInnerImgs) + "  "
-            + TRANS ("External Images: ") + String (totalExImgs);
+            + TRANS ("Total Words: ") + String (stats.words) + "  ";
     }
 
+    staStr << TRANS ("Chars: ") << String (stats.chars) << newLine
+        << TRANS ("CJK Chars: ") << String (stats.cjkChars) << "  "
+        << TRANS ("Audios: ") << String (stats.audios) << "  "
+        << TRANS ("Videos: ") << String (stats.videos) << newLine
+        << TRANS ("Inner Images: ") << String (stats.innerImgs) << "  "
+        << TRANS ("External Images: ") << String (stats.exImgs);
+
     ScopedPointer<StatisComp> statisComp = new StatisComp (treeContainer, this, isDoc, staStr);
     CallOutBox callOut (*statisComp, treeContainer->getScreenBounds(), nullptr);
 
@@ -1359,92 +1451,233 @@ const bool DocTreeViewItem::importExternalDocs (const Array<File>& docs,
         return false;
     }
 
-    // import...
-    bool needSaveProject = false;
+    // reserve the doc files first, so that the docs can be written in parallel
+    const File dir (getMdFileOrDir (tree));
+    Array<ImportedDoc> importedDocs;
+    StringArray bigFiles, emptyFiles, failedFiles;
 
     for (int i = docs.size(); --i >= 0; )
     {
         // doesn't import any big file
-        if (docs[i].getSize() / 1024 <= 512)  
+        if (docs[i].getSize() > maxImportSize)
         {
-            String content (isUTF8Format ? docs[i].loadFileAsString()  // UTF-8
-                            : SwingUtilities::convertANSIString (docs[i])); // ANSI
-            //DBGX (content);
+            bigFiles.add (docs[i].getFullPathName());
+            continue;
+        }
 
-            // processs the string if it has any front matter (YAML/TOML md file)
-            const ValueTree& docTree (FrontMatterParser::processIfHasFrontMatter (content));
+        ImportedDoc doc;
+        doc.source = docs[i];
+        doc.target = dir.getChildFile (getValidDocName (docs[i].getFileNameWithoutExtension()) + ".md")
+            .getNonexistentSibling (false);
+        doc.target.create();
+        doc.result = importCancelled;
 
-            // for normal text file
-            if (content.substring (0, 1) != "#")
-                content = "# " + content;
+        importedDocs.add (doc);
+    }
 
-            if (content.length() > 4)
-            {
-                createDoc (docs[i].getFileNameWithoutExtension(), content, docTree, selectOneByOneAfterImport);
-                needSaveProject = true;
-            }
-            else
-            {
-                SHOW_MESSAGE (TRANS ("No neeed to import a file which can't/no need to read :)")
-                              + newLine + newLine + docs[i].getFullPathName());
-            }
+    // read, convert, parse and write them on the worker pool, in background when there're many.
+    // if it's cancelled, the ones which haven't begun keep 'importCancelled'
+    struct ImportThread : public ThreadWithProgressWindow,
+                          private WorkerPool::Task
+    {
+        ImportThread (Array<ImportedDoc>& importedDocs_, const bool isUTF8Format_) 
+            : ThreadWithProgressWindow (TRANS ("Importing..."), true, true),
+            importedDocs (importedDocs_), isUTF8Format (isUTF8Format_)
+        {
         }
-        else
+
+        void run() override
+        {
+            WorkerPool::getInstance()->runAll (*this, importedDocs.size(), this);
+        }
+
+        void runItem (const int index) override
+        {
+            ImportedDoc& doc (importedDocs.getReference (index));
+            doc.result = importWriteFailed;
+            importDocContent (doc, isUTF8Format);
+
+            setProgress ((++numDone) / (double) importedDocs.size());
+        }
+
+        Array<ImportedDoc>& importedDocs;
+        const bool isUTF8Format;
+        Atomic<int> numDone;
+    };
+
+    if (importedDocs.size() > 16)
+    {
+        ImportThread thread (importedDocs, isUTF8Format);
+        thread.runThread();
+    }
+    else
+    {
+        for (int i = 0; i < importedDocs.size(); ++i)
+        {
+            importedDocs.getReference (i).result = importWriteFailed;
+            importDocContent (importedDocs.getReference (i), isUTF8Format);
+        }
+    }
+
+    // add all the new docs to this tree at once
+    Array<ValueTree> newDocs;
+
+    for (int i = 0; i < importedDocs.size(); ++i)
+    {
+        const ImportedDoc& doc (importedDocs.getReference (i));
+
+        if (doc.result == importSucceeded)
         {
-            SHOW_MESSAGE (TRANS ("Can't import a file which more than 512K :)") 
-                          + newLine + newLine + docs[i].getFullPathName());
+            newDocs.add (createDocTree (doc.target, doc.docProperties));
+            continue;
         }
+
+        doc.target.deleteFile();
+
+        if (doc.result == importNoContent)
+            emptyFiles.add (doc.source.getFullPathName());
+        else if (doc.result == importWriteFailed)
+            failedFiles.add (doc.source.getFullPathName());
     }
 
-    if (needSaveProject)
+    if (newDocs.size() > 0)
+    {
+        const String modifyDate (SwingUtilities::getTimeStringWithSeparator (SwingUtilities::getCurrentTimeString(), true));
+
+        tree.removeListener (this);
+
+        for (int i = 0; i < newDocs.size(); ++i)
+        {
+            newDocs.getReference (i).setProperty ("modifyDate", modifyDate, nullptr);
+            newDocs.getReference (i).setProperty ("needCreateHtml", true, nullptr);
+            tree.addChild (newDocs[i], 0, nullptr);
+        }
+
+        // the parents and the affected pages are the same for all these new docs
+        needCreate (newDocs.getLast());
+        tree.addListener (this);
+
+        setOpen (true);
+        DocTreeViewItem* docItem = nullptr;
+
+        for (int i = 0; i < newDocs.size(); ++i)
+        {
+            docItem = new DocTreeViewItem (newDocs[i], treeContainer, sorter);
+            addSubItemSorted (*sorter, docItem);
+        }
+
+        docItem->setSelected (selectOneByOneAfterImport, selectOneByOneAfterImport);
+    }
+
+    // tell the files which haven't been imported at once
+    if (bigFiles.size() > 0)
+        SHOW_MESSAGE (TRANS ("Can't import a file which more than 64M :)") 
+                      + newLine + newLine + bigFiles.joinIntoString (newLine));
+
+    if (emptyFiles.size() > 0)
+        SHOW_MESSAGE (TRANS ("No neeed to import a file which can't/no need to read :)")
+                      + newLine + newLine + emptyFiles.joinIntoString (newLine));
+
+    if (failedFiles.size() > 0)
+        SHOW_MESSAGE (TRANS ("Can't write to this file! ")
+                      + newLine + newLine + failedFiles.joinIntoString (newLine));
+
+    if (newDocs.size() > 0)
     {
         TipsBank::getInstance()->rebuildTipsBank();
         return FileTreeContainer::saveProject();
     }
 
-    return needSaveProject;
+    return false;
 }
 
 //=================================================================================================
-void DocTreeViewItem::getWordsAndImgNumsInDoc (const ValueTree& tree, 
-                                               int& words,
-                                               int& innerImgNums,
-                                               int& exImgNums)
+void DocTreeViewItem::importDocContent (ImportedDoc& doc, const bool isUTF8Format)
 {
-    const String& content (getMdFileOrDir (tree).loadFileAsString());
-    words = content.removeCharacters (" ").removeCharacters (newLine).length() + words;
+    const int64 sourceSize = doc.source.getSize();
+    int64 streamFrom = sourceSize;
+    String content;
 
-    // for markdown img
-    int index = content.indexOf (0, "![");
-
-    while (index != -1)
+    if (isUTF8Format && sourceSize > streamImportSize)
     {
-        if (content.substring (index - 1, index) != "\\")
+        // only read its head, the rest will be copied as it is
+        MemoryBlock head;
+        FileInputStream input (doc.source);
+
+        if (input.failedToOpen())
+            return;
+
+        input.readIntoMemoryBlock (head, streamImportSize);
+
+        const char* const data = static_cast<const char*> (head.getData());
+        int numBytes = (int) head.getSize();
+
+        // cut it at a line end, so that no char will be broken
+        while (numBytes > 0 && data[numBytes - 1] != '\n')
+            --numBytes;
+
+        if (numBytes > 0)
         {
-            if (content.substring (index + 2, index + 6).toLowerCase() == "http")
-                ++exImgNums;
-            else
-                ++innerImgNums;
+            const int bomSize = (numBytes >= 3 && CharPointer_UTF8::isByteOrderMark (data)) ? 3 : 0;
+            content = String::fromUTF8 (data + bomSize, numBytes - bomSize);
+            streamFrom = numBytes;
         }
-
-        index = content.indexOf (index + 2, "![");
+        else
+        {
+            // a single huge line..
+            content = doc.source.loadFileAsString();
+        }
+    }
+    else
+    {
+        content = isUTF8Format ? doc.source.loadFileAsString()  // UTF-8
+            : SwingUtilities::convertANSIString (doc.source); // ANSI
     }
 
-    // for html img, count as external image
-    index = content.indexOf (0, "<img src=");
+    // processs the string if it has any front matter (YAML/TOML md file)
+    doc.docProperties = FrontMatterParser::processIfHasFrontMatter (content);
+
+    // for normal text file
+    if (content.substring (0, 1) != "#")
+        content = "# " + content;
 
-    while (index != -1)
+    if (content.length() <= 4 && streamFrom >= sourceSize)
     {
-        ++exImgNums;
-        index = content.indexOf (index + 9, "<img src=");
+        doc.result = importNoContent;
+        return;
+    }
+
+    {
+        FileOutputStream output (doc.target);
+
+        if (output.failedToOpen())
+            return;
+
+        output << content;
+
+        if (streamFrom < sourceSize)
+        {
+            FileInputStream input (doc.source);
+
+            if (input.failedToOpen() || !input.setPosition (streamFrom))
+                return;
+
+            output.writeFromInputStream (input, -1);
+        }
+
+        output.flush();
+        doc.result = output.getStatus().failed() ? importWriteFailed : importSucceeded;
     }
+
+    // parse its medias here (it might be on the worker pool), after the file has been closed
+    if (doc.result == importSucceeded)
+        MediaIndex::getInstance()->updateDoc (doc.target);
 }
 
 //=================================================================================================
-const bool DocTreeViewItem::getDirDocsAndAllMedias (DocTreeViewItem* item,
-                                                    const File& mdFile,
-                                                    Array<File>& medias)
+void DocTreeViewItem::getDirDocs (DocTreeViewItem* item, Array<ValueTree>& docs)
 {
+    // the sub-items are sorted by the sorter only after it's opened
     item->setOpen (true);
 
     if (item->getNumSubItems() > 0)
@@ -1455,8 +1688,7 @@ const bool DocTreeViewItem::getDirDocsAndAllMedias (DocTreeViewItem* item,
             jassert (currentItem != nullptr);
 
             // recursive traversal
-            if (!getDirDocsAndAllMedias (currentItem, mdFile, medias))
-                return false;
+            getDirDocs (currentItem, docs);
         }
     }
     else
@@ -1467,24 +1699,9 @@ const bool DocTreeViewItem::getDirDocsAndAllMedias (DocTreeViewItem* item,
             && currentFile.existsAsFile() 
             && currentFile.getSize() > 0)
         {
-            getMdMediaFiles (currentFile, medias);
-            String mdStr (HtmlProcessor::processAbbrev (item->getTree(),
-                                                               currentFile.loadFileAsString()));
-
-            // cancel '[TOC]' withou remove its escape
-            mdStr = mdStr.replace ("\\[TOC]", "@#@_wdtpToc_@#@");
-
-            mdStr = mdStr.replace (newLine + "[TOC]" + newLine, String())
-                .replace (newLine + "[TOC]", String())
-                .replace (String ("[TOC]") + newLine, String())
-                .replace ("[TOC]", String())
-                .replace ("@#@_wdtpToc_@#@", "\\[TOC]");
-
-            return mdFile.appendText (mdStr.trimEnd() + newLine + newLine);
+            docs.add (item->getTree());
         }
     }
-
-    return true;
 }
 
 //=================================================================================================
@@ -1498,26 +1715,6 @@ DocTreeViewItem* DocTreeViewItem::getRootItem (DocTreeViewItem* subItem)
     return item;
 }
 
-//=================================================================================================
-void DocTreeViewItem::statis (const ValueTree& tree, 
-                              int& dirNums, 
-                              int& totalWords, 
-                              int& innerImgNums,
-                              int& exImgNums)
-{
-    if (tree.getType().toString() == "doc")
-    {
-        getWordsAndImgNumsInDoc (tree, totalWords, innerImgNums, exImgNums);
-    }
-    else
-    {
-        ++dirNums;
-
-        for (int i = tree.getNumChildren(); --i >= 0; )
-            statis (tree.getChild (i), dirNums, totalWords, innerImgNums, exImgNums);
-    }
-}
-
 //=================================================================================================
 var DocTreeViewItem::getDragSourceDescription()
 {
@@ -1650,7 +1847,24 @@ void DocTreeViewItem::moveItems (const OwnedArray<ValueTree>& items,
                     }
                 }
 
+                // the old page(s) and their .gz, they'll be generated in the new place
+                if (thisFile.isDirectory())
+                {
+                    Array<File> oldPages;
+                    File (thisFile.getFullPathName().replace ("docs", "site"))
+                        .findChildFiles (oldPages, File::findFiles, true, "*.html");
+
+                    for (int j = oldPages.size(); --j >= 0; )
+                        HtmlProcessor::deletePage (oldPages[j]);
+                }
+                else
+                {
+                    HtmlProcessor::deletePage (getHtmlFile (thisFile));
+                }
+
                 thisFile.deleteRecursively();
+                MediaIndex::getInstance()->removeDoc (thisFile);
+                MediaIndex::getInstance()->updateDoc (targetFile);
 
                 v.getParent().removeChild (v, nullptr);
                 needCreate (v.getParent());
@@ -32,15 +32,18 @@ public:
     static const File getHtmlFile (const File& mdFileOrDir);
     static const File getHtmlFile (const ValueTree& tree);
 
-    /** get a html-file's all local media files. the result would be stored in arg-2.
+    /** get a html-file's all local media files (including the responsive copies in srcset). 
+        the result would be stored in arg-2.
         return: media-files' number of this html-file included. */
     static const int getHtmlMediaFiles (const File& htmlFile, Array<File>& files);
 
     /** get a doc-file's all local media files. the result would be stored in arg-2.
-        return: media-files' number of this doc-file included.	*/
-    static const int getMdMediaFiles (const File& doc, Array<File>& files);
+        return: media-files' number of this doc-file included.	
+        arg-3: false for include the files which are referenced but nonexistent (see MediaIndex). */
+    static const int getMdMediaFiles (const File& doc, Array<File>& files, const bool onlyExisting = true);
 
-    /** let the arg tree and all its parents set to needCreateHtml. */
+    /** let the arg tree and the pages which use its data set to needCreateHtml (see PageDependencies).
+        if the site hasn't been generated, all its parents and children will be set. */
     static void needCreate (ValueTree tree);
     static void allChildrenNeedCreate (ValueTree tree);
 
@@ -97,25 +100,12 @@ private:
     /** select all its chilren doc which include the given skyword */
     void selectChildren (DocTreeViewItem* currentItem, const String& keyword);
 
-    /** for exportAsHtml. Note: the arg item must be a dir. 
-        Note: 'hide' doc will be excluded.  */
-    static const bool getDirDocsAndAllMedias (DocTreeViewItem* item,
-                                              const File& mdFile,
-                                              Array<File>& medias);
+    /** for exportAsHtml. the docs in the order they're showed in the file-tree.
+        Note: the arg item must be a dir. 'hide' and empty doc will be excluded.  */
+    static void getDirDocs (DocTreeViewItem* item, Array<ValueTree>& docs);
 
     static DocTreeViewItem* getRootItem (DocTreeViewItem* subItem);
 
-    static void statis (const ValueTree& tree, 
-                        int& dirNums,
-                        int& totalWords, 
-                        int& innerImgNums,
-                        int& exImgNums);
-
-    static void getWordsAndImgNumsInDoc (const ValueTree& tree, 
-                                         int& words, 
-                                         int& innerImgNums,
-                                         int& exImgNums);
-
     //=========================================================================
     enum MenuIndex
     {
@@ -141,6 +131,31 @@ private:
                           const ValueTree& docProperties,
                           const bool selectAfterCreated);
 
+    /** the valueTree of a new doc which has been created on disk */
+    static const ValueTree createDocTree (const File& docFile, const ValueTree& docProperties);
+
+    /** the doc's file name (without extension) which won't conflict with the project's dirs */
+    static const String getValidDocName (const String& docName);
+
+    //=========================================================================
+    /** an external file which is being imported, see importExternalDocs() */
+    struct ImportedDoc
+    {
+        File source, target;
+        ValueTree docProperties;
+        int result;
+    };
+
+    enum ImportResult { importSucceeded = 0, importNoContent, importWriteFailed, importCancelled };
+
+    /** the file larger than maxImportSize won't be imported. the UTF-8 file larger than 
+        streamImportSize will be copied by a stream except its head (which may have front matter) */
+    enum { maxImportSize = 64 * 1024 * 1024, streamImportSize = 512 * 1024 };
+
+    /** read, convert and parse the source, then write it to the target and index its medias. 
+        it could be called on any thread. */
+    static void importDocContent (ImportedDoc& doc, const bool isUTF8Format);
+
     void createNewFolder();
     void deleteSelected();
     void statistics();
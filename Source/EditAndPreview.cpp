@@ -15,6 +15,8 @@ extern PropertiesFile* systemFile;
 //==============================================================================
 EditAndPreview::EditAndPreview (MainContentComponent* mainComp_) 
     : docHasChanged (false),
+    contentVersion (0),
+    savedVersion (0),
     mainComp (mainComp_),
     showSetupArea (true)
 {
@@ -47,12 +49,15 @@ EditAndPreview::EditAndPreview (MainContentComponent* mainComp_)
 
     mdEditor->setVisible (false);
     mdEditor->setPopupMenuEnabled (false);    
+
+    DocSaver::getInstance()->setListener (this);
 }
 
 //=========================================================================
 EditAndPreview::~EditAndPreview()
 {
     stopTimer();
+    DocSaver::getInstance()->setListener (nullptr);
 }
 
 //=========================================================================
@@ -125,26 +130,29 @@ void EditAndPreview::workAreaStartWork (ValueTree& newDocTree)
         mdEditor->removeListener (this);
         docOrDirTree = newDocTree;
         docOrDirFile = DocTreeViewItem::getMdFileOrDir (docOrDirTree);
+        FileTreeContainer::makeSureFileUnpacked (docOrDirFile);
 
         if (docOrDirFile.existsAsFile())
         {
             mdEditor->setText (docOrDirFile.loadFileAsString(), false);
-            currentContent = mdEditor->getText();
+            contentLoaded();
             mdEditor->addListener (this);
         }
     }
 
     // prevent auto-enter preview mode when created a new document
-    switchMode (!(docOrDirFile.exists() && currentContent.length() < 3));
+    const String& content (getCurrentContent());
+    switchMode (!(docOrDirFile.exists() && content.length() < 3));
 
-    if (currentContent.length() < 3)
+    if (content.length() < 3)
         mdEditor->moveCaretToEnd (false);
     else
         mdEditor->moveCaretToTop (false);
 
     // word count doesn't include the ' ' and newLine of current content 
-    setupPanel->updateWordCount (currentContent.removeCharacters (" ")
-                                 .removeCharacters (newLine).length());
+    setupPanel->updateWordCount (docOrDirFile.existsAsFile()
+                                 ? DocStatistics::getInstance()->getDocStats (docOrDirFile).words
+                                 : DocStatistics::scan (content).words);
 }
 
 //=================================================================================================
@@ -152,11 +160,12 @@ void EditAndPreview::updateEditorContent()
 {
     mdEditor->removeListener (this);
     docOrDirFile = DocTreeViewItem::getMdFileOrDir (docOrDirTree);
+    FileTreeContainer::makeSureFileUnpacked (docOrDirFile);
 
     if (docOrDirFile.existsAsFile())
     {
         mdEditor->setText (docOrDirFile.loadFileAsString(), false);
-        currentContent = mdEditor->getText();
+        contentLoaded();
         mdEditor->addListener (this);
 
         // update web page
@@ -356,7 +365,7 @@ void EditAndPreview::outlineGoto (const StringArray& titleStrs, const int itemIn
     else if (itemIndex > 0 && itemIndex < titleStrs.size() - 1)
     {
         // replace Chinese '#' temporaily instead of change it in reality
-        const String content (currentContent.replace (CharPointer_UTF8 ("\xef\xbc\x83"), "#"));
+        const String content (getCurrentContent().replace (CharPointer_UTF8 ("\xef\xbc\x83"), "#"));
         
         // here need position the caret twice and pageDown() after the first one.
         // this'll make sure the scroll position is on top of the editor-view
@@ -397,7 +406,7 @@ void EditAndPreview::projectClosed()
     docOrDirFile = File::nonexistent;
     docOrDirTree = ValueTree::invalid;
     docHasChanged = false;
-    currentContent.clear();
+    contentLoaded();
 
     resized();
 }
@@ -429,13 +438,32 @@ void EditAndPreview::setSearchKeyword (const String& keyword)
 }
 
 //=================================================================================================
-void EditAndPreview::textEditorTextChanged (TextEditor&)
+const String& EditAndPreview::getCurrentContent()
 {
-    // somehow, this method always be called when about to load a doc, 
-    // so this ugly judge has to be here...
-    if (currentContent.compare (mdEditor->getText()) != 0)
+    if (contentVersion != mdEditor->getTextVersion())
     {
         currentContent = mdEditor->getText();
+        contentVersion = mdEditor->getTextVersion();
+    }
+
+    return currentContent;
+}
+
+//=================================================================================================
+void EditAndPreview::contentLoaded()
+{
+    currentContent = mdEditor->getText();
+    contentVersion = mdEditor->getTextVersion();
+    savedVersion = contentVersion;
+}
+
+//=================================================================================================
+void EditAndPreview::textEditorTextChanged (TextEditor&)
+{
+    // somehow, this method always be called when about to load a doc,
+    // so this judge has to be here. the version won't change in that case.
+    if (mdEditor->getTextVersion() != savedVersion)
+    {
         docHasChanged = true;
         DocTreeViewItem::needCreate (docOrDirTree);
 
@@ -446,7 +474,34 @@ void EditAndPreview::textEditorTextChanged (TextEditor&)
 //=================================================================================================
 void EditAndPreview::timerCallback()
 {
-    saveCurrentDocIfChanged();
+    // only write the doc in background, the rest will be done by saveCurrentDocIfChanged()
+    stopTimer();
+    saveInBackground();
+}
+
+//=================================================================================================
+void EditAndPreview::saveInBackground()
+{
+    if (docOrDirFile != File::nonexistent && mdEditor->getTextVersion() != savedVersion)
+    {
+        savedVersion = mdEditor->getTextVersion();
+        DocSaver::getInstance()->saveInBackground (docOrDirFile, mdEditor->getText());
+    }
+}
+
+//=================================================================================================
+void EditAndPreview::docSaved (const File& docFile, const int wordCount)
+{
+    if (docFile == docOrDirFile)
+        setupPanel->updateWordCount (wordCount);
+}
+
+//=================================================================================================
+void EditAndPreview::docSaveFailed (const File& docFile)
+{
+    // the text version isn't a saved one, so the next save will hand it over again
+    if (docFile == docOrDirFile)
+        savedVersion = -1;
 }
 
 //=================================================================================================
@@ -457,12 +512,12 @@ const bool EditAndPreview::saveCurrentDocIfChanged()
 
     if (docHasChanged && docOrDirFile != File::nonexistent)
     {
-        TemporaryFile tempFile (docOrDirFile);
-        tempFile.getFile().appendText (currentContent);
+        saveInBackground();
 
-        if (tempFile.overwriteTargetFileWithTemporary())
+        if (DocSaver::getInstance()->waitUntilSaved (docOrDirFile))
         {
             docHasChanged = false;
+            MediaIndex::getInstance()->updateDoc (docOrDirFile);
             setupPanel->showDocProperties (false, docOrDirTree);
             returnValue = FileTreeContainer::saveProject();
 
@@ -477,10 +532,6 @@ const bool EditAndPreview::saveCurrentDocIfChanged()
         {
             returnValue = false;
         }
-
-        // word count doesn't include ' ' and newLine. 
-        setupPanel->updateWordCount (currentContent.removeCharacters (" ")
-                                     .removeCharacters (newLine).length());
     }
 
     return returnValue;
@@ -21,6 +21,7 @@ class ThemeEditor;
 */
 class EditAndPreview : public Component,
                        private TextEditor::Listener,
+                       private DocSaver::Listener,
                        private Timer
 {
 public:
@@ -61,7 +62,7 @@ public:
     const String& getCurrentUrl() const         { return currentUrl; }
 
     const File& getCurrentDocFile() const       { return docOrDirFile; }
-    const String& getCurrentContent() const     { return currentContent; }
+    const String& getCurrentContent();
 
     ValueTree& getCurrentTree()                 { return docOrDirTree; }
     SetupPanel* getSetupPanel() const           { return setupPanel; }
@@ -88,6 +89,14 @@ private:
 
     virtual void textEditorTextChanged (TextEditor&) override;
     virtual void timerCallback() override;
+    virtual void docSaved (const File& docFile, const int wordCount) override;
+    virtual void docSaveFailed (const File& docFile) override;
+
+    /** hand a snapshot of the editor's text to DocSaver if it has changed */
+    void saveInBackground();
+
+    /** the editor's text has just been replaced by the doc's content */
+    void contentLoaded();
 
     //=========================================================================
     File docOrDirFile;
@@ -95,6 +104,9 @@ private:
     bool docHasChanged;
     String currentContent, currentUrl;
 
+    // the TextEditor's text versions of currentContent and the last snapshot given to DocSaver
+    int contentVersion, savedVersion;
+
     MainContentComponent* mainComp;
 
     ScopedPointer<MarkdownEditor> mdEditor;
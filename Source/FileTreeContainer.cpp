@@ -14,6 +14,7 @@ extern PropertiesFile* systemFile;
 
 File FileTreeContainer::projectFile;
 ValueTree FileTreeContainer::projectTree = ValueTree::invalid;
+ScopedPointer<ZipUnpacker> FileTreeContainer::unpacker;
 
 //==============================================================================
 FileTreeContainer::FileTreeContainer (EditAndPreview* rightArea) :
@@ -39,6 +40,7 @@ FileTreeContainer::FileTreeContainer (EditAndPreview* rightArea) :
 FileTreeContainer::~FileTreeContainer()
 {
     fileTree.setRootItem (nullptr);
+    unpacker = nullptr;
 
     projectTree = ValueTree::invalid;
     projectFile = File::nonexistent;
@@ -75,27 +77,47 @@ void FileTreeContainer::openProject (const File& project)
     // check if this is a normal project or a packed project
     if (project.getFileExtension() == ".wpck")
     {
+        // start a new instance of this app, it'll unpack the project
+        if (projectTree.isValid())
+        {
+            Process::openDocument (File::getSpecialLocation (File::currentApplicationFile).getFullPathName(),
+                                   project.getFullPathName());
+            return;
+        }
 
-        ZipFile zip (project);
-        const bool notZip = zip.getNumEntries() < 1;
+        // only the project file is unpacked at once, the rest will be unpacked in background
         const File unpackDir (project.getSiblingFile (project.getFileNameWithoutExtension()));
-        String message (zip.uncompressTo (unpackDir).getErrorMessage());
+        ScopedPointer<ZipUnpacker> newUnpacker (new ZipUnpacker (project, unpackDir));
+        newUnpacker->open();
 
-        if (notZip)
-            message = TRANS ("Invalid packed project.");
+        // the project file must be at the top level of the archive
+        int projectIndex = -1;
 
-        if (message.isNotEmpty() || notZip)
+        for (int i = 0; i < newUnpacker->getNumEntries(); ++i)
         {
-            SHOW_MESSAGE (TRANS ("Unpack failed:") + newLine + message);
+            const String& entryName (newUnpacker->getEntryName (i));
+
+            if (!entryName.containsChar ('/') && entryName.endsWithIgnoreCase (".wdtp"))
+            {
+                projectIndex = i;
+                break;
+            }
         }
-        else   // find the project file after unpacked
+
+        if (projectIndex < 0)
         {
-            Array<File> pFiles;
-            unpackDir.findChildFiles (pFiles, File::findFiles, false, "*.wdtp");
-            jassert (pFiles.size() > 0);
+            SHOW_MESSAGE (TRANS ("Unpack failed:") + newLine + TRANS ("Invalid packed project."));
+            return;
+        }
 
-            realProject = pFiles[0];
+        if (!newUnpacker->extractNow (projectIndex))
+        {
+            SHOW_MESSAGE (TRANS ("Unpack failed:") + newLine + newUnpacker->getEntryName (projectIndex));
+            return;
         }
+
+        realProject = unpackDir.getChildFile (newUnpacker->getEntryName (projectIndex));
+        unpacker = newUnpacker;
     }
 
     // start a new instance of this app
@@ -123,14 +145,25 @@ void FileTreeContainer::openProject (const File& project)
     // check if this is an vaild project file
     if (projectTree.getType().toString() != "wdtpProject")
     {
+        unpacker = nullptr;
         AlertWindow::showMessageBox (AlertWindow::InfoIcon, TRANS ("Message"),
                                      TRANS ("An invalid project file."));
         return;
     }
     
+    // the docs will be unpacked first
+    if (unpacker != nullptr)
+        unpacker->start (this, StringArray ("docs/"));
+
     // load the project and build tips bank
     projectFile = realProject;
+    DocSaver::getInstance()->loadForProject();
     TipsBank::getInstance()->rebuildTipsBank();
+    PageDependencies::getInstance()->loadForProject();
+    MediaIndex::getInstance()->loadForProject();
+    ResponsiveImages::getInstance()->loadForProject();
+    AssetManifest::getInstance()->loadForProject();
+    DocStatistics::getInstance()->loadForProject();
 
     sorter = new ItemSorter (projectTree);
     docTreeItem = new DocTreeViewItem (projectTree, this, sorter);
@@ -169,6 +202,21 @@ void FileTreeContainer::closeProject()
 {
     if (hasLoadedProject() && saveOpenSateAndSelect (false) && saveDocAndProject())
     {
+        // stop the unpacking first, it mustn't write into the dir while the sidecars are being saved
+        unpacker = nullptr;
+
+        PageDependencies::getInstance()->saveForProject();
+        PageDependencies::getInstance()->clear();
+        MediaIndex::getInstance()->saveForProject();
+        MediaIndex::getInstance()->clear();
+        ResponsiveImages::getInstance()->saveForProject();
+        ResponsiveImages::getInstance()->clear();
+        AssetManifest::getInstance()->saveForProject();
+        AssetManifest::getInstance()->clear();
+        DocSaver::getInstance()->saveForProject();
+        DocStatistics::getInstance()->saveForProject();
+        DocStatistics::getInstance()->clear();
+
         fileTree.setRootItem (nullptr);
         docTreeItem = nullptr;
         sorter = nullptr;
@@ -185,6 +233,46 @@ void FileTreeContainer::closeProject()
     }
 }
 
+//=================================================================================================
+void FileTreeContainer::unpackingFinished (ZipUnpacker* finishedUnpacker, const StringArray& failedEntries)
+{
+    jassert (finishedUnpacker == unpacker);
+
+    if (failedEntries.size() > 0)
+    {
+        StringArray names (failedEntries);
+        names.removeRange (10, names.size());
+
+        if (failedEntries.size() > 10)
+            names.add ("...");
+
+        SHOW_MESSAGE (TRANS ("Unpack failed:") + newLine + names.joinIntoString (newLine));
+    }
+
+    // the tips file might not be there when the project opened
+    if (finishedUnpacker->getTargetDir() == projectFile.getParentDirectory())
+        TipsBank::getInstance()->rebuildTipsBank();
+}
+
+//=================================================================================================
+void FileTreeContainer::makeSureFileUnpacked (const File& file)
+{
+    if (unpacker != nullptr && !unpacker->isFinished())
+        unpacker->extractNow (unpacker->indexOfFile (file));
+}
+
+//=================================================================================================
+const bool FileTreeContainer::stillUnpacking (const bool showMessage)
+{
+    if (unpacker == nullptr || unpacker->isFinished())
+        return false;
+
+    if (showMessage)
+        SHOW_MESSAGE (TRANS ("The project is still being unpacked, please wait a moment."));
+
+    return true;
+}
+
 //=================================================================================================
 const Array<TreeViewItem*> FileTreeContainer::getSelectedItems() const
 {
@@ -390,6 +478,8 @@ void FileTreeContainer::reloadCurrentDoc()
 //=================================================================================================
 bool FileTreeContainer::saveProject()
 {
+    const Profiler::ScopedTimer timer ("saveProject");
+
     if (!SwingUtilities::writeValueTreeToFile (projectTree, projectFile, true))
     {
         SHOW_MESSAGE (TRANS ("Something wrong during saving this project."));
@@ -59,7 +59,8 @@ private:
 /** Showed in main interface's left.
 */
 class FileTreeContainer : public Component,
-                          public DragAndDropContainer
+                          public DragAndDropContainer,
+                          private ZipUnpacker::Listener
 {
 public:
     FileTreeContainer (EditAndPreview* editAndPreview);
@@ -85,12 +86,24 @@ public:
     static bool saveProject();
     const bool selectItemFromHtmlFile (const File& html);
 
+    /** a packed project (.wpck) shows its tree after the project file has been unpacked,
+        the docs and medias are still being unpacked in background. call this before 
+        load a file of the project, it'll make sure the file is there. */
+    static void makeSureFileUnpacked (const File& file);
+
+    /** return true (and show a message if arg is true) if the project is still being unpacked */
+    static const bool stillUnpacking (const bool showMessage);
+
     // core static objects. this's a BAD design I totally know that but it's handy :)
     static File projectFile;
     static ValueTree projectTree;
 
 private:
     //=========================================================================
+    virtual void unpackingFinished (ZipUnpacker* unpacker, const StringArray& failedEntries) override;
+
+    static ScopedPointer<ZipUnpacker> unpacker;
+
     ScopedPointer<DocTreeViewItem> docTreeItem;
     ScopedPointer<ItemSorter> sorter;
 
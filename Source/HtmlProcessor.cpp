@@ -24,15 +24,23 @@ void HtmlProcessor::renderHtmlContent (const ValueTree& docTree,
                           "<p>\n &emsp;" + TRANS ("Please specify a template file. ")
                           + "\n  </body>\n</html>");
 
-    String tplStr (tplFile.existsAsFile() ? tplFile.loadFileAsString() : noTplStr);
-
-    // md to html
     const File mdDoc (DocTreeViewItem::getMdFileOrDir (docTree));
+    String tplStr, mdStr;
+
+    {
+        const Profiler::ScopedTimer timer ("readFiles");
+        tplStr = tplFile.existsAsFile() ? tplFile.loadFileAsString() : noTplStr;
+        mdStr = mdDoc.existsAsFile() ? mdDoc.loadFileAsString() : String();
+    }
 
-    if (!mdDoc.existsAsFile() || mdDoc.loadFileAsString().isEmpty())
+    // md to html
+    if (mdStr.isEmpty())
+    {
+        writeHtmlIfChanged (htmlFile, String());
         return;
+    }
 
-    String mdStrWithoutAbbrev (processAbbrev (docTree, mdDoc.loadFileAsString()));
+    String mdStrWithoutAbbrev (processAbbrev (docTree, mdStr));
     const String& keywords (docTree.getProperty ("keywords").toString());
 
     // here need insert this doc's keywords below the title, 
@@ -54,29 +62,21 @@ void HtmlProcessor::renderHtmlContent (const ValueTree& docTree,
     // here must parse the extra extension md-mark before parse original md-mark
     parseExMdMark (docTree, rootRelativePath, mdStrWithoutAbbrev, tplStr);
 
-    // parse mdString to html string
-    const String& htmlContentStr (Md2Html::mdStringToHtml (mdStrWithoutAbbrev));
-
-    // process code
-    if (htmlContentStr.contains ("<pre><code"))
-    {
-        tplStr = tplStr.replace ("\n  <title>",
-                                 "\n  <script src = \""
-                                 + rootRelativePath + "add-in/hl.js\"></script>\n"
-                                 "  <script>hljs.initHighlightingOnLoad(); </script>\n"
-                                 "  <title>");
-    }
+    // parse mdString to html string, then let the images which have a width be responsive.
+    // the code blocks are highlighted here, so the page needn't hl.js
+    const String& htmlContentStr (CodeHighlighter::process (ResponsiveImages::getInstance()->process (
+        mdDoc, htmlFile, Md2Html::mdStringToHtml (mdStrWithoutAbbrev))));
 
     processTplTags (docTree, htmlFile, tplStr);
     const String& siteName (" - " + FileTreeContainer::projectTree.getProperty ("title").toString());
 
     // process head-tags and generate the html file
-    htmlFile.appendText (tplStr.replace ("{{keywords}}", keywords)
-                         .replace ("{{author}}", FileTreeContainer::projectTree.getProperty ("owner").toString())
-                         .replace ("{{description}}", docTree.getProperty ("description").toString())
-                         .replace ("{{title}}", docTree.getProperty ("title").toString() + siteName)
-                         .replace ("{{siteRelativeRootPath}}", rootRelativePath)
-                         .replace ("{{content}}", htmlContentStr));
+    writeHtmlIfChanged (htmlFile, tplStr.replace ("{{keywords}}", keywords)
+                        .replace ("{{author}}", FileTreeContainer::projectTree.getProperty ("owner").toString())
+                        .replace ("{{description}}", docTree.getProperty ("description").toString())
+                        .replace ("{{title}}", docTree.getProperty ("title").toString() + siteName)
+                        .replace ("{{siteRelativeRootPath}}", rootRelativePath)
+                        .replace ("{{content}}", htmlContentStr));
 
     copyDocMediasToSite (mdDoc, htmlFile, htmlContentStr);
 }
@@ -88,12 +88,16 @@ void HtmlProcessor::parseExMdMark (const ValueTree& docTree,
                                    String& tplStr)
 {
     jassert (docTree.getType().toString() == "doc");
+    const Profiler::ScopedTimer timer ("parseExMdMark");
 
     // [keywords]: all of the project's
     int startIndex = mdStrWithoutAbbrev.indexOf ("[keywords]");
 
     if (startIndex != -1 && mdStrWithoutAbbrev.substring (startIndex - 1, startIndex) != "\\")
     {
+        PageDependencies::getInstance()->readScope (FileTreeContainer::projectTree, 
+                                                    PageDependencies::keywordsProp | PageDependencies::visibilityProp);
+
         const String kws (getKeywordsLinks (rootRelativePath));
         mdStrWithoutAbbrev = mdStrWithoutAbbrev.replaceSection (startIndex, String ("[keywords]").length(), kws);
 
@@ -110,6 +114,9 @@ void HtmlProcessor::parseExMdMark (const ValueTree& docTree,
 
     if (startIndex != -1 && mdStrWithoutAbbrev.substring (startIndex - 1, startIndex) != "\\")
     {
+        PageDependencies::getInstance()->readScope (FileTreeContainer::projectTree, 
+                                                    PageDependencies::titleProp | PageDependencies::createDateProp 
+                                                    | PageDependencies::visibilityProp);
         StringArray latests;
         getAllArticleLinksOfGivenTree (FileTreeContainer::projectTree, rootRelativePath, publishDate, latests, docTree);
         latests.sort (true);
@@ -138,6 +145,9 @@ void HtmlProcessor::parseExMdMark (const ValueTree& docTree,
 
     if (startIndex != -1 && mdStrWithoutAbbrev.substring (startIndex - 1, startIndex) != "\\")
     {
+        PageDependencies::getInstance()->readScope (FileTreeContainer::projectTree, 
+                                                    PageDependencies::titleProp | PageDependencies::modifyDateProp 
+                                                    | PageDependencies::visibilityProp);
         StringArray latests;
         getAllArticleLinksOfGivenTree (FileTreeContainer::projectTree, rootRelativePath, ModifiedDate, latests, docTree);
         latests.sort (true);
@@ -171,6 +181,9 @@ void HtmlProcessor::parseExMdMark (const ValueTree& docTree,
     if (startIndex != -1 && mdStrWithoutAbbrev.substring (startIndex - 1, startIndex) != "\\")
     {
         hasLatestPublish = true;
+        PageDependencies::getInstance()->readScope (docTree.getParent(), 
+                                                    PageDependencies::titleProp | PageDependencies::createDateProp 
+                                                    | PageDependencies::visibilityProp);
 
         StringArray latests;
         getAllArticleLinksOfGivenTree (docTree.getParent(), rootRelativePath, publishDate, latests, docTree);
@@ -199,6 +212,9 @@ void HtmlProcessor::parseExMdMark (const ValueTree& docTree,
     if (startIndex != -1 && mdStrWithoutAbbrev.substring (startIndex - 1, startIndex) != "\\")
     {
         hasLatestModify = true;
+        PageDependencies::getInstance()->readScope (docTree.getParent(), 
+                                                    PageDependencies::titleProp | PageDependencies::createDateProp 
+                                                    | PageDependencies::modifyDateProp | PageDependencies::visibilityProp);
 
         // get the latest modified..
         StringArray latestModified;
@@ -255,6 +271,9 @@ void HtmlProcessor::parseExMdMark (const ValueTree& docTree,
     if (startIndex != -1 && mdStrWithoutAbbrev.substring (startIndex - 1, startIndex) != "\\")
     {
         hasFeatured = true;
+        PageDependencies::getInstance()->readScope (docTree.getParent(), 
+                                                    PageDependencies::titleProp | PageDependencies::modifyDateProp 
+                                                    | PageDependencies::visibilityProp);
 
         // get the latest featured..
         StringArray modifiedFeatured;
@@ -372,8 +391,9 @@ const File HtmlProcessor::createArticleHtml (ValueTree& docTree, bool saveProjec
 
     if ((bool)docTree.getProperty ("needCreateHtml") || !htmlFile.existsAsFile())
     {
-        if (htmlFile.deleteFile())
+        if (!htmlFile.exists() || htmlFile.hasWriteAccess())
         {
+            const Profiler::ScopedTimer timer ("page", htmlFile.getFullPathName());
             const String tplPath (FileTreeContainer::projectFile.getSiblingFile ("themes")
                                   .getFullPathName() + File::separator
                                   + FileTreeContainer::projectTree.getProperty ("render").toString()
@@ -381,8 +401,9 @@ const File HtmlProcessor::createArticleHtml (ValueTree& docTree, bool saveProjec
 
             const File tplFile (tplPath + docTree.getProperty ("tplFile").toString());
 
-            // generate the doc's html
-            htmlFile.create();
+            // generate the doc's html, and record the data of other items which it used
+            refreshAssetsOutOfScope();
+            const PageDependencies::PageRecorder recorder (docTree);
             renderHtmlContent (docTree, tplFile, htmlFile);
 
             docTree.setProperty ("needCreateHtml", false, nullptr);
@@ -398,6 +419,10 @@ const File HtmlProcessor::createArticleHtml (ValueTree& docTree, bool saveProjec
             SHOW_MESSAGE (TRANS ("Something wrong during create this document's html file."));
         }
     }
+    else
+    {
+        Profiler::addCount ("pagesSkipped");
+    }
 
     return htmlFile;
 }
@@ -407,6 +432,7 @@ void HtmlProcessor::copyDocMediasToSite (const File& mdFile,
                                          const File& htmlFile,
                                          const String& htmlStr)
 {
+    const Profiler::ScopedTimer timer ("copyDocMediasToSite");
     const String docMediaDirStr (mdFile.getSiblingFile ("media").getFullPathName());
     const String htmlMediaDirStr (htmlFile.getSiblingFile ("media").getFullPathName());
     Array<File> docMedias;
@@ -474,8 +500,12 @@ const File HtmlProcessor::createIndexHtml (ValueTree& dirTree, bool saveProject)
     // normal generate index.html and index-x.html if there's no any doc named 'index'
     if ((bool)dirTree.getProperty ("needCreateHtml") || !indexHtml.existsAsFile())
     {
-        if (indexHtml.deleteFile())
+        if (!indexHtml.exists() || indexHtml.hasWriteAccess())
         {
+            const Profiler::ScopedTimer timer ("page", indexHtml.getFullPathName());
+            refreshAssetsOutOfScope();
+            const PageDependencies::PageRecorder recorder (dirTree);
+
             const File tplFile (FileTreeContainer::projectFile.getSiblingFile ("themes")
                                 .getFullPathName() + File::separator
                                 + FileTreeContainer::projectTree.getProperty ("render").toString()
@@ -487,15 +517,14 @@ const File HtmlProcessor::createIndexHtml (ValueTree& dirTree, bool saveProject)
             // when missing render dir (no tpl)
             if (tplStr.isEmpty())
             {
-                indexHtml.create();
-                indexHtml.appendText ("<!doctype html>\n"
-                                       "<html lang=\"en\">\n"
-                                       "  <head>\n"
-                                       "    <meta charset=\"UTF-8\">\n"
-                                       "  </head>\n"
-                                       "  <body bgcolor=\"#cccccc\">\n"
-                                       "<p>\n &emsp;" + TRANS ("Please specify a template file. ")
-                                       + "\n  </body>\n</html>");
+                writeHtmlIfChanged (indexHtml, "<!doctype html>\n"
+                                    "<html lang=\"en\">\n"
+                                    "  <head>\n"
+                                    "    <meta charset=\"UTF-8\">\n"
+                                    "  </head>\n"
+                                    "  <body bgcolor=\"#cccccc\">\n"
+                                    "<p>\n &emsp;" + TRANS ("Please specify a template file. ")
+                                    + "\n  </body>\n</html>");
 
                 return indexHtml;
             }
@@ -518,46 +547,32 @@ const File HtmlProcessor::createIndexHtml (ValueTree& dirTree, bool saveProject)
 
             // list for book
             if (tplStr.contains ("{{bookList}}"))
-            {
                 tplStr = tplStr.replace ("{{bookList}}", getBookList (dirTree));
-                indexHtml.create();
-                indexHtml.appendText (tplStr);
-            }
 
             // list for blog
             if (tplStr.contains ("{{blogList}}"))
             {
-                const StringArray fileLinks (getBlogList (dirTree));
-                const int howManyFiles = fileLinks.size() / 3;
-                const int howManyPages = howManyFiles / 10 + (howManyFiles % 10 == 0 ? 0 : 1);
+                // compile the tpl once: the pieces around the "{{blogList}}"(s)
+                StringArray tplPieces;
 
-                if (howManyFiles < 1)
+                for (int start = 0; ; )
                 {
-                    indexHtml.deleteFile();
-                    indexHtml.create();
+                    const int index = tplStr.indexOf (start, "{{blogList}}");
+                    tplPieces.add (tplStr.substring (start, (index < 0) ? tplStr.length() : index));
 
-                    const String listHtmlStr = tplStr.replace ("{{blogList}}", String());
-                    indexHtml.appendText (listHtmlStr);
-                }
-                else  // devide to many pages
-                {
-                    for (int i = 0; i < howManyPages; ++i)
-                    {
-                        StringArray pageLinks;
-                        pageLinks.addArray (fileLinks, i * 30, 30);
-                        pageLinks.add (getPageNavi (howManyPages, i + 1));
-
-                        const String listHtmlStr = tplStr.replace ("{{blogList}}",
-                                                                   "<div>" + pageLinks.joinIntoString (newLine) + "</div>");
-
-                        const File& indexFile (indexHtml.getSiblingFile ("index-" + String (i + 1) + ".html"));
-                        indexFile.deleteFile();
-                        indexFile.create();
-                        indexFile.appendText (listHtmlStr);
-                    }
+                    if (index < 0)
+                        break;
 
-                    indexHtml.getSiblingFile ("index-1.html").moveFileTo (indexHtml);
+                    start = index + 12;  // "{{blogList}}"
                 }
+
+                const int pageSize = (int)dirTree.getProperty ("pageSize", (int)defaultPageSize);
+                writeBlogListPages (tplPieces, getBlogList (dirTree), 
+                                    (pageSize > 0) ? pageSize : (int)defaultPageSize, indexHtml);
+            }
+            else
+            {
+                writeHtmlIfChanged (indexHtml, tplStr);
             }
 
             dirTree.setProperty ("needCreateHtml", false, nullptr);
@@ -570,6 +585,10 @@ const File HtmlProcessor::createIndexHtml (ValueTree& dirTree, bool saveProject)
             SHOW_MESSAGE (TRANS ("Something wrong during create this folder's index.html."));
         }
     }
+    else
+    {
+        Profiler::addCount ("pagesSkipped");
+    }
 
     return indexHtml;
 }
@@ -820,6 +839,7 @@ void HtmlProcessor::processTplTags (const ValueTree& docOrDirTree,
                                  const File& htmlFile,
                                  String& tplStr)
 {
+    const Profiler::ScopedTimer timer ("processTplTags");
     const String& rootRelativePath (getRelativePathToRoot (htmlFile));
     
     // title of this index.html
@@ -943,39 +963,65 @@ const String HtmlProcessor::processAbbrev (const ValueTree& docTree, const Strin
     // want to process dir or project?!?
     jassert (docTree.getType().toString() == "doc");
 
-    String resultStr (originalStr);
+    MultiReplacer::Ptr replacer (getAbbrevReplacer (docTree.getProperty ("abbrev").toString()));
+
+    if (replacer == nullptr)
+        return originalStr;
+
+    return replacer->replaceAll (originalStr);
+}
+
+//=================================================================================================
+const MultiReplacer::Ptr HtmlProcessor::getAbbrevReplacer (const String& abbrevStr)
+{
+    if (abbrevStr.trim().isEmpty())
+        return nullptr;
+
+    // the compiled automatons, keyed by the whole 'abbrev' text.
+    // so a doc's abbrevs will only be parsed and rebuilt after its property changed.
+    static CriticalSection cacheLock;
+    static StringArray cachedAbbrevStrs;
+    static ReferenceCountedArray<MultiReplacer> cachedReplacers;
+
+    const ScopedLock sl (cacheLock);
+    const int cachedIndex = cachedAbbrevStrs.indexOf (abbrevStr);
+
+    if (cachedIndex >= 0)
+        return cachedReplacers[cachedIndex];
 
     // get the abbrevs by line
     StringArray abbrevAndOriginal;
-    abbrevAndOriginal.addLines (docTree.getProperty ("abbrev").toString());
+    abbrevAndOriginal.addLines (abbrevStr);
     abbrevAndOriginal.removeDuplicates (false);
     abbrevAndOriginal.removeEmptyStrings (true);
 
-    if (abbrevAndOriginal.size() != 0)
+    StringArray abbrevs, originals;
+
+    for (int i = 0; i < abbrevAndOriginal.size(); ++i)
     {
-        // for replace the abbrevs
-        StringArray abbrevs, originals;
+        const String abbrev (abbrevAndOriginal[i].upToFirstOccurrenceOf (" ", false, false));
+        const String original (abbrevAndOriginal[i].fromFirstOccurrenceOf (" ", false, false).trimStart());
 
-        for (int i = abbrevAndOriginal.size(); --i >= 0; )
+        if (abbrev.isNotEmpty() && original.isNotEmpty())
         {
-            abbrevAndOriginal.getReference (i) = abbrevAndOriginal[i];
+            abbrevs.add (abbrev);
+            originals.add (original);
+        }
+    }
 
-            const String abbrev (abbrevAndOriginal[i].upToFirstOccurrenceOf (" ", false, false));
-            const String original (abbrevAndOriginal[i].fromFirstOccurrenceOf (" ", false, false).trimStart());
+    MultiReplacer::Ptr replacer (new MultiReplacer (abbrevs, originals));
 
-            if (abbrev.isNotEmpty() && original.isNotEmpty())
-            {
-                abbrevs.add (abbrev);
-                originals.add (original);
-            }
-        }
-        
-        // replace
-        for (int i = abbrevs.size(); --i >= 0; )
-            resultStr = resultStr.replace (abbrevs[i], originals[i], false);
+    // only keep the recent ones
+    if (cachedAbbrevStrs.size() >= 64)
+    {
+        cachedAbbrevStrs.remove (0);
+        cachedReplacers.remove (0);
     }
 
-    return resultStr;
+    cachedAbbrevStrs.add (abbrevStr);
+    cachedReplacers.add (replacer);
+
+    return replacer;
 }
 
 //=================================================================================================
@@ -1029,7 +1075,11 @@ const String HtmlProcessor::getSiteMenu (const ValueTree& tree)
     HtmlProcessor sorter (false);
     pTree.sort (sorter, nullptr, false);
 
+    const int menuProps = PageDependencies::titleProp | PageDependencies::createDateProp
+        | PageDependencies::visibilityProp | PageDependencies::structureProp;
+
     StringArray menuHtmlStr;
+    PageDependencies::getInstance()->readDoc (pTree, PageDependencies::structureProp);
 
     if (atLeastHasOneMenu (pTree))
         menuHtmlStr.add ("<div class=\"siteMenu\"><ul>");
@@ -1039,6 +1089,7 @@ const String HtmlProcessor::getSiteMenu (const ValueTree& tree)
     for (int i = 0; i < pTree.getNumChildren(); ++i)
     {
         ValueTree fd (pTree.getChild (i));
+        PageDependencies::getInstance()->readDoc (fd, menuProps);
 
         if ((bool)fd.getProperty ("isMenu") 
             && DocTreeViewItem::getMdFileOrDir (fd).exists()
@@ -1069,6 +1120,7 @@ const String HtmlProcessor::getSiteMenu (const ValueTree& tree)
                 for (int j = 0; j < fd.getNumChildren(); ++j)
                 {
                     const ValueTree& sd (fd.getChild (j));
+                    PageDependencies::getInstance()->readDoc (sd, menuProps);
 
                     if (DocTreeViewItem::getMdFileOrDir (sd).exists()
                         && (bool)sd.getProperty ("isMenu")
@@ -1113,6 +1165,7 @@ const String HtmlProcessor::getSiteNavi (const ValueTree& docTree)
 
     while (parent.isValid())
     {
+        PageDependencies::getInstance()->readDoc (parent, PageDependencies::titleProp | PageDependencies::structureProp);
         String text (parent.getProperty ("title").toString());
 
         if (parent.getType().toString() == "wdtpProject")
@@ -1148,6 +1201,8 @@ const String HtmlProcessor::getCreateAndModifyTime (const ValueTree& tree)
 const String HtmlProcessor::getPrevAndNextArticel (const ValueTree& tree)
 {
     String prevStr, nextStr;
+    PageDependencies::getInstance()->readScope (FileTreeContainer::projectTree, 
+                                                PageDependencies::createDateProp | PageDependencies::visibilityProp);
 
     ValueTree prevTree ("doc");
     getPreviousTree (FileTreeContainer::projectTree, tree, prevTree);
@@ -1155,6 +1210,7 @@ const String HtmlProcessor::getPrevAndNextArticel (const ValueTree& tree)
 
     if (prevName.isNotEmpty())
     {
+        PageDependencies::getInstance()->readDoc (prevTree, PageDependencies::titleProp | PageDependencies::structureProp);
         String prevPath = DocTreeViewItem::getHtmlFile (prevTree).getFullPathName();
         prevPath = prevPath.replace (FileTreeContainer::projectFile.getSiblingFile ("site").getFullPathName(), String());
         prevPath = getRelativePathToRoot (DocTreeViewItem::getHtmlFile (tree)) + prevPath.substring (1);
@@ -1168,6 +1224,7 @@ const String HtmlProcessor::getPrevAndNextArticel (const ValueTree& tree)
 
     if (nextName.isNotEmpty())
     {
+        PageDependencies::getInstance()->readDoc (nextTree, PageDependencies::titleProp | PageDependencies::structureProp);
         String nextPath = DocTreeViewItem::getHtmlFile (nextTree).getFullPathName();
         nextPath = nextPath.replace (FileTreeContainer::projectFile.getSiblingFile ("site").getFullPathName(), String());
         nextPath = getRelativePathToRoot (DocTreeViewItem::getHtmlFile (tree)) + nextPath.substring (1);
@@ -1182,25 +1239,31 @@ const String HtmlProcessor::getPrevAndNextArticel (const ValueTree& tree)
 const String HtmlProcessor::getRandomArticels (const ValueTree& notIncludeThisTree,
                                                const int howMany)
 {
-    StringArray links;
-    getLinkStrOfAlllDocTrees (FileTreeContainer::projectTree, notIncludeThisTree, links);
-
-    // + 2: prevent a articel is the current or something else, 
-    // make sure it'll be gotten enough
-    Array<int> randoms = getRandomInts (howMany + 2);
+    const ScopedLock sl (getRandomDocsCache().lock);
+    Array<RandomDoc> tempDocs;
+    const Array<RandomDoc>& docs (getRandomDocs (tempDocs));
+
+    // the same page gets the same random articles if the project hasn't changed, 
+    // so regenerating the site doesn't change the pages needlessly.
+    // + 1: in case the current doc is one of them
+    const File& htmlFile (DocTreeViewItem::getHtmlFile (notIncludeThisTree));
+    Random r (htmlFile.getFullPathName().hashCode64());
+    const Array<int> randoms (getRandomInts (r, howMany + 1, docs.size()));
+
+    const String rootPath (getRelativePathToRoot (htmlFile));
     StringArray randomLinks;
+    PageDependencies::getInstance()->readScope (FileTreeContainer::projectTree, PageDependencies::visibilityProp);
 
     for (int i = 0; i < randoms.size(); ++i)
-        randomLinks.add (links[randoms[i]]);
-
-    randomLinks.removeEmptyStrings (true);
-
-    // remove the newest
-    while (randomLinks.size() > howMany)
-        randomLinks.remove (0);      
+    {
+        const RandomDoc& doc (docs.getReference (randoms[i]));
 
-    for (int j = randomLinks.size(); --j >= 0; )
-        randomLinks.getReference (j) = "<li>" + randomLinks[j] + "</li>";
+        if (doc.tree != notIncludeThisTree && randomLinks.size() < howMany)
+        {
+            PageDependencies::getInstance()->readDoc (doc.tree, PageDependencies::titleProp | PageDependencies::structureProp);
+            randomLinks.add ("<li><a href=\"" + rootPath + doc.sitePath + "\">" + doc.title + "</a></li>");
+        }
+    }
 
     randomLinks.insert (0, "<div class=randomArticels><ul>");
     randomLinks.insert (0, "<strong>" + TRANS ("Random Posts:") + "</strong>");
@@ -1288,58 +1351,155 @@ void HtmlProcessor::getDocNumbersOfTheDir (const ValueTree& dirTree, int& num)
 }
 
 //=================================================================================================
-const Array<int> HtmlProcessor::getRandomInts (const int howMany)
+const Array<int> HtmlProcessor::getRandomInts (Random& r, const int howMany, const int total)
 {
     Array<int> values;
-    int maxValue = 0;
-    getDocNumbersOfTheDir (FileTreeContainer::projectTree, maxValue);
-    Random r (Time::currentTimeMillis());
 
-    for (int i = jmin (maxValue, howMany); --i >= 0; )
+    for (int j = total - jmin (howMany, total); j < total; ++j)
+    {
+        const int randomValue = r.nextInt (j + 1);
+
+        values.add (values.contains (randomValue) ? j : randomValue);
+    }
+
+    // Floyd's picks aren't in random order (the later ones tend to be larger), shuffle them
+    for (int i = values.size(); --i > 0; )
+        values.swap (i, r.nextInt (i + 1));
+
+    return values;
+}
+
+//=================================================================================================
+HtmlProcessor::GenerationScope::GenerationScope()
+{
+    RandomDocsCache& cache (getRandomDocsCache());
+    const ScopedLock sl (cache.lock);
+
+    if (++cache.numScopes == 1)
     {
-        int randomValue = r.nextInt (maxValue);
+        AssetManifest::getInstance()->refresh();
 
-        for (int j = 0; j < values.size(); ++j)
+        CompressQueue& queue (getCompressQueue());
+        const ScopedLock queueLock (queue.lock);
+        queue.active = true;
+    }
+}
+
+HtmlProcessor::GenerationScope::~GenerationScope()
+{
+    RandomDocsCache& cache (getRandomDocsCache());
+    bool isLastScope = false;
+
+    {
+        const ScopedLock sl (cache.lock);
+
+        if (--cache.numScopes == 0)
         {
-            if (values[j] == randomValue)
-            {
-                randomValue = r.nextInt (maxValue);
-                j = -1;  // here must be -1, because it'll ++j in for()
-            }
+            cache.docs.clear();
+            cache.gathered = false;
+            isLastScope = true;
+        }
+    }
+
+    // wait for the .gz which are still being written, without blocking the readers of the cache
+    if (isLastScope)
+    {
+        CompressQueue& queue (getCompressQueue());
+
+        {
+            const ScopedLock queueLock (queue.lock);
+            queue.active = false;
         }
 
-        values.addUsingDefaultSort (randomValue);
+        queue.allWritten.wait (-1);
     }
+}
 
-    return values;
+//=================================================================================================
+HtmlProcessor::ProfilingScope::ProfilingScope()
+{
+    if ((bool)FileTreeContainer::projectTree.getProperty ("profileGeneration"))
+        Profiler::start (true);
+}
+
+HtmlProcessor::ProfilingScope::~ProfilingScope()
+{
+    if (!Profiler::isRunning())
+        return;
+
+    const String report (Profiler::stop());
+    FileTreeContainer::projectFile.withFileExtension ("profile").replaceWithText (report);
+    Profiler::writeTrace (FileTreeContainer::projectFile.withFileExtension ("trace.json"));
+}
+
+//=================================================================================================
+void HtmlProcessor::refreshAssetsOutOfScope()
+{
+    RandomDocsCache& cache (getRandomDocsCache());
+    const ScopedLock sl (cache.lock);
+
+    if (cache.numScopes == 0)
+        AssetManifest::getInstance()->refresh();
 }
 
 //=================================================================================================
-void HtmlProcessor::getLinkStrOfAlllDocTrees (const ValueTree& fromThisTree,
-                                              const ValueTree& baseOnThisTree,
-                                              StringArray& linkStr)
+HtmlProcessor::CompressQueue& HtmlProcessor::getCompressQueue()
 {
-    if (fromThisTree.getType().toString() == "doc")
+    static CompressQueue queue;
+    return queue;
+}
+
+//=================================================================================================
+HtmlProcessor::RandomDocsCache& HtmlProcessor::getRandomDocsCache()
+{
+    static RandomDocsCache cache;
+    return cache;
+}
+
+//=================================================================================================
+const Array<HtmlProcessor::RandomDoc>& HtmlProcessor::getRandomDocs (Array<RandomDoc>& tempDocs)
+{
+    RandomDocsCache& cache (getRandomDocsCache());
+
+    if (cache.numScopes == 0)
     {
-        if (fromThisTree != baseOnThisTree
-            && !(bool)fromThisTree.getProperty ("isMenu")
-            && fromThisTree.getProperty ("name").toString() != "index"
-            && !(bool)fromThisTree.getProperty ("hide"))
-        {
-            const String text = fromThisTree.getProperty ("title").toString();
+        addRandomDocs (FileTreeContainer::projectTree, tempDocs);
+        return tempDocs;
+    }
+
+    if (!cache.gathered)
+    {
+        addRandomDocs (FileTreeContainer::projectTree, cache.docs);
+        cache.gathered = true;
+    }
 
-            String path = DocTreeViewItem::getHtmlFile (fromThisTree).getFullPathName();
+    return cache.docs;
+}
+
+//=================================================================================================
+void HtmlProcessor::addRandomDocs (const ValueTree& tree, Array<RandomDoc>& docs)
+{
+    if (tree.getType().toString() == "doc")
+    {
+        if (!(bool)tree.getProperty ("isMenu")
+            && tree.getProperty ("name").toString() != "index"
+            && !(bool)tree.getProperty ("hide"))
+        {
+            String path = DocTreeViewItem::getHtmlFile (tree).getFullPathName();
             path = path.replace (FileTreeContainer::projectFile.getSiblingFile ("site").getFullPathName(), String());
-            path = getRelativePathToRoot (DocTreeViewItem::getHtmlFile (baseOnThisTree)) + path.substring (1);
-            path = path.replace ("\\", "/");
 
-            linkStr.add ("<a href=\"" + path + "\">" + text + "</a>");
+            RandomDoc doc;
+            doc.tree = tree;
+            doc.sitePath = path.substring (1).replace ("\\", "/");
+            doc.title = tree.getProperty ("title").toString();
+
+            docs.add (doc);
         }
     }
     else
     {
-        for (int i = fromThisTree.getNumChildren(); --i >= 0; )
-            getLinkStrOfAlllDocTrees (fromThisTree.getChild (i), baseOnThisTree, linkStr);
+        for (int i = tree.getNumChildren(); --i >= 0; )
+            addRandomDocs (tree.getChild (i), docs);
     }
 }
 
@@ -1378,9 +1538,9 @@ void HtmlProcessor::getBookListLinks (const ValueTree& tree,
 }
 
 //=================================================================================================
-void HtmlProcessor::getBlogListHtmlStr (const ValueTree& tree,
-                                        const File& baseOnthisFile,
-                                        StringArray& linkStr)
+void HtmlProcessor::getBlogListItems (const ValueTree& tree,
+                                      const File& baseOnthisFile,
+                                      Array<BlogListItem>& items)
 {
     const String& rootPath (getRelativePathToRoot (baseOnthisFile));
     String path = DocTreeViewItem::getHtmlFile (tree).getFullPathName();
@@ -1388,116 +1548,388 @@ void HtmlProcessor::getBlogListHtmlStr (const ValueTree& tree,
     path = rootPath + path.substring (1);
     path = path.replace ("\\", "/");
 
-    if (DocTreeViewItem::getHtmlFile (tree) != baseOnthisFile)
+    // dirs are not listed, but their docs are
+    if (tree.getType().toString() == "doc"
+        && DocTreeViewItem::getHtmlFile (tree) != baseOnthisFile
+        && !(bool)tree.getProperty ("isMenu")
+        && !(bool)tree.getProperty ("hide"))
     {
-        if (!(bool)tree.getProperty ("isMenu") && !(bool)tree.getProperty ("hide"))
+        const String& text (tree.getProperty ("title").toString());
+        const String& imgName (tree.getProperty ("thumbName").toString());
+
+        BlogListItem item;
+        item.createDate = tree.getProperty ("createDate").toString();
+        item.modifyDate = tree.getProperty ("modifyDate").toString();
+
+        // create and last modified date
+        item.dateHtml = "<img src=" + rootPath
+            + "add-in/createDate.png style=\"vertical-align:middle; display:inline-block\"> "
+            + item.createDate.dropLastCharacters (3) // drop seconds
+            + " &nbsp;&nbsp;<img src=" + rootPath
+            + "add-in/modifiedDate.png style=\"vertical-align:middle; display:inline-block\"> "
+            + item.modifyDate.dropLastCharacters (3); // drop seconds 
+
+        // 2 level dir and their link
+        const ValueTree parentTree (tree.getParent());
+        const ValueTree grandTree (parentTree.getParent());
+
+        // dir icon
+        if ((grandTree.isValid() && grandTree.getType().toString() != "wdtpProject")
+            || (parentTree.isValid() && parentTree.getType().toString() != "wdtpProject"))
         {
-            const String& text (tree.getProperty ("title").toString());
-            const String& imgName (tree.getProperty ("thumbName").toString());
-
-            String str (tree.getType().toString() == "doc" ? "doc" : "dir");
-
-            // create and last modified date
-            str += "@_^_#_%_@<img src=" + rootPath
-                + "add-in/createDate.png style=\"vertical-align:middle; display:inline-block\"> "
-                + tree.getProperty ("createDate").toString().dropLastCharacters (3) // drop seconds
-                + " &nbsp;&nbsp;<img src=" + rootPath
-                + "add-in/modifiedDate.png style=\"vertical-align:middle; display:inline-block\"> " +
-                // + " - " +
-                tree.getProperty ("modifyDate").toString().dropLastCharacters (3); // drop seconds 
-
-            // 2 level dir and their link
-            const ValueTree parentTree (tree.getParent());
-            const ValueTree grandTree (parentTree.getParent());
-
-            // dir icon
-            if ((grandTree.isValid() && grandTree.getType().toString() != "wdtpProject")
-                || (parentTree.isValid() && parentTree.getType().toString() != "wdtpProject"))
-            {
-                str += " &nbsp;&nbsp;<img src=" + rootPath
-                    + "add-in/dir.png style=\"vertical-align:middle; display:inline-block\"> ";
-            }
+            item.dateHtml += " &nbsp;&nbsp;<img src=" + rootPath
+                + "add-in/dir.png style=\"vertical-align:middle; display:inline-block\"> ";
+        }
 
-            if (grandTree.isValid() && grandTree.getType().toString() != "wdtpProject")
-            {
-                const String parentPath (path.upToLastOccurrenceOf ("/", false, false)
-                                         .upToLastOccurrenceOf ("/", true, false) + "index.html");
+        if (grandTree.isValid() && grandTree.getType().toString() != "wdtpProject")
+        {
+            const String parentPath (path.upToLastOccurrenceOf ("/", false, false)
+                                     .upToLastOccurrenceOf ("/", true, false) + "index.html");
 
-                str += "<a href=\"" + parentPath + "\">" +
-                    grandTree.getProperty ("title").toString() + "</a>/";
-            }
+            item.dateHtml += "<a href=\"" + parentPath + "\">" +
+                grandTree.getProperty ("title").toString() + "</a>/";
+        }
 
-            if (parentTree.isValid() && parentTree.getType().toString() != "wdtpProject")
-            {
-                const String parentPath (path.upToLastOccurrenceOf ("/", true, false) + "index.html");
-                str += "<a href=\"" + parentPath + "\">" +
-                    parentTree.getProperty ("title").toString() + "</a>";
-            }
+        if (parentTree.isValid() && parentTree.getType().toString() != "wdtpProject")
+        {
+            const String parentPath (path.upToLastOccurrenceOf ("/", true, false) + "index.html");
+            item.dateHtml += "<a href=\"" + parentPath + "\">" +
+                parentTree.getProperty ("title").toString() + "</a>";
+        }
 
-            // title and its link
-            str = str + "@_^_#_%_@" + "<a href=\"" + path + "\">" + text + "</a>@_^_#_%_@";
+        // title and its link
+        item.titleHtml = "<a href=\"" + path + "\">" + text + "</a>";
 
-            if (imgName.isNotEmpty() && (bool)tree.getProperty ("thumb"))
-            {
-                const String& imgPath (imgName.substring (0, 4) == "http" ? imgName
-                                       : path.upToLastOccurrenceOf ("/", true, false) + imgName); // remove 'xxxx.html'
-                str += "<div><img src=\"" + imgPath + "\"></div><p>";
-            }
+        if (imgName.isNotEmpty() && (bool)tree.getProperty ("thumb"))
+        {
+            const String& imgPath (imgName.substring (0, 4) == "http" ? imgName
+                                   : path.upToLastOccurrenceOf ("/", true, false) + imgName); // remove 'xxxx.html'
+            item.descMd = "<div><img src=\"" + imgPath + "\"></div><p>";
+        }
 
-            // description
-            str += tree.getProperty ("description").toString() + "<div class=readMore style=\"text-align:right;\">"
-                + "<a href=\"" + path + "\">" + TRANS ("Read More") + "</a></div>";
+        // description
+        item.descMd += tree.getProperty ("description").toString() + "<div class=readMore style=\"text-align:right;\">"
+            + "<a href=\"" + path + "\">" + TRANS ("Read More") + "</a></div>";
 
-            linkStr.add (str);
-        }
+        item.sortKey = item.dateHtml + "@_^_#_%_@" + item.titleHtml + "@_^_#_%_@" + item.descMd;
+        items.add (item);
     }
 
     for (int i = tree.getNumChildren(); --i >= 0; )
-        getBlogListHtmlStr (tree.getChild (i), baseOnthisFile, linkStr);
+        getBlogListItems (tree.getChild (i), baseOnthisFile, items);
+}
+
+//=================================================================================================
+const bool HtmlProcessor::getCachedDescHtml (BlogListItem& item)
+{
+    const ScopedLock sl (getDescCacheLock());
+    HashMap<String, String>& cache (getDescCache());
+
+    item.descKey = String::toHexString (item.descMd.hashCode64());
+
+    if (!cache.contains (item.descKey))
+        return false;
+
+    item.descHtml = cache[item.descKey];
+    return true;
+}
+
+//=================================================================================================
+void HtmlProcessor::cacheDescHtml (const BlogListItem& item)
+{
+    const ScopedLock sl (getDescCacheLock());
+    HashMap<String, String>& cache (getDescCache());
+
+    // the paths inside the description depend on the index which lists it,
+    // so a doc may have several entries. only keep a reasonable amount of them.
+    if (cache.size() >= 10000)
+        cache.clear();
+
+    cache.set (item.descKey, item.descHtml);
+}
+
+//=================================================================================================
+CriticalSection& HtmlProcessor::getDescCacheLock()
+{
+    static CriticalSection lock;
+    return lock;
+}
+
+//=================================================================================================
+HashMap<String, String>& HtmlProcessor::getDescCache()
+{
+    static HashMap<String, String> cache;
+    return cache;
 }
 
 //=================================================================================================
-const StringArray HtmlProcessor::getBlogList (const ValueTree& dirTree)
+const Array<HtmlProcessor::BlogListItem> HtmlProcessor::getBlogList (const ValueTree& dirTree)
 {
     jassert (dirTree.getType().toString() != "doc");
     const File& indexFile (DocTreeViewItem::getHtmlFile (dirTree));
-    StringArray filesLinkStr;
 
-    getBlogListHtmlStr (dirTree, indexFile, filesLinkStr);
-    filesLinkStr.sort (true);
+    PageDependencies::getInstance()->readScope (dirTree, 
+                                                PageDependencies::titleProp | PageDependencies::descProp
+                                                | PageDependencies::createDateProp | PageDependencies::modifyDateProp
+                                                | PageDependencies::thumbProp | PageDependencies::visibilityProp);
+    Array<BlogListItem> items;
+    getBlogListItems (dirTree, indexFile, items);
 
-    for (int i = filesLinkStr.size(); --i >= 0; )
+    struct Sorter  // see ListOrder, the latest created first by default
     {
-        if (filesLinkStr[i].substring (0, 3) == "dir")
-            filesLinkStr.remove (i);
+        Sorter (const int order_) : order (order_) { }
+
+        const int compareElements (const BlogListItem& f, const BlogListItem& s) const
+        {
+            int result = 0;
+
+            if (order == latestModifiedFirst)
+                result = s.modifyDate.compare (f.modifyDate);
+
+            // the dates without seconds, then the title... case-insensitive, as the old list was
+            if (result == 0)
+                result = s.sortKey.compareIgnoreCase (f.sortKey);
+
+            return (order == oldestFirst) ? -result : result;
+        }
+
+        const int order;
+    };
+
+    Sorter sorter ((int)dirTree.getProperty ("listOrder", (int)newestFirst));
+    items.sort (sorter);
+
+    // convert the descriptions which aren't in the cache, on the worker pool
+    struct DescToHtml : public WorkerPool::Task
+    {
+        DescToHtml (Array<BlogListItem>& items_, const Array<int>& uncached_) 
+            : items (items_), uncached (uncached_)
+        {
+        }
+
+        void runItem (const int index) override
+        {
+            BlogListItem& item (items.getReference (uncached[index]));
+            item.descHtml = Md2Html::mdStringToHtml (item.descMd);
+        }
+
+        Array<BlogListItem>& items;
+        const Array<int>& uncached;
+    };
+
+    Array<int> uncached;
+
+    for (int i = 0; i < items.size(); ++i)
+    {
+        if (!getCachedDescHtml (items.getReference (i)))
+            uncached.add (i);
     }
 
-    StringArray linkStr;
+    DescToHtml descToHtml (items, uncached);
+    WorkerPool::getInstance()->runAll (descToHtml, uncached.size());
+
+    for (int i = 0; i < uncached.size(); ++i)
+        cacheDescHtml (items.getReference (uncached[i]));
+
+    return items;
+}
+
+//=================================================================================================
+void HtmlProcessor::writeBlogListPages (const StringArray& tplPieces,
+                                        const Array<BlogListItem>& items,
+                                        const int pageSize,
+                                        const File& indexHtml)
+{
+    jassert (pageSize > 0);
+    const int howManyPages = jmax (1, (items.size() + pageSize - 1) / pageSize);
+
+    struct PageWriter : public WorkerPool::Task
+    {
+        PageWriter (const StringArray& tplPieces_, const Array<BlogListItem>& items_,
+                    const int pageSize_, const File& indexHtml_)
+            : tplPieces (tplPieces_), items (items_), 
+            pageSize (pageSize_), indexHtml (indexHtml_)
+        {
+        }
+
+        void runItem (const int pageIndex) override
+        {
+            writeBlogListPage (tplPieces, items, pageSize, pageIndex, indexHtml);
+        }
+
+        const StringArray& tplPieces;
+        const Array<BlogListItem>& items;
+        const int pageSize;
+        const File indexHtml;
+    };
+
+    PageWriter pageWriter (tplPieces, items, pageSize, indexHtml);
+    WorkerPool::getInstance()->runAll (pageWriter, howManyPages);
 
-    for (int i = filesLinkStr.size(); --i >= 0; )
+    // the list became shorter
+    for (int i = howManyPages + 1; ; ++i)
     {
-        filesLinkStr.getReference (i) = filesLinkStr[i].substring (12); // remove "dir/doc @_^_#_%_@"
-        const String dateStr (filesLinkStr[i].upToFirstOccurrenceOf ("@_^_#_%_@", false, false));        
-        const String descStr (filesLinkStr[i].fromLastOccurrenceOf ("@_^_#_%_@", false, false));
-        const String titleStr (filesLinkStr[i].substring (dateStr.length() + 9).dropLastCharacters (descStr.length() + 9));
+        const File oldPage (indexHtml.getSiblingFile ("index-" + String (i) + ".html"));
+
+        if (!oldPage.existsAsFile())
+            break;
 
-        linkStr.add (titleStr);
-        linkStr.add (dateStr);
-        linkStr.add (Md2Html::mdStringToHtml (descStr));
+        deletePage (oldPage);
     }
+}
 
-    for (int i = 0; i < linkStr.size(); ++i)
+//=================================================================================================
+void HtmlProcessor::writeBlogListPage (const StringArray& tplPieces,
+                                       const Array<BlogListItem>& items,
+                                       const int pageSize,
+                                       const int pageIndex,
+                                       const File& indexHtml)
+{
+    const int howManyPages = (items.size() + pageSize - 1) / pageSize;
+    String listStr;
+
+    if (items.size() > 0)
+    {
+        MemoryOutputStream listStream;
+        listStream << "<div>";
+
+        for (int i = pageIndex * pageSize; i < jmin (items.size(), (pageIndex + 1) * pageSize); ++i)
+        {
+            const BlogListItem& item (items.getReference (i));
+
+            listStream << "<div class=listTitle>" << item.titleHtml << "</div>" << newLine
+                << "<div class=listDate>" << item.dateHtml << "</div>" << newLine
+                << "<div class=listDesc>" << item.descHtml << "</div><hr>" << newLine;
+        }
+
+        listStream << getPageNavi (howManyPages, pageIndex + 1) << "</div>";
+        listStr = listStream.toUTF8();
+    }
+
+    const String pageStr (tplPieces.joinIntoString (listStr));
+    const File pageFile ((pageIndex == 0) ? indexHtml
+                         : indexHtml.getSiblingFile ("index-" + String (pageIndex + 1) + ".html"));
+
+    writeHtmlIfChanged (pageFile, pageStr);
+}
+
+//=================================================================================================
+const bool HtmlProcessor::writeHtmlIfChanged (const File& htmlFile, const String& originalStr)
+{
+    const Profiler::ScopedTimer timer ("writeHtml");
+    const bool compress = (bool)FileTreeContainer::projectTree.getProperty ("compressHtml");
+    const File gzFile (htmlFile.getFullPathName() + ".gz");
+
+    // the urls of the add-in files -> their fingerprinted copies
+    String htmlStr (AssetManifest::getInstance()->rewriteUrls (originalStr));
+
+    if (compress)
+    {
+        const Profiler::ScopedTimer minifyTimer ("minify");
+        htmlStr = HtmlMinifier::minify (htmlStr);
+    }
+    else if (gzFile.existsAsFile())
+    {
+        // it would be out of date
+        gzFile.deleteFile();
+    }
+
+    const size_t numBytes = htmlStr.getNumBytesAsUTF8();
+    bool changed = true;
+
+    // compare the size first, only load the file when it might be the same
+    if (htmlFile.existsAsFile() && htmlFile.getSize() == (int64) numBytes)
+    {
+        MemoryBlock oldContent;
+
+        if (htmlFile.loadFileAsData (oldContent)
+            && memcmp (oldContent.getData(), htmlStr.toRawUTF8(), numBytes) == 0)
+            changed = false;
+    }
+
+    if (changed && !htmlFile.replaceWithData (htmlStr.toRawUTF8(), numBytes))
+        return false;
+
+    Profiler::addCount (changed ? "pagesWritten" : "pagesUnchanged");
+    Profiler::addCount ("bytesWritten", changed ? (int64) numBytes : 0);
+
+    if (compress && (changed || !gzFile.existsAsFile()))
     {
-        if (0 == i % 3)
-            linkStr.getReference (i) = "<div class=listTitle>" + linkStr[i] + "</div>";
-        else if (1 == i % 3)
-            linkStr.getReference (i) = "<div class=listDate>" + linkStr[i] + "</div>";
+        struct GzipJob : public ThreadPoolJob
+        {
+            GzipJob (const File& htmlFile_, const MemoryBlock& htmlData_)
+                : ThreadPoolJob ("GzipHtml"), htmlFile (htmlFile_), htmlData (htmlData_)
+            {
+            }
+
+            JobStatus runJob() override
+            {
+                writeGzip (htmlFile, htmlData);
+
+                CompressQueue& queue (getCompressQueue());
+                const ScopedLock sl (queue.lock);
+
+                if (--queue.numPending == 0)
+                    queue.allWritten.signal();
+
+                return jobHasFinished;
+            }
+
+            const File htmlFile;
+            const MemoryBlock htmlData;
+        };
+
+        const MemoryBlock htmlData (htmlStr.toRawUTF8(), numBytes);
+        CompressQueue& queue (getCompressQueue());
+        bool inBackground = false;
+
+        {
+            const ScopedLock sl (queue.lock);
+
+            if (queue.active)
+            {
+                if (queue.numPending++ == 0)
+                    queue.allWritten.reset();
+
+                inBackground = true;
+            }
+        }
+
+        if (inBackground)
+            WorkerPool::getInstance()->addJob (new GzipJob (htmlFile, htmlData));
         else
-            linkStr.getReference (i) = "<div class=listDesc>" + linkStr[i] + "</div><hr>";
+            writeGzip (htmlFile, htmlData);
     }
 
-    //DBGX(linkStr.joinIntoString(newLine));
-    return linkStr;
+    return changed;
+}
+
+//=================================================================================================
+void HtmlProcessor::deletePage (const File& htmlFile)
+{
+    htmlFile.deleteFile();
+    File (htmlFile.getFullPathName() + ".gz").deleteFile();
+}
+
+//=================================================================================================
+void HtmlProcessor::writeGzip (const File& htmlFile, const MemoryBlock& htmlData)
+{
+    const Profiler::ScopedTimer timer ("gzip");
+    TemporaryFile tempFile (File (htmlFile.getFullPathName() + ".gz"));
+
+    {
+        ScopedPointer<FileOutputStream> out (tempFile.getFile().createOutputStream());
+
+        if (out == nullptr || out->failedToOpen())
+            return;
+
+        // zlib writes the gzip header and trailer instead of its own
+        GZIPCompressorOutputStream gzip (out.release(), 9, true, GZIPCompressorOutputStream::windowBitsGZIP);
+        gzip.write (htmlData.getData(), htmlData.getSize());
+        gzip.flush();
+    }
+
+    tempFile.overwriteTargetFileWithTemporary();
 }
 
 //=================================================================================================
@@ -1517,6 +1949,10 @@ const String HtmlProcessor::getBookList (const ValueTree& dirTree)
         }
     };
 
+    PageDependencies::getInstance()->readScope (dirTree, 
+                                                PageDependencies::titleProp | PageDependencies::createDateProp
+                                                | PageDependencies::visibilityProp);
+
     ValueTree tree (dirTree.createCopy());
     Sorter s;
     tree.sort (s, nullptr, false);
@@ -1546,3 +1982,155 @@ const String HtmlProcessor::getContactInfo()
     return "<div class=contact>" + contactStr + "</div>";
 }
 
+//=================================================================================================
+const bool HtmlProcessor::writeSingleHtmlBody (const ValueTree& dirTree,
+                                               const Array<ValueTree>& docs,
+                                               OutputStream& out,
+                                               Array<File>& medias,
+                                               ThreadWithProgressWindow* progressWindow)
+{
+    struct DocRenderer : public WorkerPool::Task
+    {
+        DocRenderer (OwnedArray<ExportedDoc>& exportedDocs_, const int firstDoc_) 
+            : exportedDocs (exportedDocs_), firstDoc (firstDoc_) 
+        { 
+        }
+
+        void runItem (const int index) override
+        {
+            renderExportedDoc (*exportedDocs.getUnchecked (firstDoc + index));
+        }
+
+        OwnedArray<ExportedDoc>& exportedDocs;
+        const int firstDoc;
+    };
+
+    OwnedArray<ExportedDoc> exportedDocs;
+
+    for (int i = 0; i < docs.size(); ++i)
+        exportedDocs.add (new ExportedDoc (docs.getReference (i), i));
+
+    // only a batch of the rendered html is held in memory at the same time
+    const int batchSize = jmax (1, SystemStats::getNumCpus()) * 2;
+
+    // the toc is in front of the content, so the content goes to a temp file first
+    TemporaryFile bodyFile;
+    StringArray tocItems;
+    bool succeeded = true;
+
+    {
+        FileOutputStream bodyStream (bodyFile.getFile());
+        succeeded = !bodyStream.failedToOpen();
+
+        for (int firstDoc = 0; succeeded && firstDoc < exportedDocs.size(); firstDoc += batchSize)
+        {
+            const int numDocs = jmin (batchSize, exportedDocs.size() - firstDoc);
+            DocRenderer renderer (exportedDocs, firstDoc);
+
+            if (!WorkerPool::getInstance()->runAll (renderer, numDocs, progressWindow))
+                return false;
+
+            for (int i = firstDoc; i < firstDoc + numDocs; ++i)
+            {
+                ExportedDoc& doc (*exportedDocs.getUnchecked (i));
+
+                tocItems.addArray (doc.tocItems);
+                medias.addArray (doc.medias);
+                bodyStream << doc.html << newLine << newLine;
+
+                // needn't keep it any more
+                doc.html = String();
+                doc.tocItems.clear();
+            }
+
+            if (progressWindow != nullptr)
+                progressWindow->setProgress ((double) (firstDoc + numDocs) / exportedDocs.size());
+        }
+
+        bodyStream.flush();
+        succeeded = succeeded && !bodyStream.getStatus().failed();
+    }
+
+    if (!succeeded)
+        return false;
+
+    // title, description and the toc of all docs
+    const String pageBottom (newLine + "<span id=\"wdtpPageBottom\"></span>");
+    const String headMd ("# " + dirTree.getProperty ("title").toString() + newLine + newLine
+                         + dirTree.getProperty ("description").toString() + newLine + newLine
+                         + "[TOC]");
+
+    const String headHtml (Md2Html::mdStringToHtml (headMd).replace (pageBottom, String())
+                           .replace ("<div class=toc></div>",
+                                     "<div class=toc>" + tocItems.joinIntoString (newLine) + "</div>"));
+
+    out << headHtml << newLine << newLine;
+
+    FileInputStream bodyInput (bodyFile.getFile());
+
+    if (bodyInput.failedToOpen())
+        return false;
+
+    out.writeFromInputStream (bodyInput, -1);
+    out << pageBottom;
+
+    return true;
+}
+
+//=================================================================================================
+void HtmlProcessor::renderExportedDoc (ExportedDoc& doc)
+{
+    const File mdFile (DocTreeViewItem::getMdFileOrDir (doc.docTree));
+    DocTreeViewItem::getMdMediaFiles (mdFile, doc.medias);
+
+    String mdStr (processAbbrev (doc.docTree, mdFile.loadFileAsString()));
+
+    // cancel '[TOC]' withou remove its escape
+    mdStr = mdStr.replace ("\\[TOC]", "@#@_wdtpToc_@#@");
+
+    mdStr = mdStr.replace (newLine + "[TOC]" + newLine, String())
+        .replace (newLine + "[TOC]", String())
+        .replace (String ("[TOC]") + newLine, String())
+        .replace ("[TOC]", String())
+        .replace ("@#@_wdtpToc_@#@", "\\[TOC]");
+
+    // the endnotes of each doc are numbered from 1, their ids must be unique in the whole page.
+    // and only the whole page has the bottom
+    const String endnotePrefix ("doc" + String (doc.index + 1) + "-endnote-");
+
+    doc.html = CodeHighlighter::process (Md2Html::mdStringToHtml (mdStr.trimEnd()))
+        .replace (newLine + "<span id=\"wdtpPageBottom\"></span>", String())
+        .replace ("\"#endnote-", "\"#" + endnotePrefix)
+        .replace ("id=\"endnote-", "id=\"" + endnotePrefix);
+
+    doc.tocItems = getTocItemsOfHtml (doc.html);
+}
+
+//=================================================================================================
+const StringArray HtmlProcessor::getTocItemsOfHtml (const String& html)
+{
+    const String dot (CharPointer_UTF8 ("\xc2\xb7"));
+    StringArray lines, items;
+    lines.addLines (html);
+
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        const String& line (lines[i]);
+
+        // <h1 id="xxx">, <h2 id="xxx"> and <h3 id="xxx">
+        if (!line.startsWith ("<h") || line.substring (3, 9) != " id=\"")
+            continue;
+
+        const int headLevel = line[2] - '0';
+        const String titleStr (line.substring (9).upToFirstOccurrenceOf ("\">", false, false));
+
+        if (headLevel == 1)
+            items.add ("<a href=\"#" + titleStr + "\">" + titleStr + "</a><br>");
+        else if (headLevel == 2)
+            items.add (" &emsp;&emsp;" + dot + " <a href=\"#" + titleStr + "\">" + titleStr + "</a><br>");
+        else if (headLevel == 3)
+            items.add (" &emsp;&emsp;&emsp;&emsp;" + dot + " <a href=\"#" + titleStr + "\">" + titleStr + "</a><br>");
+    }
+
+    return items;
+}
@@ -41,9 +41,36 @@ struct HtmlProcessor
     static const File createArticleHtml (ValueTree& docTree, bool saveProjectAfterCreated);
     static const File createIndexHtml (ValueTree& dirTree, bool saveProjectAfterCreated);
 
+    /** delete a generated page and its .gz, a server might serve the .gz of a removed page otherwise */
+    static void deletePage (const File& htmlFile);
+
     static const String extractKeywordsOfDocs (const ValueTree& dirTree);
     static const String getKeywordsLinks (const String& rootPath);
 
+    //=========================================================================
+    /** while an object of this is alive, the data which almost every page needs 
+        (such as the docs of random-articles, the add-in files) will be gathered only once, and the .gz
+        of the pages will be written on the worker pool, which will be waited in the destructor.
+        create one on the stack before generate lots of pages. */
+    struct GenerationScope
+    {
+        GenerationScope();
+        ~GenerationScope();
+
+        JUCE_DECLARE_NON_COPYABLE (GenerationScope)
+    };
+
+    /** when the project's 'profileGeneration' is on, the time of the stages (see Profiler)
+        will be recorded while an object of this is alive. the report (xxx.profile) and 
+        the Chrome trace (xxx.trace.json) will be written beside the project file in the destructor. */
+    struct ProfilingScope
+    {
+        ProfilingScope();
+        ~ProfilingScope();
+
+        JUCE_DECLARE_NON_COPYABLE (ProfilingScope)
+    };
+
     //=========================================================================
     /** Use for file/dir list sort. Base on create-date */
     const int compareElements (const ValueTree& ft, const ValueTree& st);
@@ -51,20 +78,113 @@ struct HtmlProcessor
     /** the result will include 'hide' doc(s). */
     static void getDocNumbersOfTheDir (const ValueTree& dirTree, int& num);
 
-    /** process the arg-string if it includes any abbrev */
+    /** the sort order of a dir's blog-list, which stores in the dir's property 'listOrder'.
+        the dir's property 'pageSize' decides how many docs in each page of the list. */
+    enum ListOrder { newestFirst = 0, oldestFirst, latestModifiedFirst };
+    enum { defaultPageSize = 10 };
+
+    /** process the arg-string if it includes any abbrev. all abbrevs will be replaced 
+        in a single pass, the longest one wins if several abbrevs start at the same place. */
     static const String processAbbrev (const ValueTree& docTree, 
                                        const String& originalStr);
 
+    /** for export a dir as a single html. write the title, description, the toc of all 
+        the docs and their content into arg-3. the docs are rendered in parallel a batch at a time,
+        each batch will be written then released before the next one.
+        the medias of these docs will be added to arg-4. 
+        arg-5 (could be nullptr) shows the progress, and it stops once the thread should exit.
+        return false if the writing failed or it has been cancelled. */
+    static const bool writeSingleHtmlBody (const ValueTree& dirTree,
+                                           const Array<ValueTree>& docs,
+                                           OutputStream& out,
+                                           Array<File>& medias,
+                                           ThreadWithProgressWindow* progressWindow);
+
 private:
+    /** a doc of the single html, see writeSingleHtmlBody() */
+    struct ExportedDoc
+    {
+        ExportedDoc (const ValueTree& docTree_, const int index_) 
+            : docTree (docTree_), index (index_) { }
+
+        const ValueTree docTree;
+        const int index;
+
+        String html;
+        StringArray tocItems;
+        Array<File> medias;
+    };
+
+    static void renderExportedDoc (ExportedDoc& doc);
+
+    /** the toc items of the <h1> ~ <h3> in the arg html, the same as Md2Html's [TOC] */
+    static const StringArray getTocItemsOfHtml (const String& html);
+
+    /** return the cached automaton of the arg's abbrevs, build it when it isn't there. 
+        return nullptr if there's no any valid abbrev. */
+    static const MultiReplacer::Ptr getAbbrevReplacer (const String& abbrevStr);
+
     /** Process tpl-file's tags */
     static void processTplTags (const ValueTree& docOrDirTree, 
                                 const File& htmlFile, 
                                 String& tplStr);
 
-    /** these 2 non-include 'hide' docs */
-    static const StringArray getBlogList (const ValueTree& dirTree);
+    /** one doc of the blog-list. descMd will be converted to descHtml by getBlogList() */
+    struct BlogListItem
+    {
+        String createDate, modifyDate;
+        String titleHtml, dateHtml;
+        String descMd, descHtml;
+        String descKey;  // hash of descMd, for the cache
+        String sortKey;  // dateHtml, titleHtml and descMd, the same text as the old list was sorted by
+    };
+
+    /** these 2 non-include 'hide' docs. the blog-list is sorted by the dir's 'listOrder' */
+    static const Array<BlogListItem> getBlogList (const ValueTree& dirTree);
     static const String getBookList (const ValueTree& dirTree);
 
+    /** write index.html, index-2.html... of a blog-list dir. 
+        arg-1 is the tpl which has been split by "{{blogList}}", so it needn't be searched for each page.
+        the pages are rendered in parallel, and a page file will only be written when its content changed. */
+    static void writeBlogListPages (const StringArray& tplPieces,
+                                    const Array<BlogListItem>& items,
+                                    const int pageSize,
+                                    const File& indexHtml);
+
+    /** arg-2: 0 for index.html, 1 for index-2.html... */
+    static void writeBlogListPage (const StringArray& tplPieces,
+                                   const Array<BlogListItem>& items,
+                                   const int pageSize,
+                                   const int pageIndex,
+                                   const File& indexHtml);
+
+    /** return false if the file hasn't been written since it already has the same content. 
+        the urls of the add-in files will be replaced by AssetManifest.
+        when the project's 'compressHtml' is on, the html will be minified first and 
+        a .gz beside it will be written (for the server which could send precompressed files). */
+    static const bool writeHtmlIfChanged (const File& htmlFile, const String& originalStr);
+
+    /** before generating a single page, check whether the add-in files have been changed.
+        within a GenerationScope, it has been done when the scope began. */
+    static void refreshAssetsOutOfScope();
+
+    /** write arg-2 to 'xxx.html.gz' */
+    static void writeGzip (const File& htmlFile, const MemoryBlock& htmlData);
+
+    /** the .gz which are being written on the worker pool within a GenerationScope.
+        allWritten is signalled when there's no pending one. */
+    struct CompressQueue
+    {
+        CompressQueue() : active (false), numPending (0), allWritten (true)   { allWritten.signal(); }
+
+        CriticalSection lock;
+        bool active;
+        int numPending;
+        WaitableEvent allWritten;
+    };
+
+    static CompressQueue& getCompressQueue();
+
     enum ExtrcatType { publishDate, ModifiedDate, featuredArticle };
 
     /** it'll extract modified date when extract featured articles         
@@ -111,20 +231,47 @@ private:
         the img should place in site's add-in folder. */
     static const String getAdStr (const String& text, const File& htmlFile);
 
-    /** return 'howMany' ints, range: 0 ~ getDocNumbersOfTheDir (projectTree). */
-    static const Array<int> getRandomInts (const int howMany);
+    /** a doc which could be a random article. sitePath is based on the site's root dir */
+    struct RandomDoc
+    {
+        ValueTree tree;
+        String sitePath, title;
+    };
+
+    /** all docs which could be a random article. within a GenerationScope, it'll be
+        gathered only once, otherwise, they'll be gathered to arg-1 and return it. 
+        the caller must hold the lock of getRandomDocsCache(). */
+    static const Array<RandomDoc>& getRandomDocs (Array<RandomDoc>& tempDocs);
+    static void addRandomDocs (const ValueTree& tree, Array<RandomDoc>& docs);
+
+    struct RandomDocsCache
+    {
+        RandomDocsCache() : numScopes (0), gathered (false) { }
+
+        CriticalSection lock;
+        Array<RandomDoc> docs;
+        int numScopes;
+        bool gathered;
+    };
+
+    static RandomDocsCache& getRandomDocsCache();
 
-    /** get the arg tree's all child tree's link string. their path base on the arg 2 tree.
-        Note: not include the baseOnThisTree's link and not include create-date, desc, etc.
-        This method is for random articel. */
-    static void getLinkStrOfAlllDocTrees (const ValueTree& fromThisTree,
-                                          const ValueTree& baseOnThisTree,
-                                          StringArray& linkStr);
+    /** pick 'howMany' different ints in range 0 ~ (total - 1), in random order.
+        Floyd's sampling and a shuffle: the cost is only depends on 'howMany'. */
+    static const Array<int> getRandomInts (Random& r, const int howMany, const int total);
 
     /** this method is for file-list of index.html. it'll include create date and extra info */
-    static void getBlogListHtmlStr (const ValueTree& tree,
-                                    const File& baseOnthisFile,
-                                    StringArray& linkStr);
+    static void getBlogListItems (const ValueTree& tree,
+                                  const File& baseOnthisFile,
+                                  Array<BlogListItem>& items);
+
+    /** the converted descriptions of the blog-list, keyed by the hash of their markdown. 
+        so a doc's description will only be converted again after it's changed.
+        getCachedDescHtml() returns false if it isn't in the cache. */
+    static const bool getCachedDescHtml (BlogListItem& item);
+    static void cacheDescHtml (const BlogListItem& item);
+    static CriticalSection& getDescCacheLock();
+    static HashMap<String, String>& getDescCache();
 
     static void getBookListLinks (const ValueTree& tree,
                                   const bool isRootTree,
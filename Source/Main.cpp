@@ -27,7 +27,13 @@ public:
     const String getApplicationName() override      { return ProjectInfo::projectName; }
     const String getApplicationVersion() override   { return ProjectInfo::versionString; }
     bool moreThanOneInstanceAllowed() override      { return true; }
-    void systemRequestedQuit() override             { quit(); }
+
+    void systemRequestedQuit() override
+    {
+        // the recorded narration is still being encoded
+        if (Mp3Encoder::getInstance()->finishAllBeforeQuit())
+            quit();
+    }
 
     //==============================================================================
     void initialise (const String& commandLine) override
@@ -97,6 +103,14 @@ public:
 
         systemFile->saveIfNeeded();
         TipsBank::deleteInstance();
+        PageDependencies::deleteInstance();
+        MediaIndex::deleteInstance();
+        ResponsiveImages::deleteInstance();
+        AssetManifest::deleteInstance();
+        DocSaver::deleteInstance();
+        DocStatistics::deleteInstance();
+        Mp3Encoder::deleteInstance();
+        WorkerPool::deleteInstance();
 
         deleteAndZero (systemFile);
         deleteAndZero (cmdManager);
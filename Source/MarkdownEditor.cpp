@@ -367,7 +367,7 @@ void MarkdownEditor::performPopupMenuAction (int index)
             return;
         }
             
-        if (SwingUtilities::convertPngToJpg (pngFile, jpgFile, 0.7f, false))
+        if (ImageProcessor::processFile (ImageProcessor::convertToJpg, pngFile, jpgFile, 0.7f))
         {
             setHighlightedRegion (Range<int> (getHighlightedRegion().getStart(),
                                               getHighlightedRegion().getEnd() + 4));
@@ -393,7 +393,7 @@ void MarkdownEditor::performPopupMenuAction (int index)
             return;
         }
 
-        if (SwingUtilities::transparentImage (origFile, pngFile, false))
+        if (ImageProcessor::processFile (ImageProcessor::transparentWhite, origFile, pngFile))
         {
             setHighlightedRegion (Range<int> (getHighlightedRegion().getStart(),
                                               getHighlightedRegion().getEnd() + 4));
@@ -412,7 +412,8 @@ void MarkdownEditor::performPopupMenuAction (int index)
         const File& imgFile (parent->getCurrentDocFile().getSiblingFile ("media")
                              .getChildFile (getSelectedFileName()));
 
-        if (SwingUtilities::processImageWidth (imgFile, (halfWidth == index ? 0.5f : 0.75f)))
+        if (ImageProcessor::processFile (ImageProcessor::rescaleWidth, imgFile, imgFile,
+                                         (halfWidth == index ? 0.5f : 0.75f)))
             parent->getCurrentTree().setProperty ("needCreateHtml", true, nullptr);
         else
             SHOW_MESSAGE (TRANS ("Somehow this operation failed."));
@@ -424,7 +425,9 @@ void MarkdownEditor::performPopupMenuAction (int index)
                              .getChildFile (getSelectedFileName()));
         const File& targetFile (originalmgFile.getNonexistentSibling (false));
 
-        if (SwingUtilities::rotateImage (originalmgFile, targetFile, (rotateImgLeft == index), false))
+        if (ImageProcessor::processFile ((rotateImgLeft == index) ? ImageProcessor::rotateLeft
+                                                                : ImageProcessor::rotateRight,
+                                         originalmgFile, targetFile))
         {
             setHighlightedRegion (Range<int> (getHighlightedRegion().getStart(),
                                               getHighlightedRegion().getEnd() + 4));
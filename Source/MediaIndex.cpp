@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    MediaIndex.cpp
+    Created: 19 Oct 2026 10:14:22pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "WdtpHeader.h"
+
+MediaIndex::MediaIndex()
+{
+}
+
+//=================================================================================================
+MediaIndex::~MediaIndex()
+{
+    clearSingletonInstance();
+}
+
+juce_ImplementSingleton (MediaIndex);
+
+//=================================================================================================
+void MediaIndex::updateDoc (const File& mdFile)
+{
+    if (!mdFile.existsAsFile())
+    {
+        removeDoc (mdFile);
+        return;
+    }
+
+    // the medias which don't exist must be included,
+    // otherwise a media copied into its place later would be needless
+    Array<File> medias;
+    DocTreeViewItem::getMdMediaFiles (mdFile, medias, false);
+
+    StringArray mediaKeys;
+
+    for (int i = 0; i < medias.size(); ++i)
+        mediaKeys.addIfNotAlreadyThere (getKey (medias[i]));
+
+    setDocMedias (getKey (mdFile), getStamp (mdFile), mediaKeys);
+}
+
+//=================================================================================================
+void MediaIndex::removeDoc (const File& mdFile)
+{
+    const ScopedLock sl (lock);
+    const String docKey (getKey (mdFile));
+
+    setDocMedias (docKey, String(), StringArray());
+    docs.remove (docKey);
+}
+
+//=================================================================================================
+void MediaIndex::setDocMedias (const String& docKey, const String& stamp, const StringArray& mediaKeys)
+{
+    const ScopedLock sl (lock);
+
+    // remove its old references
+    if (docs.contains (docKey))
+    {
+        const StringArray oldKeys (docs[docKey].mediaKeys);
+
+        for (int i = oldKeys.size(); --i >= 0; )
+        {
+            StringArray docKeys (mediaDocs[oldKeys[i]]);
+            docKeys.removeString (docKey);
+
+            if (docKeys.size() > 0)
+                mediaDocs.set (oldKeys[i], docKeys);
+            else
+                mediaDocs.remove (oldKeys[i]);
+        }
+    }
+
+    for (int i = mediaKeys.size(); --i >= 0; )
+    {
+        StringArray docKeys (mediaDocs[mediaKeys[i]]);
+        docKeys.addIfNotAlreadyThere (docKey);
+        mediaDocs.set (mediaKeys[i], docKeys);
+    }
+
+    DocMedias doc;
+    doc.stamp = stamp;
+    doc.mediaKeys = mediaKeys;
+    docs.set (docKey, doc);
+}
+
+//=================================================================================================
+void MediaIndex::refresh()
+{
+    const ScopedLock sl (lock);
+
+    Array<File> mdFiles;
+    FileTreeContainer::projectFile.getSiblingFile ("docs")
+        .findChildFiles (mdFiles, File::findFiles, true, "*.md");
+
+    HashMap<String, int> existingKeys;
+
+    for (int i = mdFiles.size(); --i >= 0; )
+    {
+        const String docKey (getKey (mdFiles[i]));
+        existingKeys.set (docKey, i);
+
+        if (!docs.contains (docKey) || docs[docKey].stamp != getStamp (mdFiles[i]))
+            updateDoc (mdFiles[i]);
+    }
+
+    // the docs which have been deleted or moved
+    StringArray removedKeys;
+
+    for (HashMap<String, DocMedias>::Iterator itr (docs); itr.next(); )
+    {
+        if (!existingKeys.contains (itr.getKey()))
+            removedKeys.add (itr.getKey());
+    }
+
+    for (int i = removedKeys.size(); --i >= 0; )
+        removeDoc (getFile (removedKeys[i]));
+}
+
+//=================================================================================================
+const bool MediaIndex::isReferenced (const File& mediaFile) const
+{
+    const ScopedLock sl (lock);
+    return mediaDocs.contains (getKey (mediaFile));
+}
+
+//=================================================================================================
+void MediaIndex::getReferencingDocs (const File& mediaFile, Array<File>& result) const
+{
+    const ScopedLock sl (lock);
+    const StringArray docKeys (mediaDocs[getKey (mediaFile)]);
+
+    for (int i = 0; i < docKeys.size(); ++i)
+        result.add (getFile (docKeys[i]));
+}
+
+//=================================================================================================
+void MediaIndex::getNeedlessMedias (Array<File>& medias)
+{
+    const ScopedLock sl (lock);
+    refresh();
+
+    Array<File> mediaDirs;
+    FileTreeContainer::projectFile.getSiblingFile ("docs")
+        .findChildFiles (mediaDirs, File::findDirectories, true, "media");
+
+    for (int i = mediaDirs.size(); --i >= 0; )
+    {
+        Array<File> files;
+        mediaDirs[i].findChildFiles (files, File::findFiles, false);
+
+        for (int j = files.size(); --j >= 0; )
+        {
+            if (!isReferenced (files[j]))
+                medias.add (files[j]);
+        }
+    }
+}
+
+//=================================================================================================
+const String MediaIndex::getKey (const File& file)
+{
+    const String key (file.getRelativePathFrom (FileTreeContainer::projectFile.getParentDirectory())
+                      .replace ("\\", "/"));
+
+    return File::areFileNamesCaseSensitive() ? key : key.toLowerCase();
+}
+
+//=================================================================================================
+const File MediaIndex::getFile (const String& key)
+{
+    return FileTreeContainer::projectFile.getParentDirectory().getChildFile (key);
+}
+
+//=================================================================================================
+const String MediaIndex::getStamp (const File& mdFile)
+{
+    return String (mdFile.getSize()) + "|" + String (mdFile.getLastModificationTime().toMilliseconds());
+}
+
+//=================================================================================================
+void MediaIndex::loadForProject()
+{
+    const ScopedLock sl (lock);
+    clear();
+
+    const File indexFile (FileTreeContainer::projectFile.withFileExtension ("medias"));
+
+    if (!indexFile.existsAsFile())
+        return;
+
+    const ValueTree indexTree (SwingUtilities::readValueTreeFromFile (indexFile, true));
+
+    if (indexTree.getType().toString() != "mediaIndex")
+        return;
+
+    for (int i = 0; i < indexTree.getNumChildren(); ++i)
+    {
+        const ValueTree doc (indexTree.getChild (i));
+        StringArray mediaKeys;
+
+        for (int j = 0; j < doc.getNumChildren(); ++j)
+            mediaKeys.add (doc.getChild (j).getProperty ("key").toString());
+
+        setDocMedias (doc.getProperty ("key").toString(), doc.getProperty ("stamp").toString(), mediaKeys);
+    }
+}
+
+//=================================================================================================
+void MediaIndex::saveForProject()
+{
+    const ScopedLock sl (lock);
+
+    if (!FileTreeContainer::projectTree.isValid() || docs.size() == 0)
+        return;
+
+    ValueTree indexTree ("mediaIndex");
+
+    for (HashMap<String, DocMedias>::Iterator itr (docs); itr.next(); )
+    {
+        ValueTree doc ("doc");
+        doc.setProperty ("key", itr.getKey(), nullptr);
+        doc.setProperty ("stamp", itr.getValue().stamp, nullptr);
+
+        for (int i = 0; i < itr.getValue().mediaKeys.size(); ++i)
+        {
+            ValueTree media ("media");
+            media.setProperty ("key", itr.getValue().mediaKeys[i], nullptr);
+            doc.addChild (media, -1, nullptr);
+        }
+
+        indexTree.addChild (doc, -1, nullptr);
+    }
+
+    SwingUtilities::writeValueTreeToFile (indexTree,
+                                          FileTreeContainer::projectFile.withFileExtension ("medias"),
+                                          true);
+}
+
+//=================================================================================================
+void MediaIndex::clear()
+{
+    const ScopedLock sl (lock);
+
+    docs.clear();
+    mediaDocs.clear();
+}
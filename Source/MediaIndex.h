@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    MediaIndex.h
+    Created: 19 Oct 2026 10:14:22pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef MEDIAINDEX_H_INCLUDED
+#define MEDIAINDEX_H_INCLUDED
+
+/** Which media files are referenced by which docs, so that finding the needless medias
+    or where an image is used needn't parse all docs again.
+
+    A doc is parsed only when it has been saved, created, moved or changed outside
+    (its size or modified time isn't the same as the index).
+    refresh() checks all docs of the project by this way, it's cheap if nothing changed.
+
+    The index will be saved beside the project file (xxx.medias).
+*/
+class MediaIndex
+{
+public:
+    ~MediaIndex();
+    juce_DeclareSingleton (MediaIndex, true);
+
+    /** parse the doc again (or remove it if it's nonexistent) */
+    void updateDoc (const File& mdFile);
+    void removeDoc (const File& mdFile);
+
+    /** update the docs which have been changed, added or removed since the last time */
+    void refresh();
+
+    /** these will not refresh() */
+    const bool isReferenced (const File& mediaFile) const;
+    void getReferencingDocs (const File& mediaFile, Array<File>& docs) const;
+
+    /** all media files of the project (in 'media' dirs of docs) which no any doc uses them */
+    void getNeedlessMedias (Array<File>& medias);
+
+    /** the index file is 'projectName.medias' which beside the project file */
+    void loadForProject();
+    void saveForProject();
+    void clear();
+
+private:
+    MediaIndex();
+
+    /** based on the project dir, e.g. 'docs/dir/media/img.jpg' */
+    static const String getKey (const File& file);
+    static const File getFile (const String& key);
+
+    /** size and modified time of a doc */
+    static const String getStamp (const File& mdFile);
+
+    void setDocMedias (const String& docKey, const String& stamp, const StringArray& mediaKeys);
+
+    //=================================================================================================
+    struct DocMedias
+    {
+        String stamp;
+        StringArray mediaKeys;
+    };
+
+    CriticalSection lock;
+    HashMap<String, DocMedias> docs;
+    HashMap<String, StringArray> mediaDocs;     // media key -> doc keys
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MediaIndex)
+};
+
+
+#endif  // MEDIAINDEX_H_INCLUDED
@@ -0,0 +1,323 @@
+/*
+  ==============================================================================
+
+    Mp3Encoder.cpp
+    Created: 20 Oct 2026 4:21:09am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "WdtpHeader.h"
+
+extern File lameEncoder;
+
+Mp3Encoder::Mp3Encoder()
+    : Thread ("Mp3EncoderThread"),
+      encoding (false),
+      listener (nullptr)
+{
+}
+
+//=================================================================================================
+Mp3Encoder::~Mp3Encoder()
+{
+    cancelAll();
+    stopThread (5000);
+    cancelPendingUpdate();
+    clearSingletonInstance();
+}
+
+juce_ImplementSingleton (Mp3Encoder);
+
+//=================================================================================================
+void Mp3Encoder::encodeInBackground (const File& wavFile, const int64 startSample, const int64 numSamples,
+                                     const float gain, const File& mp3File, const File& docFile)
+{
+    Job job;
+    job.wavFile = wavFile;
+    job.mp3File = mp3File;
+    job.docFile = docFile;
+    job.startSample = startSample;
+    job.numSamples = numSamples;
+    job.gain = gain;
+
+    {
+        const ScopedLock sl (lock);
+        jobs.add (job);
+    }
+
+    if (!isThreadRunning())
+        startThread();
+
+    notify();
+}
+
+//=================================================================================================
+const bool Mp3Encoder::isEncoding() const
+{
+    const ScopedLock sl (lock);
+    return encoding || jobs.size() > 0;
+}
+
+//=================================================================================================
+void Mp3Encoder::cancelAll()
+{
+    const ScopedLock sl (lock);
+
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        jobs.getReference (i).wavFile.deleteFile();
+        jobs.getReference (i).mp3File.deleteFile();
+        failedJobs.add (jobs.getReference (i));
+    }
+
+    jobs.clear();
+
+    // the current one will stop at its next block (or lame's next output)
+    if (encoding)
+        cancelled = 1;
+
+    triggerAsyncUpdate();
+}
+
+//=================================================================================================
+const bool Mp3Encoder::finishAllBeforeQuit()
+{
+    struct WaitingThread : public ThreadWithProgressWindow
+    {
+        WaitingThread (Mp3Encoder& encoder_)
+            : ThreadWithProgressWindow (TRANS ("Encoding the recorded audio..."), true, true),
+              encoder (encoder_)
+        {
+        }
+
+        void run() override
+        {
+            while (encoder.isEncoding() && !threadShouldExit())
+            {
+                setProgress (encoder.progress.get() / 1000.0);
+                wait (100);
+            }
+        }
+
+        Mp3Encoder& encoder;
+    };
+
+    if (!isEncoding())
+        return true;
+
+    WaitingThread waitingThread (*this);
+
+    if (waitingThread.runThread())
+        return true;
+
+    return AlertWindow::showOkCancelBox (AlertWindow::WarningIcon, TRANS ("Confirm"),
+                                         TRANS ("The audio which hasn't been encoded will be lost, "
+                                                "and its mark in the doc will point to a missing file.")
+                                         + newLine + newLine + TRANS ("Do you really want to quit?"));
+}
+
+//=================================================================================================
+void Mp3Encoder::run()
+{
+    while (!threadShouldExit())
+    {
+        Job job;
+        bool hasJob = false;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (jobs.size() > 0)
+            {
+                job = jobs.getReference (0);
+                jobs.remove (0);
+                hasJob = true;
+                cancelled = 0;
+            }
+
+            encoding = hasJob;
+        }
+
+        // nothing to do, wait for the next one
+        if (!hasJob)
+        {
+            triggerAsyncUpdate();
+            wait (-1);
+            continue;
+        }
+
+        setProgress (0.0);
+
+        const File processedWav (File::createTempFile ("wav"));
+        const bool encoded = writeProcessedWav (job, processedWav) && encodeWav (processedWav, job.mp3File);
+
+        processedWav.deleteFile();
+        job.wavFile.deleteFile();
+
+        if (!encoded)
+        {
+            // the name was reserved when the job was added, and a cancelled one has lost its audio too.
+            // nobody could be told when the app is quitting
+            job.mp3File.deleteFile();
+
+            if (!threadShouldExit())
+            {
+                const ScopedLock sl (lock);
+                failedJobs.add (job);
+            }
+
+            triggerAsyncUpdate();
+        }
+    }
+}
+
+//=================================================================================================
+const bool Mp3Encoder::writeProcessedWav (const Job& job, const File& processedWav)
+{
+    WavAudioFormat wavFormat;
+    FileInputStream* inputStream = job.wavFile.createInputStream();
+
+    if (inputStream == nullptr)
+        return false;
+
+    ScopedPointer<AudioFormatReader> reader (wavFormat.createReaderFor (inputStream, true));
+
+    if (reader == nullptr)
+        return false;
+
+    const int64 numSamples = jmin (job.numSamples, reader->lengthInSamples - job.startSample);
+    ScopedPointer<FileOutputStream> outputStream (processedWav.createOutputStream());
+
+    if (numSamples <= 0 || outputStream == nullptr)
+        return false;
+
+    ScopedPointer<AudioFormatWriter> writer (wavFormat.createWriterFor (outputStream, reader->sampleRate,
+                                                                        1, 16, StringPairArray(), 0));
+    if (writer == nullptr)
+        return false;
+
+    outputStream.release();
+
+    // fade in and fade out, each of them is 0.1s at 44.1k
+    const int64 rampLength = jmin ((int64) rampSize, numSamples / 2);
+    const int64 fadeOutStart = numSamples - rampLength;
+    AudioSampleBuffer buffer (1, blockSize);
+
+    for (int64 position = 0; position < numSamples; position += blockSize)
+    {
+        if (shouldStop())
+            return false;
+
+        const int numThisTime = (int) jmin ((int64) blockSize, numSamples - position);
+        reader->read (&buffer, 0, numThisTime, job.startSample + position, true, false);
+        buffer.applyGain (0, numThisTime, job.gain);
+
+        // the part of the ramps which is in this block
+        if (position < rampLength)
+        {
+            const int num = (int) jmin ((int64) numThisTime, rampLength - position);
+            buffer.applyGainRamp (0, num, position / (float) rampLength, (position + num) / (float) rampLength);
+        }
+
+        if (position + numThisTime > fadeOutStart)
+        {
+            const int64 from = jmax (position, fadeOutStart);
+            const int num = (int) (position + numThisTime - from);
+
+            buffer.applyGainRamp ((int) (from - position), num,
+                                  (numSamples - from) / (float) rampLength,
+                                  (numSamples - from - num) / (float) rampLength);
+        }
+
+        if (!writer->writeFromAudioSampleBuffer (buffer, 0, numThisTime))
+            return false;
+
+        setProgress (wavProgress / 1000.0 * (position + numThisTime) / numSamples);
+    }
+
+    return true;
+}
+
+//=================================================================================================
+const bool Mp3Encoder::encodeWav (const File& processedWav, const File& mp3File)
+{
+    if (!lameEncoder.existsAsFile())
+        return false;
+
+    // the same as the quality index 6 of LAMEEncoderAudioFormat ('VBR quality 6', mono).
+    // without '--quiet', lame prints its progress to stderr, e.g. '  48/2203  ( 2%)|...'
+    StringArray args;
+    args.add (lameEncoder.getFullPathName());
+    args.add ("--vbr-new");
+    args.add ("-V");
+    args.add ("6");
+    args.add ("-m");
+    args.add ("m");
+    args.add (processedWav.getFullPathName());
+    args.add (mp3File.getFullPathName());
+
+    ChildProcess lame;
+
+    if (!lame.start (args, ChildProcess::wantStdErr))
+        return false;
+
+    char buffer[512];
+    String output;
+
+    while (!shouldStop())
+    {
+        const int numRead = lame.readProcessOutput (buffer, sizeof (buffer));
+
+        if (numRead <= 0)
+            break;
+
+        output = (output + String (buffer, (size_t) numRead)).getLastCharacters (256);
+
+        if (output.contains ("%)"))
+        {
+            const int percent = output.upToLastOccurrenceOf ("%)", false, false)
+                .fromLastOccurrenceOf ("(", false, false).trim().getIntValue();
+
+            setProgress ((wavProgress + (1000 - wavProgress) * jlimit (0, 100, percent) / 100) / 1000.0);
+        }
+    }
+
+    if (shouldStop())
+    {
+        lame.kill();
+        return false;
+    }
+
+    lame.waitForProcessToFinish (10000);
+    return lame.getExitCode() == 0 && mp3File.getSize() > 0;
+}
+
+//=================================================================================================
+void Mp3Encoder::setProgress (const double newProgress)
+{
+    const int permille = jlimit (0, 1000, roundToInt (newProgress * 1000.0));
+
+    if (progress.exchange (permille) != permille)
+        triggerAsyncUpdate();
+}
+
+//=================================================================================================
+void Mp3Encoder::handleAsyncUpdate()
+{
+    Array<Job> failed;
+
+    {
+        const ScopedLock sl (lock);
+        failed.swapWith (failedJobs);
+    }
+
+    if (listener == nullptr)
+        return;
+
+    listener->encodingProgressChanged (isEncoding() ? progress.get() / 1000.0 : 0.0);
+
+    for (int i = 0; i < failed.size(); ++i)
+        listener->mp3EncodingFailed (failed.getReference (i).mp3File, failed.getReference (i).docFile);
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    Mp3Encoder.h
+    Created: 20 Oct 2026 4:21:09am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef MP3ENCODER_H_INCLUDED
+#define MP3ENCODER_H_INCLUDED
+
+/** Encode the recorded audio to mp3 in background, so that saving a long narration won't block the editor.
+
+    The recording is read block by block, its gain and the fade-in/out are applied on each block,
+    then the processed wav is encoded by lame. The jobs will be done one by one,
+    the progress of the current one and the failed ones will be told to the listener.
+*/
+class Mp3Encoder : private Thread,
+                   private AsyncUpdater
+{
+public:
+    ~Mp3Encoder();
+    juce_DeclareSingleton (Mp3Encoder, true);
+
+    /** the arg wav file will be owned by this and be deleted after it's encoded (or cancelled).
+        arg-2 and arg-3 are the part of the recording which will be encoded.
+        the last arg is the doc which has the mark of the mp3, it'll be told if the mp3 can't be written. */
+    void encodeInBackground (const File& wavFile, const int64 startSample, const int64 numSamples,
+                             const float gain, const File& mp3File, const File& docFile);
+
+    const bool isEncoding() const;
+
+    /** the jobs which haven't been done will be dropped, and their mp3 files will be removed */
+    void cancelAll();
+
+    /** for quitting the app, the narration would be lost otherwise.
+        it shows the progress until all jobs have been done. if the user cancels it,
+        the user will be asked whether to drop them. return false if the app shouldn't quit. */
+    const bool finishAllBeforeQuit();
+
+    //=================================================================================================
+    class Listener
+    {
+    public:
+        virtual ~Listener() { }
+
+        /** they'll be called on the message thread. the progress is 0.0 when all jobs have been done.
+            a cancelled job is a failed one as well, the mark in the doc points to a missing file now. */
+        virtual void encodingProgressChanged (const double progress) = 0;
+        virtual void mp3EncodingFailed (const File& mp3File, const File& docFile) = 0;
+    };
+
+    void setListener (Listener* newListener)       { listener = newListener; }
+
+private:
+    Mp3Encoder();
+
+    struct Job
+    {
+        File wavFile, mp3File, docFile;
+        int64 startSample, numSamples;
+        float gain;
+    };
+
+    virtual void run() override;
+    void handleAsyncUpdate() override;
+
+    /** return false if it failed or has been cancelled */
+    const bool writeProcessedWav (const Job& job, const File& processedWav);
+    const bool encodeWav (const File& processedWav, const File& mp3File);
+
+    void setProgress (const double newProgress);
+    const bool shouldStop()                        { return threadShouldExit() || cancelled.get() != 0; }
+
+    //=================================================================================================
+    CriticalSection lock;
+    Array<Job> jobs;
+    Array<Job> failedJobs;
+    bool encoding;
+
+    Atomic<int> cancelled;
+    Atomic<int> progress;       // in 1/1000
+    Listener* listener;
+
+    /** the writing of the processed wav takes this part of the progress, and lame takes the rest */
+    enum { blockSize = 65536, rampSize = 4410, wavProgress = 100 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Mp3Encoder)
+};
+
+
+#endif  // MP3ENCODER_H_INCLUDED
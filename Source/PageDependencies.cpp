@@ -0,0 +1,321 @@
+/*
+  ==============================================================================
+
+    PageDependencies.cpp
+    Created: 19 Oct 2026 4:26:51pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "WdtpHeader.h"
+
+PageDependencies::PageDependencies()
+    : currentPage (-1)
+{
+}
+
+//=================================================================================================
+PageDependencies::~PageDependencies()
+{
+    clearSingletonInstance();
+}
+
+juce_ImplementSingleton (PageDependencies);
+
+//=================================================================================================
+PageDependencies::PageRecorder::PageRecorder (const ValueTree& pageTree)
+    : previousPage (PageDependencies::getInstance()->beginPage (pageTree))
+{
+}
+
+PageDependencies::PageRecorder::~PageRecorder()
+{
+    PageDependencies::getInstance()->endPage (previousPage);
+}
+
+//=================================================================================================
+const int PageDependencies::beginPage (const ValueTree& pageTree)
+{
+    const ScopedLock sl (lock);
+    const String pageKey (getKey (pageTree));
+    const int previousPage = currentPage;
+
+    if (pageIndices.contains (pageKey))
+    {
+        currentPage = pageIndices[pageKey];
+        pages[currentPage]->keys.clear();
+        pages[currentPage]->props.clear();
+    }
+    else
+    {
+        currentPage = pages.size();
+        pageIndices.set (pageKey, currentPage);
+
+        PageReads* reads = pages.add (new PageReads());
+        reads->pageKey = pageKey;
+    }
+
+    // a page always depends on its own
+    addRead (pageTree, allProps, false);
+    return previousPage;
+}
+
+//=================================================================================================
+void PageDependencies::endPage (const int previousPage)
+{
+    const ScopedLock sl (lock);
+    currentPage = previousPage;
+}
+
+//=================================================================================================
+void PageDependencies::readDoc (const ValueTree& tree, const int props)
+{
+    addRead (tree, props, false);
+}
+
+//=================================================================================================
+void PageDependencies::readScope (const ValueTree& dirTree, const int props)
+{
+    // the items inside it might be added, removed or moved
+    addRead (dirTree, props | structureProp, true);
+}
+
+//=================================================================================================
+void PageDependencies::addRead (const ValueTree& tree, const int props, const bool isScope)
+{
+    const ScopedLock sl (lock);
+
+    if (currentPage < 0 || !tree.isValid())
+        return;
+
+    PageReads* reads = pages[currentPage];
+    reads->keys.add (getKey (tree));
+    reads->props.add (isScope ? (props | scopeFlag) : props);
+}
+
+//=================================================================================================
+const bool PageDependencies::getAffectedPages (const ValueTree& changedTree, Array<ValueTree>& result)
+{
+    const ScopedLock sl (lock);
+
+    // the project's setup changed, or there isn't any graph (the site hasn't been generated)
+    if (!changedTree.isValid()
+        || changedTree.getType().toString() == "wdtpProject"
+        || pages.size() == 0)
+        return false;
+
+    // which properties have been changed since the pages read them last time
+    const String key (getKey (changedTree));
+    const StringArray snapshot (getSnapshot (changedTree));
+    int changedProps = 0;
+
+    if (snapshots.contains (key))
+    {
+        const StringArray oldSnapshot (snapshots[key]);
+
+        for (int i = 0; i < numProps; ++i)
+        {
+            if (snapshot[i] != oldSnapshot[i])
+                changedProps |= (1 << i);
+        }
+    }
+    else
+    {
+        changedProps = allProps;  // new item
+    }
+
+    snapshots.set (key, snapshot);
+
+    if (changedProps == 0)
+        return true;
+
+    // the scopes which include the changed item: itself and all its parents
+    StringArray scopeKeys;
+
+    for (ValueTree t (changedTree); t.isValid(); t = t.getParent())
+        scopeKeys.add (getKey (t));
+
+    HashMap<String, int> pageKeys;
+
+    for (int i = pages.size(); --i >= 0; )
+    {
+        const PageReads* reads = pages.getUnchecked (i);
+
+        if (reads->pageKey == key)
+            continue;
+
+        for (int j = reads->keys.size(); --j >= 0; )
+        {
+            const int props = reads->props.getUnchecked (j);
+
+            if ((props & changedProps) != 0
+                && (reads->keys[j] == key || ((props & scopeFlag) != 0 && scopeKeys.contains (reads->keys[j]))))
+            {
+                pageKeys.set (reads->pageKey, i);
+                break;
+            }
+        }
+    }
+
+    if (pageKeys.size() > 0)
+        findTrees (FileTreeContainer::projectTree, pageKeys, result);
+
+    return true;
+}
+
+//=================================================================================================
+void PageDependencies::findTrees (const ValueTree& tree,
+                                  const HashMap<String, int>& keys,
+                                  Array<ValueTree>& result) const
+{
+    if (keys.contains (getKey (tree)))
+        result.add (tree);
+
+    for (int i = tree.getNumChildren(); --i >= 0; )
+        findTrees (tree.getChild (i), keys, result);
+}
+
+//=================================================================================================
+const String PageDependencies::getKey (const ValueTree& tree)
+{
+    return DocTreeViewItem::getMdFileOrDir (tree)
+        .getRelativePathFrom (FileTreeContainer::projectFile.getParentDirectory())
+        .replace ("\\", "/");
+}
+
+//=================================================================================================
+const StringArray PageDependencies::getSnapshot (const ValueTree& tree)
+{
+    // must be the order of Property
+    StringArray snapshot;
+    snapshot.add (tree.getProperty ("title").toString());
+    snapshot.add (tree.getProperty ("description").toString());
+    snapshot.add (tree.getProperty ("createDate").toString());
+    snapshot.add (tree.getProperty ("modifyDate").toString());
+    snapshot.add (tree.getProperty ("keywords").toString());
+    snapshot.add (tree.getProperty ("thumb").toString() + "|" + tree.getProperty ("thumbName").toString());
+    snapshot.add (tree.getProperty ("hide").toString() + "|" + tree.getProperty ("isMenu").toString()
+                  + "|" + tree.getProperty ("featured").toString());
+
+    String structure (tree.getProperty ("name").toString());
+
+    for (int i = 0; i < tree.getNumChildren(); ++i)
+        structure << "/" << tree.getChild (i).getProperty ("name").toString();
+
+    snapshot.add (structure);
+    jassert (snapshot.size() == numProps);
+
+    return snapshot;
+}
+
+//=================================================================================================
+void PageDependencies::takeMissingSnapshots (const ValueTree& tree)
+{
+    const String key (getKey (tree));
+
+    if (!snapshots.contains (key))
+        snapshots.set (key, getSnapshot (tree));
+
+    for (int i = tree.getNumChildren(); --i >= 0; )
+        takeMissingSnapshots (tree.getChild (i));
+}
+
+//=================================================================================================
+void PageDependencies::loadForProject()
+{
+    const ScopedLock sl (lock);
+    clear();
+
+    const File graphFile (FileTreeContainer::projectFile.withFileExtension ("deps"));
+
+    if (!graphFile.existsAsFile())
+        return;
+
+    const ValueTree graphTree (SwingUtilities::readValueTreeFromFile (graphFile, true));
+
+    if (graphTree.getType().toString() != "pageDependencies")
+        return;
+
+    for (int i = 0; i < graphTree.getNumChildren(); ++i)
+    {
+        const ValueTree child (graphTree.getChild (i));
+
+        if (child.getType().toString() == "page")
+        {
+            PageReads* reads = pages.add (new PageReads());
+            reads->pageKey = child.getProperty ("key").toString();
+            pageIndices.set (reads->pageKey, pages.size() - 1);
+
+            for (int j = 0; j < child.getNumChildren(); ++j)
+            {
+                reads->keys.add (child.getChild (j).getProperty ("key").toString());
+                reads->props.add ((int)child.getChild (j).getProperty ("props"));
+            }
+        }
+        else if (child.getType().toString() == "snapshot")
+        {
+            StringArray snapshot;
+
+            for (int j = 0; j < numProps; ++j)
+                snapshot.add (child.getProperty ("v" + String (j)).toString());
+
+            snapshots.set (child.getProperty ("key").toString(), snapshot);
+        }
+    }
+}
+
+//=================================================================================================
+void PageDependencies::saveForProject()
+{
+    const ScopedLock sl (lock);
+
+    if (!FileTreeContainer::projectTree.isValid() || pages.size() == 0)
+        return;
+
+    takeMissingSnapshots (FileTreeContainer::projectTree);
+    ValueTree graphTree ("pageDependencies");
+
+    for (int i = 0; i < pages.size(); ++i)
+    {
+        const PageReads* reads = pages.getUnchecked (i);
+        ValueTree page ("page");
+        page.setProperty ("key", reads->pageKey, nullptr);
+
+        for (int j = 0; j < reads->keys.size(); ++j)
+        {
+            ValueTree read ("read");
+            read.setProperty ("key", reads->keys[j], nullptr);
+            read.setProperty ("props", reads->props[j], nullptr);
+            page.addChild (read, -1, nullptr);
+        }
+
+        graphTree.addChild (page, -1, nullptr);
+    }
+
+    for (HashMap<String, StringArray>::Iterator itr (snapshots); itr.next(); )
+    {
+        ValueTree snapshot ("snapshot");
+        snapshot.setProperty ("key", itr.getKey(), nullptr);
+
+        for (int i = 0; i < numProps; ++i)
+            snapshot.setProperty ("v" + String (i), itr.getValue()[i], nullptr);
+
+        graphTree.addChild (snapshot, -1, nullptr);
+    }
+
+    SwingUtilities::writeValueTreeToFile (graphTree,
+                                          FileTreeContainer::projectFile.withFileExtension ("deps"),
+                                          true);
+}
+
+//=================================================================================================
+void PageDependencies::clear()
+{
+    const ScopedLock sl (lock);
+
+    pages.clear();
+    pageIndices.clear();
+    snapshots.clear();
+    currentPage = -1;
+}
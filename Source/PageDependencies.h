@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    PageDependencies.h
+    Created: 19 Oct 2026 4:26:51pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef PAGEDEPENDENCIES_H_INCLUDED
+#define PAGEDEPENDENCIES_H_INCLUDED
+
+/** Record which properties of which docs/dirs a generated page has read, so that after
+    an item changed, only the pages which really used its changed properties will be regenerated.
+
+    A page may read a single item (e.g. the title of its previous article), or a whole dir
+    (e.g. prev/next compares the create date of all docs of the project). The latter is
+    recorded as a 'scope', any item inside it changed means the page needs regenerate.
+
+    Usage:
+    - HtmlProcessor creates a PageRecorder on the stack while it's generating a page,
+      and calls readDoc() / readScope() when it uses the data of other items.
+    - DocTreeViewItem::needCreate() calls getAffectedPages() after an item changed.
+
+    The graph will be saved beside the project file (xxx.deps).
+*/
+class PageDependencies
+{
+public:
+    ~PageDependencies();
+    juce_DeclareSingleton (PageDependencies, true);
+
+    /** the properties which could be read by other pages */
+    enum Property
+    {
+        titleProp       = 1 << 0,
+        descProp        = 1 << 1,
+        createDateProp  = 1 << 2,
+        modifyDateProp  = 1 << 3,
+        keywordsProp    = 1 << 4,
+        thumbProp       = 1 << 5,   /**< thumb and thumbName */
+        visibilityProp  = 1 << 6,   /**< hide, isMenu and featured */
+        structureProp   = 1 << 7,   /**< its name and its children */
+
+        numProps = 8,
+        allProps = (1 << numProps) - 1
+    };
+
+    /** all reads between its constructor and destructor belong to the arg page (doc or dir) */
+    struct PageRecorder
+    {
+        PageRecorder (const ValueTree& pageTree);
+        ~PageRecorder();
+
+    private:
+        const int previousPage;
+        JUCE_DECLARE_NON_COPYABLE (PageRecorder)
+    };
+
+    /** nothing will be done if there's no any page recording currently */
+    void readDoc (const ValueTree& tree, const int props);
+    void readScope (const ValueTree& dirTree, const int props);
+
+    /** compare the arg-1 with the one which the pages have seen, then add the pages which read
+        the changed properties to arg-2 (not include the arg-1 itself).
+        return false if the graph doesn't know that, in this case the caller should do it as before. */
+    const bool getAffectedPages (const ValueTree& changedTree, Array<ValueTree>& pages);
+
+    /** the graph file is 'projectName.deps' which beside the project file */
+    void loadForProject();
+    void saveForProject();
+    void clear();
+
+private:
+    PageDependencies();
+
+    /** based on the project dir, e.g. 'docs/dir/doc.md' */
+    static const String getKey (const ValueTree& tree);
+    static const StringArray getSnapshot (const ValueTree& tree);
+
+    const int beginPage (const ValueTree& pageTree);
+    void endPage (const int previousPage);
+    void addRead (const ValueTree& tree, const int props, const bool isScope);
+
+    void takeMissingSnapshots (const ValueTree& tree);
+    void findTrees (const ValueTree& tree, const HashMap<String, int>& keys, Array<ValueTree>& result) const;
+
+    //=================================================================================================
+    struct PageReads
+    {
+        String pageKey;
+        StringArray keys;
+        Array<int> props;       // (props | scopeFlag) for a scope
+    };
+
+    enum { scopeFlag = 1 << 16 };
+
+    CriticalSection lock;
+    OwnedArray<PageReads> pages;
+    HashMap<String, int> pageIndices;
+    HashMap<String, StringArray> snapshots;
+    int currentPage;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PageDependencies)
+};
+
+
+#endif  // PAGEDEPENDENCIES_H_INCLUDED
@@ -17,12 +17,13 @@ extern File lameEncoder;
 const float transValue = 0.65f;
 
 //==============================================================================
-RecordComp::RecordComp (const File& docFile) :
+RecordComp::RecordComp (const File& docFile_) :
     currentSeconds (0),
     totalSeconds (0),
     baseTime (0),
     needSaveToMediaDir (false),
-    mediaDir (docFile.getSiblingFile ("media")),
+    docFile (docFile_),
+    mediaDir (docFile_.getSiblingFile ("media")),
     player (new AudioDataPlayer()), 
     startSample (0),
     samplesNum(0),
@@ -337,30 +338,26 @@ void RecordComp::writeMp3AudioToMediaDir (const String& fileName)
         return;
     }
 
+    // reserve the name, the mp3 will be written to it in background
     File audioFile (mediaDir.getChildFile (fileName).getNonexistentSibling (false));
     audioFile.create();    
 
-    LAMEEncoderAudioFormat mp3Format (lameEncoder);
-    FileOutputStream* outputStream (audioFile.createOutputStream());
-    ScopedPointer<AudioFormatWriter> writer = mp3Format.createWriterFor (outputStream,
-                                              player->getReaderOfCuurentHold()->sampleRate, 1, 16, StringPairArray(), 6);
-
-    jassert (writer != nullptr);
-
-    // gain ramp process
-    AudioFormatReader* reader = player->getReaderOfCuurentHold();
-    AudioSampleBuffer buffer (reader->numChannels, (int)reader->lengthInSamples);
-    reader->read (&buffer, 0, (int)reader->lengthInSamples, 0, true, true);
+    // the readers are using the recording, release them before it's handed over
+    recordThumbnail->setReader (nullptr);
+    player->setAudioSource (nullptr);
 
-    buffer.applyGain (0, (int)reader->lengthInSamples, volGain);
-    buffer.applyGainRamp (0, 4410, 0.f, 1.f);
-    buffer.applyGainRamp ((int)reader->lengthInSamples - 4410, 4410, 1.f, 0.f);
+    File wavFile (File::createTempFile ("wav"));
 
-    // write to mp3
-    if (writer->writeFromAudioSampleBuffer (buffer, 0, (int)reader->lengthInSamples))
-        sendActionMessage (fileName);
-    else
+    if (!recorder->saveToFile (wavFile))
+    {
+        audioFile.deleteFile();
         SHOW_MESSAGE (TRANS ("Can't save this audio."));
+        return;
+    }
+
+    // gain, fade in/out and encoding will be done by Mp3Encoder
+    Mp3Encoder::getInstance()->encodeInBackground (wavFile, startSample, samplesNum, volGain, audioFile, docFile);
+    sendActionMessage (audioFile.getFileName());
 }
 
 //=================================================================================================
@@ -499,5 +496,14 @@ void RecordComp::stopRecord()
     buttons[delBt]->setEnabled (true);
     buttons[doneBt]->setEnabled (true);
     volSlider->setEnabled (true);
+
+    // the disk couldn't keep up with the recording, a part of it has been lost
+    const int droppedSamples = recorder->getNumDroppedSamples();
+
+    if (droppedSamples > 0)
+        SHOW_MESSAGE (TRANS ("The disk was too slow while recording, SECS seconds of audio were lost. "
+                             "They were cut out rather than replaced by silence, "
+                             "so the recording is shorter and the audio after them comes earlier.")
+                      .replace ("SECS", SwingUtilities::doubleToString (droppedSamples / formatReader->sampleRate)));
 }
 
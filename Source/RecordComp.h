@@ -63,7 +63,7 @@ private:
     double currentSeconds, totalSeconds;
     uint32 baseTime;
     bool needSaveToMediaDir;
-    const File mediaDir;
+    const File docFile, mediaDir;
 
     AudioRecorder* recorder;
     AudioDataPlayer* player;
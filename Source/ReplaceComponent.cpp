@@ -188,6 +188,7 @@ void ReplaceComponent::replaceContent (ValueTree treeNeedReplaced,
             }
 
             docFile.replaceWithText (content);
+            MediaIndex::getInstance()->updateDoc (docFile);
         }        
     }
     else
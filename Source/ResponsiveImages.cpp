@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+    ResponsiveImages.cpp
+    Created: 19 Oct 2026 11:48:05pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "WdtpHeader.h"
+
+/** the quality of the jpg copies. it's a part of their names, change it will make new copies */
+static const int copyQuality = 82;
+
+ResponsiveImages::ResponsiveImages()
+{
+}
+
+//=================================================================================================
+ResponsiveImages::~ResponsiveImages()
+{
+    clearSingletonInstance();
+}
+
+juce_ImplementSingleton (ResponsiveImages);
+
+//=================================================================================================
+const String ResponsiveImages::process (const File& mdFile, const File& htmlFile, const String& htmlStr)
+{
+    const Profiler::ScopedTimer timer ("responsiveImages");
+    const File docMediaDir (mdFile.getSiblingFile ("media"));
+
+    if (!docMediaDir.isDirectory() || !htmlStr.contains ("<img src=\"media/"))
+        return htmlStr;
+
+    // 1. find the <img>s which have a width, and the copies they need
+    struct ImgTag
+    {
+        int start, end, showWidth;
+        String name;
+        SourceInfo info;
+    };
+
+    Array<ImgTag> tags;
+    Array<File> jobSources, jobTargets;
+    Array<int> jobWidths;
+
+    for (int start = htmlStr.indexOf ("<img src=\"media/"); start != -1; )
+    {
+        const int end = htmlStr.indexOf (start, "/>");
+
+        if (end == -1)
+            break;
+
+        ImgTag tag;
+        tag.start = start;
+        tag.end = end;
+        tag.name = htmlStr.substring (start + 10, end).upToFirstOccurrenceOf ("\"", false, false);
+        tag.showWidth = htmlStr.substring (start, end).fromFirstOccurrenceOf (" width=\"", false, false).getIntValue();
+
+        const String fileName (tag.name.fromFirstOccurrenceOf ("media/", false, false));
+        const File imageFile (docMediaDir.getChildFile (fileName));
+
+        if (tag.showWidth > 0
+            && !fileName.containsChar ('/')
+            && imageFile.hasFileExtension ("jpg;jpeg;png")
+            && getSourceInfo (imageFile, tag.info))
+        {
+            // 1x and 2x (for hi-dpi screens), only when they're smaller than the original
+            for (int width = tag.showWidth; width <= tag.showWidth * 2 && width < tag.info.width; width += tag.showWidth)
+            {
+                const File cacheFile (getCacheFile (tag.info, imageFile, width));
+
+                if (!cacheFile.existsAsFile() && !jobTargets.contains (cacheFile))
+                {
+                    jobSources.add (imageFile);
+                    jobTargets.add (cacheFile);
+                    jobWidths.add (width);
+                }
+            }
+
+            tags.add (tag);
+        }
+
+        start = htmlStr.indexOf (end, "<img src=\"media/");
+    }
+
+    // 2. create the copies which aren't in the cache
+    if (jobTargets.size() > 0)
+    {
+        struct CopyWriter : public WorkerPool::Task
+        {
+            CopyWriter (const Array<File>& sources_, const Array<File>& targets_, const Array<int>& widths_)
+                : sources (sources_), targets (targets_), widths (widths_)
+            {
+            }
+
+            void runItem (const int index) override
+            {
+                const File& target (targets.getReference (index));
+
+                if (target.getParentDirectory().createDirectory().wasOk())
+                    ImageProcessor::writeResized (sources.getReference (index), target, 
+                                                  widths[index], copyQuality / 100.0f);
+            }
+
+            const Array<File>& sources;
+            const Array<File>& targets;
+            const Array<int>& widths;
+        };
+
+        CopyWriter copyWriter (jobSources, jobTargets, jobWidths);
+        WorkerPool::getInstance()->runAll (copyWriter, jobTargets.size());
+    }
+
+    // 3. copy them to the site and add the attributes
+    const File htmlMediaDir (htmlFile.getSiblingFile ("media"));
+    String result;
+    int copiedTo = 0;
+
+    for (int i = 0; i < tags.size(); ++i)
+    {
+        const ImgTag& tag (tags.getReference (i));
+        const File imageFile (docMediaDir.getChildFile (tag.name.fromFirstOccurrenceOf ("media/", false, false)));
+        const String widthStr (String (tag.showWidth));
+        String srcset;
+
+        for (int width = tag.showWidth; width <= tag.showWidth * 2 && width < tag.info.width; width += tag.showWidth)
+        {
+            const File cacheFile (getCacheFile (tag.info, imageFile, width));
+            const String copyName (getCopyName (tag.name, width));
+            const File siteFile (htmlMediaDir.getChildFile (copyName.fromFirstOccurrenceOf ("media/", false, false)));
+
+            if (!cacheFile.existsAsFile())
+                continue;
+
+            if (siteFile.getSize() != cacheFile.getSize())
+            {
+                siteFile.getParentDirectory().createDirectory();
+                cacheFile.copyFileTo (siteFile);
+            }
+
+            srcset << copyName << " " << width << "w, ";
+        }
+
+        String attributes (" width=\"" + widthStr + "\" height=\""
+                           + String (roundToInt (tag.info.height * tag.showWidth / (double) tag.info.width))
+                           + "\" style=\"height:auto;\"");
+
+        if (srcset.isNotEmpty())
+            attributes << " srcset=\"" << srcset << tag.name << " " << tag.info.width << "w\""
+                       << " sizes=\"(max-width: " << widthStr << "px) 100vw, " << widthStr << "px\"";
+
+        result << htmlStr.substring (copiedTo, tag.start)
+               << htmlStr.substring (tag.start, tag.end).replace (" width=\"" + widthStr + "\"", attributes);
+
+        copiedTo = tag.end;
+    }
+
+    return result + htmlStr.substring (copiedTo);
+}
+
+//=================================================================================================
+const bool ResponsiveImages::getSourceInfo (const File& imageFile, SourceInfo& info)
+{
+    const String key (imageFile.getRelativePathFrom (FileTreeContainer::projectFile.getParentDirectory())
+                      .replace ("\\", "/"));
+    const String stamp (getStamp (imageFile));
+
+    {
+        const ScopedLock sl (lock);
+
+        if (sources.contains (key) && sources[key].stamp == stamp)
+        {
+            info = sources[key];
+            return info.width > 0;
+        }
+    }
+
+    // it's new or has been changed
+    const Image image (ImageProcessor::loadImage (imageFile));
+
+    info.stamp = stamp;
+    info.md5 = MD5 (imageFile).toHexString();
+    info.width = image.getWidth();
+    info.height = image.getHeight();
+
+    const ScopedLock sl (lock);
+    sources.set (key, info);
+
+    return info.width > 0;
+}
+
+//=================================================================================================
+const String ResponsiveImages::getStamp (const File& imageFile)
+{
+    return String (imageFile.getSize()) + "|" + String (imageFile.getLastModificationTime().toMilliseconds());
+}
+
+//=================================================================================================
+const File ResponsiveImages::getCacheFile (const SourceInfo& info, const File& imageFile, const int width)
+{
+    return FileTreeContainer::projectFile.getSiblingFile ("cache").getChildFile ("images")
+        .getChildFile (info.md5 + "-w" + String (width) + "-q" + String (copyQuality)
+                       + imageFile.getFileExtension().toLowerCase());
+}
+
+//=================================================================================================
+const String ResponsiveImages::getCopyName (const String& imageName, const int width)
+{
+    return imageName.upToLastOccurrenceOf (".", false, false) + "-w" + String (width)
+        + imageName.fromLastOccurrenceOf (".", true, false);
+}
+
+//=================================================================================================
+void ResponsiveImages::loadForProject()
+{
+    const ScopedLock sl (lock);
+    clear();
+
+    const File indexFile (FileTreeContainer::projectFile.withFileExtension ("images"));
+
+    if (!indexFile.existsAsFile())
+        return;
+
+    const ValueTree indexTree (SwingUtilities::readValueTreeFromFile (indexFile, true));
+
+    if (indexTree.getType().toString() != "responsiveImages")
+        return;
+
+    for (int i = 0; i < indexTree.getNumChildren(); ++i)
+    {
+        const ValueTree image (indexTree.getChild (i));
+
+        SourceInfo info;
+        info.stamp = image.getProperty ("stamp").toString();
+        info.md5 = image.getProperty ("md5").toString();
+        info.width = image.getProperty ("width");
+        info.height = image.getProperty ("height");
+
+        sources.set (image.getProperty ("key").toString(), info);
+    }
+}
+
+//=================================================================================================
+void ResponsiveImages::saveForProject()
+{
+    const ScopedLock sl (lock);
+
+    if (!FileTreeContainer::projectTree.isValid() || sources.size() == 0)
+        return;
+
+    ValueTree indexTree ("responsiveImages");
+
+    for (HashMap<String, SourceInfo>::Iterator itr (sources); itr.next(); )
+    {
+        ValueTree image ("image");
+        image.setProperty ("key", itr.getKey(), nullptr);
+        image.setProperty ("stamp", itr.getValue().stamp, nullptr);
+        image.setProperty ("md5", itr.getValue().md5, nullptr);
+        image.setProperty ("width", itr.getValue().width, nullptr);
+        image.setProperty ("height", itr.getValue().height, nullptr);
+
+        indexTree.addChild (image, -1, nullptr);
+    }
+
+    SwingUtilities::writeValueTreeToFile (indexTree,
+                                          FileTreeContainer::projectFile.withFileExtension ("images"),
+                                          true);
+}
+
+//=================================================================================================
+void ResponsiveImages::clear()
+{
+    const ScopedLock sl (lock);
+    sources.clear();
+}
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    ResponsiveImages.h
+    Created: 19 Oct 2026 11:48:05pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef RESPONSIVEIMAGES_H_INCLUDED
+#define RESPONSIVEIMAGES_H_INCLUDED
+
+/** Smaller copies of the images which are showed with a width, e.g. ![](media/xx.jpg = 500),
+    so that the readers needn't download the full-size original.
+
+    For such an <img>, the copies of 1x and 2x of its width (only when they're smaller
+    than the original) will be created and the srcset, sizes and height will be added.
+
+    The copies are kept in the project's 'cache/images' dir, their names are based on
+    the md5 of the original's content, so an image will only be processed again
+    after it's changed. The size, modified time, md5 and dimensions of the originals
+    are saved beside the project file (xxx.images).
+*/
+class ResponsiveImages
+{
+public:
+    ~ResponsiveImages();
+    juce_DeclareSingleton (ResponsiveImages, true);
+
+    /** process the <img>s of arg-3 whose images are in the media dir of arg-1,
+        create the copies which are not in the cache (in parallel), copy them
+        to the media dir of arg-2, then return the processed html. */
+    const String process (const File& mdFile, const File& htmlFile, const String& htmlStr);
+
+    void loadForProject();
+    void saveForProject();
+    void clear();
+
+private:
+    ResponsiveImages();
+
+    /** what we know about an original image */
+    struct SourceInfo
+    {
+        SourceInfo() : width (0), height (0) { }
+
+        String stamp, md5;
+        int width, height;
+    };
+
+    /** read it from the index, or the image file if it has been changed */
+    const bool getSourceInfo (const File& imageFile, SourceInfo& info);
+
+    static const String getStamp (const File& imageFile);
+    static const File getCacheFile (const SourceInfo& info, const File& imageFile, const int width);
+
+    /** e.g. 'media/xx.jpg' -> 'media/xx-w500.jpg' */
+    static const String getCopyName (const String& imageName, const int width);
+
+    //=================================================================================================
+    CriticalSection lock;
+    HashMap<String, SourceInfo> sources;    // key: relative path from the project dir
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponsiveImages)
+};
+
+
+#endif  // RESPONSIVEIMAGES_H_INCLUDED
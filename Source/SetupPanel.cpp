@@ -51,6 +51,8 @@ void SetupPanel::showProjectProperties (const ValueTree& pTree)
     values[contact]->setValue (pTree.getProperty ("contact"));
     values[modifyDate]->setValue (pTree.getProperty ("modifyDate"));
     values[resources]->setValue (pTree.getProperty ("resources"));
+    values[compressHtml]->setValue (pTree.getProperty ("compressHtml"));
+    values[profileGeneration]->setValue (pTree.getProperty ("profileGeneration"));
 
     Array<PropertyComponent*> projectProperties;
     projectProperties.add (new TextPropertyComponent (*values[itsTitle], TRANS ("Title: "), 0, false));
@@ -106,6 +108,10 @@ void SetupPanel::showProjectProperties (const ValueTree& pTree)
     projectProperties.add (new TextPropertyComponent (*values[copyrightInfo], TRANS ("Copyright: "), 0, true));
     projectProperties.add (new TextPropertyComponent (*values[modifyDate], TRANS ("Last Modified: "), 0, false));
     projectProperties.add (new TextPropertyComponent (*values[resources], TRANS ("Ex-resources: "), 0, true));
+    projectProperties.add (new BooleanPropertyComponent (*values[compressHtml], TRANS ("Minify Html: "), 
+                                                         TRANS ("Minify and write .gz")));
+    projectProperties.add (new BooleanPropertyComponent (*values[profileGeneration], TRANS ("Profile Generation: "), 
+                                                         TRANS ("Write report and trace")));
 
     for (auto p : projectProperties)  
         p->setPreferredHeight (28);
@@ -140,6 +146,8 @@ void SetupPanel::showDirProperties (const ValueTree& dTree)
     values[jsCode]->setValue (currentTree.getProperty ("js"));
     values[createDate]->setValue (currentTree.getProperty ("createDate"));
     values[modifyDate]->setValue (currentTree.getProperty ("modifyDate"));
+    values[pageSize]->setValue (currentTree.getProperty ("pageSize", (int)HtmlProcessor::defaultPageSize));
+    values[listOrder]->setValue (currentTree.getProperty ("listOrder", (int)HtmlProcessor::newestFirst));
 
     Array<PropertyComponent*> dirProperties;
     dirProperties.add (new TextPropertyComponent (*values[itsName], TRANS ("Name: "), 0, false));
@@ -172,6 +180,21 @@ void SetupPanel::showDirProperties (const ValueTree& dTree)
     dirProperties.add (new TextPropertyComponent (*values[createDate], TRANS ("Create Date: "), 0, false));
     dirProperties.add (new TextPropertyComponent (*values[modifyDate], TRANS ("Last Modified: "), 0, false));
 
+    // blog-list of its index
+    dirProperties.add (new TextPropertyComponent (*values[pageSize], TRANS ("Docs Per Page: "), 3, false));
+
+    StringArray listOrderSa;
+    listOrderSa.add (TRANS ("Newest First"));
+    listOrderSa.add (TRANS ("Oldest First"));
+    listOrderSa.add (TRANS ("Latest Modified First"));
+
+    Array<var> listOrderVar;
+    listOrderVar.add ((int)HtmlProcessor::newestFirst);
+    listOrderVar.add ((int)HtmlProcessor::oldestFirst);
+    listOrderVar.add ((int)HtmlProcessor::latestModifiedFirst);
+
+    dirProperties.add (new ChoicePropertyComponent (*values[listOrder], TRANS ("List Order: "), listOrderSa, listOrderVar));
+
     for (auto p : dirProperties)
         p->setPreferredHeight (28);
 
@@ -516,11 +539,24 @@ void SetupPanel::valueChanged (Value& value)
     else if (value.refersToSameSourceAs (*values[archiveMode]))
         currentTree.setProperty ("archive", values[archiveMode]->getValue(), nullptr);
 
+    else if (value.refersToSameSourceAs (*values[pageSize]))
+        currentTree.setProperty ("pageSize", jlimit (1, 999, values[pageSize]->getValue().toString().getIntValue()), nullptr);
+
+    else if (value.refersToSameSourceAs (*values[listOrder]))
+        currentTree.setProperty ("listOrder", values[listOrder]->getValue(), nullptr);
+
+    else if (value.refersToSameSourceAs (*values[compressHtml]))
+        currentTree.setProperty ("compressHtml", values[compressHtml]->getValue(), nullptr);
+
+    else if (value.refersToSameSourceAs (*values[profileGeneration]))
+        currentTree.setProperty ("profileGeneration", values[profileGeneration]->getValue(), nullptr);
+
     values[modifyDate]->setValue (SwingUtilities::getTimeStringWithSeparator (SwingUtilities::getCurrentTimeString(), true));
 
     if (!value.refersToSameSourceAs (*values[resources])
         && !value.refersToSameSourceAs (*values[reviewDate])
-        && !value.refersToSameSourceAs (*values[archiveMode]))
+        && !value.refersToSameSourceAs (*values[archiveMode])
+        && !value.refersToSameSourceAs (*values[profileGeneration]))
     {
         DocTreeViewItem::needCreate (currentTree);
     }
@@ -52,6 +52,7 @@ private:
         contact, ad, isMenu, createDate, modifyDate,
         showKeys, wordCount, thumb, thumbName, 
         abbrev, reviewDate, featured, hideMode, archiveMode,
+        pageSize, listOrder, compressHtml, profileGeneration,
 
         totalValues
     };
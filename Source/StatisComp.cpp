@@ -104,7 +104,7 @@ StatisComp::StatisComp (FileTreeContainer* fileTree, DocTreeViewItem* item, cons
 
     //[/UserPreSize]
 
-    setSize (385, 210);
+    setSize (385, 250);
 
 
     //[Constructor] You can add your own custom stuff here..
@@ -146,11 +146,11 @@ void StatisComp::resized()
     //[/UserPreResize]
 
     titleLabel->setBounds (120, 5, 150, 24);
-    infoEditor->setBounds (30, 32, getWidth() - 60, 70);
-    keywordLabel->setBounds (5, 110, 110, 25);
-    keywordEditor->setBounds (120, 110, getWidth() - 150, 26);
-    analyseEditor->setBounds (15, 144, getWidth() - 30, 26);
-    analyseBt->setBounds (140, 178, 100, 24);
+    infoEditor->setBounds (30, 32, getWidth() - 60, 110);
+    keywordLabel->setBounds (5, 150, 110, 25);
+    keywordEditor->setBounds (120, 150, getWidth() - 150, 26);
+    analyseEditor->setBounds (15, 184, getWidth() - 30, 26);
+    analyseBt->setBounds (140, 218, 100, 24);
     //[UserResized] Add your own custom resize handling here..
     //[/UserResized]
 }
@@ -310,7 +310,7 @@ BEGIN_JUCER_METADATA
                  constructorParams="FileTreeContainer* fileTree, DocTreeViewItem* item, const bool isDoc_, const String&amp; statisStr"
                  variableInitialisers="treeContainer (fileTree), dirItem (item), isDoc (isDoc_)"
                  snapPixels="8" snapActive="1" snapShown="1" overlayOpacity="0.330"
-                 fixedSize="1" initialWidth="385" initialHeight="210">
+                 fixedSize="1" initialWidth="385" initialHeight="250">
   <BACKGROUND backgroundColour="ffdcdbdb"/>
   <LABEL name="" id="3e0696e99e0e768d" memberName="titleLabel" virtualName=""
          explicitFocusOrder="0" pos="120 5 150 24" edTextCol="ff000000"
@@ -318,24 +318,24 @@ BEGIN_JUCER_METADATA
          editableDoubleClick="0" focusDiscardsChanges="0" fontname="Default font"
          fontsize="18" bold="1" italic="0" justification="36"/>
   <TEXTEDITOR name="" id="2be33f20c3c2a579" memberName="infoEditor" virtualName=""
-              explicitFocusOrder="0" pos="30 32 60M 70" bkgcol="ffffff" initialText=""
+              explicitFocusOrder="0" pos="30 32 60M 110" bkgcol="ffffff" initialText=""
               multiline="1" retKeyStartsLine="1" readonly="1" scrollbars="0"
               caret="0" popupmenu="1"/>
   <LABEL name="new label" id="518978ad17a9f68b" memberName="keywordLabel"
-         virtualName="" explicitFocusOrder="0" pos="5 110 110 25" edTextCol="ff000000"
+         virtualName="" explicitFocusOrder="0" pos="5 150 110 25" edTextCol="ff000000"
          edBkgCol="0" labelText="Feature Word: " editableSingleClick="0"
          editableDoubleClick="0" focusDiscardsChanges="0" fontname="Default font"
          fontsize="17" bold="0" italic="0" justification="36"/>
   <TEXTEDITOR name="new text editor" id="b495c65e0a391d5e" memberName="keywordEditor"
-              virtualName="" explicitFocusOrder="1" pos="120 110 150M 26" initialText=""
+              virtualName="" explicitFocusOrder="1" pos="120 150 150M 26" initialText=""
               multiline="0" retKeyStartsLine="0" readonly="0" scrollbars="0"
               caret="1" popupmenu="1"/>
   <TEXTEDITOR name="new text editor" id="90b4a9a5ac61a342" memberName="analyseEditor"
-              virtualName="" explicitFocusOrder="0" pos="15 144 30M 26" bkgcol="ffffff"
+              virtualName="" explicitFocusOrder="0" pos="15 184 30M 26" bkgcol="ffffff"
               initialText="" multiline="0" retKeyStartsLine="0" readonly="1"
               scrollbars="0" caret="0" popupmenu="1"/>
   <TEXTBUTTON name="" id="5b948568fee478a0" memberName="analyseBt" virtualName=""
-              explicitFocusOrder="2" pos="140 178 100 24" buttonText="Analyse"
+              explicitFocusOrder="2" pos="140 218 100 24" buttonText="Analyse"
               connectedEdges="0" needsCallback="1" radioGroupId="0"/>
 </JUCER_COMPONENT>
 
@@ -17,12 +17,13 @@ extern AudioFormatManager* formatManager;
 //=================================================================================================
 AudioRecorder::AudioRecorder (AudioDeviceManager& dm,
                               AudioThumbnail& thumbnailToUpdate) : 
+    Thread ("Audio Recorder Thread"),
     deviceManager(dm),
-    backgroundThread ("Audio Recorder Thread"),
     thumbnail (thumbnailToUpdate),
     sampleRate (0.00),
     nextSampleNum (0),
-    activeWriter (nullptr)
+    fifo (fifoSize),
+    fifoBuffer (1, fifoSize)
 {
 #if (JUCE_ANDROID || JUCE_IOS)
     tempFile = File::getSpecialLocation (File::userDocumentsDirectory)
@@ -31,7 +32,6 @@ AudioRecorder::AudioRecorder (AudioDeviceManager& dm,
     tempFile = File::createTempFile ("wav");
 #endif
     
-    backgroundThread.startThread();
     deviceManager.addAudioCallback (this);
 }
 
@@ -61,52 +61,109 @@ void AudioRecorder::startRecording()
         return;
 
     WavAudioFormat wavFormat;    
-    AudioFormatWriter* writer = wavFormat.createWriterFor (outputStream, sampleRate, 1, 16, StringPairArray(), 0);
+    writer = wavFormat.createWriterFor (outputStream, sampleRate, 1, 16, StringPairArray(), 0);
 
     if (writer == nullptr)
         return;
 
     outputStream.release(); 
-    threadedWriter = new AudioFormatWriter::ThreadedWriter (writer, backgroundThread, 32768);
 
     // AudioThumbnail对象重置所要绘制的音频数据
     thumbnail.reset (writer->getNumChannels(), writer->getSampleRate());
     nextSampleNum = 0;
 
-    const ScopedLock sl (writerLock);
-    activeWriter = threadedWriter;
+    fifo.reset();
+    droppedSamples = 0;
+
+    startThread();
+    recording = 1;
 }
 
 //=================================================================================================
 void AudioRecorder::stop()
 {
+    recording = 0;
+
+    // 后台线程写完环形缓冲中剩余的数据后退出，而后关闭写入器（写入wav文件头）
+    stopThread (5000);
+    writer = nullptr;
+}
+
+//=================================================================================================
+void AudioRecorder::run()
+{
+    while (!threadShouldExit())
     {
-        const ScopedLock sl (writerLock);
-        activeWriter = nullptr;
+        writeFromFifo();
+        wait (20);
     }
 
-    threadedWriter = nullptr;
+    writeFromFifo();
+}
+
+//=================================================================================================
+void AudioRecorder::writeFromFifo()
+{
+    const int numReady = fifo.getNumReady();
+
+    if (numReady <= 0 || writer == nullptr)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (numReady, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        writeBlock (start1, size1);
+
+    if (size2 > 0)
+        writeBlock (start2, size2);
+
+    fifo.finishedRead (size1 + size2);
+}
+
+//=================================================================================================
+void AudioRecorder::writeBlock (const int startInFifo, const int numSamples)
+{
+    float* data = fifoBuffer.getWritePointer (0, startInFifo);
+    writer->writeFromFloatArrays (&data, 1, numSamples);
+
+    // 每次写入时才更新缩略图，而非每次声卡回调时
+    const AudioSampleBuffer buffer (&data, 1, numSamples);
+    thumbnail.addBlock (nextSampleNum, buffer, 0, numSamples);
+    nextSampleNum += numSamples;
 }
 
 //=================================================================================================
 void AudioRecorder::audioDeviceIOCallback (const float** inputChannelData, 
-                                           int /*numInputChannels*/, 
+                                           int numInputChannels, 
                                            float** outputChannelData, 
                                            int numOutputChannels, 
                                            int numSamples)
 {
-    const ScopedLock sl (writerLock);
-
-    // 录音数据写入（追加到）磁盘文件
-    if (activeWriter != nullptr)
+    // 录音数据写入环形缓冲，由后台线程写入磁盘文件。此处不可加锁、分配内存或等待
+    if (recording.get() != 0)
     {
-        activeWriter->write (inputChannelData, numSamples);
-
-        // 创建音频缓冲，引用声卡输入端口进来的音频数据
-        const AudioSampleBuffer buffer (const_cast<float**> (inputChannelData), thumbnail.getNumChannels(), numSamples);
-
-        thumbnail.addBlock (nextSampleNum, buffer, 0, numSamples);
-        nextSampleNum += numSamples;
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+        const float* input = (numInputChannels > 0) ? inputChannelData[0] : nullptr;
+
+        if (input != nullptr)
+        {
+            if (size1 > 0)  FloatVectorOperations::copy (fifoBuffer.getWritePointer (0, start1), input, size1);
+            if (size2 > 0)  FloatVectorOperations::copy (fifoBuffer.getWritePointer (0, start2), input + size1, size2);
+        }
+        else
+        {
+            if (size1 > 0)  FloatVectorOperations::clear (fifoBuffer.getWritePointer (0, start1), size1);
+            if (size2 > 0)  FloatVectorOperations::clear (fifoBuffer.getWritePointer (0, start2), size2);
+        }
+
+        fifo.finishedWrite (size1 + size2);
+
+        // 缓冲已满（磁盘写入过慢），丢弃放不下的数据
+        if (size1 + size2 < numSamples)
+            droppedSamples += numSamples - (size1 + size2);
     }
 
     for (int i = 0; i < numOutputChannels; ++i)
@@ -17,6 +17,10 @@
     每次录音时，内部将录音数据保存到一个临时文件中，该文件位于系统临时目录下(C:/Users/mit2000/AppData/Local/Temp，
     文件名以temp开头，扩展名为：“*.wav”)，销毁本类时一并删除该临时文件。可返回该临时文件供播放器所用，以便试听本次录音结果。
 
+    声卡回调（实时线程）中不加锁、不分配内存，只将输入数据写入无锁的单生产者单消费者环形缓冲(AbstractFifo)，
+    由本类的后台线程每隔20毫秒取出缓冲中的数据写入磁盘文件，同时更新 AudioThumbnail。
+    磁盘暂时卡顿时，环形缓冲可容纳约12秒（44.1k采样率）的录音数据。缓冲写满时丢弃的采样数可调用 getNumDroppedSamples() 获取。
+
     用法：
     - 创建对象，构造参数应为全局性 AudioDeviceManager。
     - 调用 startRecording() 开始录音。
@@ -24,8 +28,10 @@
     - 调用 getTempFile() 可返回本次录音的临时文件。
     - 调用 saveToFile() 可将本次录音保存为指定的磁盘文件(mp3)。
     - 判断当前是否处于录音状态，可调用 isRecording() 函数。
+    - 停止录音后，调用 getNumDroppedSamples() 可知本次录音是否有丢失的数据。
 */
-class AudioRecorder : public AudioIODeviceCallback
+class AudioRecorder : public AudioIODeviceCallback,
+                      private Thread
 {
 public:
     /** 构造1参：本类所需的全局性音频设备管理器。2参：录音时，本类实时更新该对象所要绘制的音频数据。 */
@@ -47,7 +53,10 @@ public:
     void stop();
 
     /** 如果当前正在录音，则返回true。 */
-    bool isRecording() const                                { return activeWriter != nullptr; }
+    bool isRecording() const                                { return recording.get() != 0; }
+
+    /** 返回本次录音中，因环形缓冲已满（磁盘写入过慢）而丢弃的采样数。 */
+    const int getNumDroppedSamples() const                  { return droppedSamples.get(); }
 
     //=================================================================================================
     /** 返回尚未另存的临时录音文件。此函数可供播放器使用，以便试听本次录音。 */
@@ -73,22 +82,33 @@ public:
                                 int numSamples) override;
 
 private:
+    //=================================================================================================
+    /** 后台线程：每隔20毫秒将环形缓冲中的数据写入磁盘文件。停止后，写完缓冲中剩余的数据再退出。 */
+    void run() override;
+
+    /** 取出环形缓冲中已有的全部数据，写入磁盘文件并更新 AudioThumbnail。仅在后台线程中调用。 */
+    void writeFromFifo();
+    void writeBlock (const int startInFifo, const int numSamples);
+
     //=================================================================================================
     AudioDeviceManager& deviceManager;      /**< 外部传来的设备管理器，用于回调本类。 */
-    TimeSliceThread backgroundThread;       /**< 用于将音频数据写入磁盘文件的时间片线程。 */
-    AudioThumbnail& thumbnail;              /**< 本类录音时，实时更新该对象所要绘制的音频波形数据 */
+    AudioThumbnail& thumbnail;              /**< 本类录音时，更新该对象所要绘制的音频波形数据 */
 
     File tempFile;                          /**< 临时保存录音数据的磁盘临时文件。 */
     double sampleRate;                      /**< 采样率 */
-    int64 nextSampleNum;                    /**< 音频设备每次回调时，AudioThumbnail从该位置读取采样 */
+    int64 nextSampleNum;                    /**< 后台线程每次写入时，AudioThumbnail从该位置添加采样 */
+
+    /** 环形缓冲的容量，44.1k采样率时约为12秒。构造时一次分配，此后不再改变，以免回调中访问已释放的内存。 */
+    enum { fifoSize = 1 << 19 };
 
-    CriticalSection writerLock;             /**< 进入临界区的锁。*/
+    AbstractFifo fifo;                      /**< 管理环形缓冲的读写位置，单生产者（声卡回调）单消费者（后台线程）。 */
+    AudioSampleBuffer fifoBuffer;           /**< 环形缓冲的数据（单声道）。 */
 
-    /** 基于FIFO来缓冲输入数据的音频格式写入器。*/
-    ScopedPointer<AudioFormatWriter::ThreadedWriter> threadedWriter;    
+    Atomic<int> recording;                  /**< 声卡回调据此判断是否写入环形缓冲。 */
+    Atomic<int> droppedSamples;             /**< 环形缓冲已满时丢弃的采样数。 */
 
-    /** 执行写入磁盘文件的写入器。*/
-    AudioFormatWriter::ThreadedWriter* volatile activeWriter; 
+    /** 执行写入磁盘文件的写入器，仅由后台线程使用。*/
+    ScopedPointer<AudioFormatWriter> writer;
 };
 
 //=================================================================================================
@@ -0,0 +1,499 @@
+/*
+  ==============================================================================
+
+    CodeHighlighter.cpp
+    Created: 20 Oct 2026 3:12:40am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+#include "Profiler.h"
+#include "CodeHighlighter.h"
+
+/** the cache will be cleared when it has more blocks than this */
+enum { maxCachedBlocks = 2048 };
+
+//=================================================================================================
+const String CodeHighlighter::process (const String& html)
+{
+    static const char* const openTag = "<pre><code class=\"";
+    static const char* const closeTag = "</code></pre>";
+
+    const char* p = html.toRawUTF8();
+    const char* const end = p + html.getNumBytesAsUTF8();
+
+    if (find (p, end, openTag) == nullptr)
+        return html;
+
+    const Profiler::ScopedTimer timer ("highlightCode");
+    MemoryOutputStream out ((size_t) (end - p) * 2);
+
+    for (;;)
+    {
+        const char* const blockStart = find (p, end, openTag);
+        const char* const classStart = (blockStart != nullptr) ? blockStart + strlen (openTag) : nullptr;
+        const char* const classEnd = (classStart != nullptr) ? find (classStart, end, "\">") : nullptr;
+        const char* const codeEnd = (classEnd != nullptr) ? find (classEnd + 2, end, closeTag) : nullptr;
+
+        if (codeEnd == nullptr)
+        {
+            out.write (p, (size_t) (end - p));
+            break;
+        }
+
+        out.write (p, (size_t) (blockStart - p));
+        p = codeEnd + strlen (closeTag);
+
+        const String className (String::fromUTF8 (classStart, (int) (classEnd - classStart)).trim());
+        const String code (String::fromUTF8 (classEnd + 2, (int) (codeEnd - classEnd - 2)));
+        const Language* const language = findLanguage (className);
+
+        // it has been highlighted
+        if (className.upToFirstOccurrenceOf (" ", false, false) == "hljs")
+        {
+            out.write (blockStart, (size_t) (p - blockStart));
+            continue;
+        }
+
+        // the stylesheet's '.hljs' gives all the blocks their look, even the ones without a language
+        out << "<pre><code class=\"" << ("hljs " + className).trimEnd() << "\">";
+
+        if (language != nullptr)
+            out << getHighlighted (*language, code);
+        else
+            out << code.replace ("&lt;", "<").replace ("&gt;", ">").replace ("<", "&lt;").replace (">", "&gt;");
+
+        out << closeTag;
+    }
+
+    return out.toUTF8();
+}
+
+//=================================================================================================
+const CodeHighlighter::Language* CodeHighlighter::findLanguage (const String& name)
+{
+    static const Language languages[] =
+    {
+        { "cpp c++ c cc cxx h hpp objectivec objc m mm",
+          "alignas alignof asm auto break case catch class const constexpr const_cast continue decltype default "
+          "delete do dynamic_cast else enum explicit export extern final for friend goto if inline mutable "
+          "namespace new noexcept operator override private protected public register reinterpret_cast return "
+          "sizeof static static_assert static_cast struct switch template this throw try typedef typeid typename "
+          "union using virtual volatile while @interface @implementation @end @property @synthesize self super",
+          "bool char char16_t char32_t double float int long short signed unsigned void wchar_t size_t int8_t "
+          "int16_t int32_t int64_t uint8_t uint16_t uint32_t uint64_t true false nullptr NULL nil YES NO std",
+          "//", nullptr, "/*", "*/", "\"'", true, false, false },
+
+        { "cs csharp",
+          "abstract as base break case catch checked class const continue default delegate do else enum event "
+          "explicit extern finally fixed for foreach goto if implicit in interface internal is lock namespace new "
+          "operator out override params private protected public readonly ref return sealed sizeof stackalloc "
+          "static struct switch this throw try typeof unchecked unsafe using virtual volatile while async await "
+          "var get set yield",
+          "bool byte char decimal double float int long object sbyte short string uint ulong ushort void "
+          "true false null",
+          "//", nullptr, "/*", "*/", "\"'", true, false, false },
+
+        { "java kotlin kt scala groovy",
+          "abstract assert break case catch class const continue default do else enum extends final finally for "
+          "goto if implements import instanceof interface native new package private protected public return "
+          "static strictfp super switch synchronized this throw throws transient try volatile while fun val var "
+          "when object companion override open data sealed def",
+          "boolean byte char double float int long short void String true false null",
+          "//", nullptr, "/*", "*/", "\"'", false, false, false },
+
+        { "js javascript jsx ts typescript node",
+          "async await break case catch class const continue debugger default delete do else export extends "
+          "finally for from function if import in instanceof let new of return static super switch this throw "
+          "try typeof var void while with yield interface type implements enum declare namespace",
+          "true false null undefined NaN Infinity Array Object String Number Boolean Math JSON Date Promise "
+          "console window document require module",
+          "//", nullptr, "/*", "*/", "\"'`", false, false, false },
+
+        { "json",
+          "",
+          "true false null",
+          nullptr, nullptr, nullptr, nullptr, "\"", false, false, false },
+
+        { "py python python3",
+          "and as assert async await break class continue def del elif else except finally for from global if "
+          "import in is lambda nonlocal not or pass raise return try while with yield print exec",
+          "True False None self int float str list dict set tuple len range open object super",
+          "#", nullptr, nullptr, nullptr, "\"'", false, false, false },
+
+        { "rb ruby",
+          "alias and begin break case class def defined? do else elsif end ensure for if in module next not or "
+          "redo rescue retry return self super then undef unless until when while yield require",
+          "true false nil puts",
+          "#", nullptr, nullptr, nullptr, "\"'", false, false, false },
+
+        { "bash sh shell zsh console",
+          "if then else elif fi for while until do done case esac in function return local export exit break "
+          "continue select time",
+          "echo cd ls pwd cat grep sed awk test read source sudo mkdir rm cp mv chmod",
+          "#", nullptr, nullptr, nullptr, "\"'", false, false, false },
+
+        { "php",
+          "abstract and as break case catch class clone const continue declare default do echo else elseif "
+          "empty endif endforeach endwhile extends final finally for foreach function global if implements "
+          "include include_once instanceof interface isset list namespace new or print private protected public "
+          "require require_once return static switch throw trait try unset use var while",
+          "true false null TRUE FALSE NULL array",
+          "//", "#", "/*", "*/", "\"'", false, false, false },
+
+        { "go golang",
+          "break case chan const continue default defer else fallthrough for func go goto if import interface "
+          "map package range return select struct switch type var",
+          "bool byte complex64 complex128 error float32 float64 int int8 int16 int32 int64 rune string uint "
+          "uint8 uint16 uint32 uint64 uintptr true false nil iota append cap close len make new panic recover",
+          "//", nullptr, "/*", "*/", "\"`", false, false, false },
+
+        { "rs rust",
+          "as async await break const continue crate dyn else enum extern fn for if impl in let loop match mod "
+          "move mut pub ref return self Self static struct super trait type unsafe use where while",
+          "bool char f32 f64 i8 i16 i32 i64 i128 isize str u8 u16 u32 u64 u128 usize String Vec Option "
+          "Result Some None Ok Err true false",
+          "//", nullptr, "/*", "*/", "\"", false, false, false },
+
+        { "swift",
+          "associatedtype class deinit enum extension fileprivate func import init inout internal let open "
+          "operator private protocol public static struct subscript typealias var break case continue default "
+          "defer do else fallthrough for guard if in repeat return switch where while as catch is rethrows "
+          "throw throws try self Self super",
+          "Int Double Float Bool String Character Array Dictionary Optional true false nil",
+          "//", nullptr, "/*", "*/", "\"", false, false, false },
+
+        { "lua",
+          "and break do else elseif end for function goto if in local not or repeat return then until while",
+          "true false nil print pairs ipairs require self",
+          "--", nullptr, "--[[", "]]", "\"'", false, false, false },
+
+        { "sql mysql sqlite",
+          "select from where insert into values update set delete create table drop alter add index primary key "
+          "foreign references join inner left right outer on group by order having limit offset as distinct "
+          "union all and or not in is like between exists case when then else end begin commit rollback view",
+          "int integer varchar char text date datetime float double decimal boolean null true false "
+          "count sum avg min max",
+          "--", "#", "/*", "*/", "\"'`", false, true, false },
+
+        { "css scss less",
+          "",
+          "!important",
+          nullptr, nullptr, "/*", "*/", "\"'", false, false, false },
+
+        { "html htm xml xhtml svg",
+          "", "", nullptr, nullptr, nullptr, nullptr, nullptr, false, false, true }
+    };
+
+    const String lowerName (name.toLowerCase());
+
+    for (int i = 0; i < numElementsInArray (languages); ++i)
+    {
+        if (containsWord (languages[i].names, lowerName))
+            return &languages[i];
+    }
+
+    return nullptr;
+}
+
+//=================================================================================================
+const String CodeHighlighter::getHighlighted (const Language& language, const String& code)
+{
+    static CriticalSection cacheLock;
+    static HashMap<String, String> cache;
+
+    const String key (String (language.names) + "|" + String (code.hashCode64()) + "|" + String (code.length()));
+
+    {
+        const ScopedLock sl (cacheLock);
+
+        if (cache.contains (key))
+            return cache[key];
+    }
+
+    // the tokens are found in the original code, and escaped again when they're written
+    const String originalCode (code.replace ("&lt;", "<").replace ("&gt;", ">"));
+    const char* const p = originalCode.toRawUTF8();
+    const char* const end = p + originalCode.getNumBytesAsUTF8();
+    MemoryOutputStream out ((size_t) (end - p) * 2);
+
+    if (language.isMarkup)
+        highlightMarkup (p, end, out);
+    else
+        highlightCode (language, p, end, out);
+
+    const String result (out.toUTF8());
+
+    const ScopedLock sl (cacheLock);
+
+    if (cache.size() >= maxCachedBlocks)
+        cache.clear();
+
+    cache.set (key, result);
+    return result;
+}
+
+//=================================================================================================
+void CodeHighlighter::highlightCode (const Language& language, const char* p, const char* end, MemoryOutputStream& out)
+{
+    bool atLineStart = true;
+
+    while (p < end)
+    {
+        const char c = *p;
+        const char* q = nullptr;
+        const char* cssClass = nullptr;
+
+        if (language.blockCommentStart != nullptr && startsWith (p, end, language.blockCommentStart))
+        {
+            q = find (p + strlen (language.blockCommentStart), end, language.blockCommentEnd);
+            q = (q != nullptr) ? q + strlen (language.blockCommentEnd) : end;
+            cssClass = "comment";
+        }
+        else if ((language.lineComment != nullptr && startsWith (p, end, language.lineComment))
+                 || (language.lineComment2 != nullptr && startsWith (p, end, language.lineComment2)))
+        {
+            q = skipLine (p, end);
+            cssClass = "comment";
+        }
+        else if (language.hasPreprocessor && atLineStart && c == '#')
+        {
+            q = skipLine (p, end);
+            cssClass = "meta";
+        }
+        else if (language.quotes != nullptr && c != 0 && strchr (language.quotes, c) != nullptr)
+        {
+            q = skipString (p, end);
+            cssClass = "string";
+        }
+        else if (isDigit (c))
+        {
+            for (q = p; q < end && (isIdentifierChar (*q) || *q == '.'); ++q) {}
+            cssClass = "number";
+        }
+        else if (isIdentifierStart (c) || (c == '@' && p + 1 < end && isIdentifierStart (p[1])))
+        {
+            for (q = p + 1; q < end && isIdentifierChar (*q); ++q) {}
+
+            // e.g. 'defined?' of ruby, '!important' of css
+            if (q < end && *q == '?')
+                ++q;
+
+            String word (String::fromUTF8 (p, (int) (q - p)));
+
+            if (language.ignoreCase)
+                word = word.toLowerCase();
+
+            if (containsWord (language.keywords, word))
+                cssClass = "keyword";
+            else if (containsWord (language.builtIns, word))
+                cssClass = "built_in";
+            else if (word.endsWithChar ('?'))
+                --q;
+        }
+        else if (c == '!' && startsWith (p, end, "!important"))
+        {
+            q = p + 10;
+            cssClass = "built_in";
+        }
+
+        if (q == nullptr)
+        {
+            // a single char
+            writeEscaped (p, p + 1, out);
+            atLineStart = (c == '\n') || (atLineStart && (c == ' ' || c == '\t'));
+            ++p;
+            continue;
+        }
+
+        if (cssClass != nullptr)
+            writeSpan (cssClass, p, q, out);
+        else
+            writeEscaped (p, q, out);
+
+        atLineStart = false;
+        p = q;
+    }
+}
+
+//=================================================================================================
+void CodeHighlighter::highlightMarkup (const char* p, const char* end, MemoryOutputStream& out)
+{
+    while (p < end)
+    {
+        if (startsWith (p, end, "<!--"))
+        {
+            const char* q = find (p + 4, end, "-->");
+            q = (q != nullptr) ? q + 3 : end;
+
+            writeSpan ("comment", p, q, out);
+            p = q;
+            continue;
+        }
+
+        const bool isTag = (*p == '<' && p + 1 < end
+                            && (isIdentifierStart (p[1]) || p[1] == '/' || p[1] == '!' || p[1] == '?'));
+
+        if (!isTag)
+        {
+            writeEscaped (p, p + 1, out);
+            ++p;
+            continue;
+        }
+
+        // <tagName attr="value">
+        out << "<span class=\"hljs-tag\">&lt;";
+        ++p;
+
+        if (*p == '/' || *p == '!' || *p == '?')
+            out.writeByte (*p++);
+
+        const char* q = p;
+
+        while (q < end && (isIdentifierChar (*q) || *q == '-' || *q == ':'))
+            ++q;
+
+        if (q > p)
+            writeSpan ("name", p, q, out);
+
+        p = q;
+
+        while (p < end && *p != '>')
+        {
+            if (*p == '"' || *p == '\'')
+            {
+                q = skipString (p, end);
+                writeSpan ("string", p, q, out);
+                p = q;
+            }
+            else if (isIdentifierStart (*p))
+            {
+                for (q = p; q < end && (isIdentifierChar (*q) || *q == '-' || *q == ':'); ++q) {}
+
+                writeSpan ("attr", p, q, out);
+                p = q;
+            }
+            else
+            {
+                writeEscaped (p, p + 1, out);
+                ++p;
+            }
+        }
+
+        if (p < end)
+        {
+            out << "&gt;";
+            ++p;
+        }
+
+        out << "</span>";
+    }
+}
+
+//=================================================================================================
+const char* CodeHighlighter::find (const char* p, const char* end, const char* text)
+{
+    const size_t length = strlen (text);
+
+    for (; p + length <= end; ++p)
+    {
+        if (*p == *text && memcmp (p, text, length) == 0)
+            return p;
+    }
+
+    return nullptr;
+}
+
+//=================================================================================================
+const bool CodeHighlighter::startsWith (const char* p, const char* end, const char* text)
+{
+    const size_t length = strlen (text);
+    return p + length <= end && memcmp (p, text, length) == 0;
+}
+
+//=================================================================================================
+const bool CodeHighlighter::containsWord (const char* words, const String& word)
+{
+    if (word.isEmpty())
+        return false;
+
+    const char* const w = word.toRawUTF8();
+    const size_t length = strlen (w);
+
+    for (const char* p = words; *p != 0; )
+    {
+        const char* wordEnd = p;
+
+        while (*wordEnd != 0 && *wordEnd != ' ')
+            ++wordEnd;
+
+        if ((size_t) (wordEnd - p) == length && memcmp (p, w, length) == 0)
+            return true;
+
+        p = (*wordEnd == ' ') ? wordEnd + 1 : wordEnd;
+    }
+
+    return false;
+}
+
+//=================================================================================================
+const char* CodeHighlighter::skipString (const char* p, const char* end)
+{
+    const char quote = *p++;
+
+    while (p < end)
+    {
+        if (*p == '\\')
+        {
+            p = jmin (p + 2, end);
+        }
+        else if (*p == quote)
+        {
+            return p + 1;
+        }
+        else if (*p == '\n' && quote != '`')
+        {
+            // not closed in this line
+            return p;
+        }
+        else
+        {
+            ++p;
+        }
+    }
+
+    return end;
+}
+
+//=================================================================================================
+const char* CodeHighlighter::skipLine (const char* p, const char* end)
+{
+    while (p < end && *p != '\n' && *p != '\r')
+        ++p;
+
+    return p;
+}
+
+//=================================================================================================
+void CodeHighlighter::writeEscaped (const char* p, const char* end, MemoryOutputStream& out)
+{
+    for (; p < end; ++p)
+    {
+        if (*p == '<')
+            out << "&lt;";
+        else if (*p == '>')
+            out << "&gt;";
+        else
+            out.writeByte (*p);
+    }
+}
+
+//=================================================================================================
+void CodeHighlighter::writeSpan (const char* cssClass, const char* p, const char* end, MemoryOutputStream& out)
+{
+    out << "<span class=\"hljs-" << cssClass << "\">";
+    writeEscaped (p, end, out);
+    out << "</span>";
+}
@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    CodeHighlighter.h
+    Created: 20 Oct 2026 3:12:40am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef CODEHIGHLIGHTER_H_INCLUDED
+#define CODEHIGHLIGHTER_H_INCLUDED
+
+/** Highlight the code blocks when the page is generated, so the page needn't hl.js at all.
+
+    The blocks are the ones Md2Html made, <pre><code class="cpp">...</code></pre>, its class will be
+    'hljs cpp' and the tokens will be wrapped in <span class="hljs-xxx">, the same as hl.js does,
+    so the stylesheet of the site works as it used to.
+
+    It knows the comments, strings, numbers, keywords and built-ins of the common languages
+    (and the tags of html/xml). The block whose language is unknown (or not given) only gets
+    the 'hljs' class and is escaped, so it looks like a code block as well.
+    A highlighted block is cached by its language and the hash of its code.
+*/
+class CodeHighlighter
+{
+public:
+    /** highlight all the code blocks of the arg html */
+    static const String process (const String& html);
+
+private:
+    struct Language
+    {
+        const char* names;          // the ones separated by ' '
+        const char* keywords;
+        const char* builtIns;
+        const char* lineComment;    // nullptr if it doesn't have
+        const char* lineComment2;
+        const char* blockCommentStart;
+        const char* blockCommentEnd;
+        const char* quotes;
+        bool hasPreprocessor;       // '#' at the start of a line, e.g. #include
+        bool ignoreCase;
+        bool isMarkup;              // html, xml
+    };
+
+    /** return nullptr if the language is unknown */
+    static const Language* findLanguage (const String& name);
+
+    /** arg-2 is the code in the block, which has been escaped */
+    static const String getHighlighted (const Language& language, const String& code);
+
+    static void highlightCode (const Language& language, const char* p, const char* end, MemoryOutputStream& out);
+    static void highlightMarkup (const char* p, const char* end, MemoryOutputStream& out);
+
+    //=================================================================================================
+    /** return nullptr if not found */
+    static const char* find (const char* p, const char* end, const char* text);
+    static const bool startsWith (const char* p, const char* end, const char* text);
+    static const bool containsWord (const char* words, const String& word);
+
+    static const char* skipString (const char* p, const char* end);
+    static const char* skipLine (const char* p, const char* end);
+
+    static void writeEscaped (const char* p, const char* end, MemoryOutputStream& out);
+    static void writeSpan (const char* cssClass, const char* p, const char* end, MemoryOutputStream& out);
+
+    static inline bool isDigit (const char c)            { return c >= '0' && c <= '9'; }
+    static inline bool isIdentifierStart (const char c)  { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$'; }
+    static inline bool isIdentifierChar (const char c)   { return isIdentifierStart (c) || isDigit (c); }
+
+    JUCE_DECLARE_NON_COPYABLE (CodeHighlighter)
+};
+
+
+#endif  // CODEHIGHLIGHTER_H_INCLUDED
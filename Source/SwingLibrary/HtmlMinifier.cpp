@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+    HtmlMinifier.cpp
+    Created: 20 Oct 2026 0:36:12am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+#include "HtmlMinifier.h"
+
+//=================================================================================================
+const String HtmlMinifier::minify (const String& html)
+{
+    static const char* const rawTags[] = { "pre", "textarea", "script", "style" };
+
+    const char* p = html.toRawUTF8();
+    const char* const end = p + html.getNumBytesAsUTF8();
+    MemoryOutputStream out ((size_t) (end - p));
+
+    while (p < end)
+    {
+        // whitespaces in the text
+        if (isSpace (*p))
+        {
+            bool hasNewLine = false;
+
+            for (; p < end && isSpace (*p); ++p)
+                hasNewLine = hasNewLine || (*p == '\n');
+
+            if (out.getDataSize() > 0)
+                out.writeByte (hasNewLine ? '\n' : ' ');
+
+            continue;
+        }
+
+        if (*p != '<')
+        {
+            const char* textEnd = p + 1;
+
+            while (textEnd < end && *textEnd != '<' && !isSpace (*textEnd))
+                ++textEnd;
+
+            out.write (p, (size_t) (textEnd - p));
+            p = textEnd;
+            continue;
+        }
+
+        // comments
+        if (end - p >= 4 && memcmp (p, "<!--", 4) == 0)
+        {
+            const char* const commentEnd = findIgnoreCase (p + 4, end, "-->");
+            const char* const next = (commentEnd == nullptr) ? end : commentEnd + 3;
+
+            if (end - p >= 7 && memcmp (p, "<!--[if", 7) == 0)
+                out.write (p, (size_t) (next - p));
+
+            p = next;
+            continue;
+        }
+
+        // the elements whose content must be kept intact
+        const char* rawEnd = nullptr;
+
+        for (int i = 0; i < numElementsInArray (rawTags) && rawEnd == nullptr; ++i)
+        {
+            if (isStartTag (p, end, rawTags[i]))
+            {
+                const char* const closeTag = findIgnoreCase (p + 1, end, (String ("</") + rawTags[i]).toRawUTF8());
+                const char* const closeEnd = (closeTag == nullptr) ? nullptr : findIgnoreCase (closeTag, end, ">");
+
+                rawEnd = (closeEnd == nullptr) ? end : closeEnd + 1;
+            }
+        }
+
+        if (rawEnd != nullptr)
+        {
+            out.write (p, (size_t) (rawEnd - p));
+            p = rawEnd;
+        }
+        else if (p + 1 < end && (CharacterFunctions::isLetter (p[1]) || p[1] == '/' || p[1] == '!'))
+        {
+            p = copyTag (p, end, out);
+        }
+        else
+        {
+            // a single '<' in the text
+            out.writeByte (*p++);
+        }
+    }
+
+    return out.toUTF8();
+}
+
+//=================================================================================================
+const char* HtmlMinifier::copyTag (const char* p, const char* end, MemoryOutputStream& out)
+{
+    jassert (*p == '<');
+    out.writeByte (*p++);
+
+    bool pendingSpace = false;
+
+    while (p < end)
+    {
+        const char c = *p;
+
+        if (isSpace (c))
+        {
+            pendingSpace = true;
+            ++p;
+            continue;
+        }
+
+        if (c == '>')
+        {
+            out.writeByte (*p++);
+            return p;
+        }
+
+        if (pendingSpace)
+        {
+            out.writeByte (' ');
+            pendingSpace = false;
+        }
+
+        // quoted value, keep everything in it
+        if (c == '"' || c == '\'')
+        {
+            const char* valueEnd = p + 1;
+
+            while (valueEnd < end && *valueEnd != c)
+                ++valueEnd;
+
+            valueEnd = jmin (valueEnd + 1, end);
+            out.write (p, (size_t) (valueEnd - p));
+            p = valueEnd;
+            continue;
+        }
+
+        out.writeByte (*p++);
+    }
+
+    return p;
+}
+
+//=================================================================================================
+const bool HtmlMinifier::isStartTag (const char* p, const char* end, const char* tagName)
+{
+    jassert (*p == '<');
+    ++p;
+
+    for (; *tagName != 0; ++tagName, ++p)
+    {
+        if (p >= end || CharacterFunctions::toLowerCase ((juce_wchar) (uint8) *p) != (juce_wchar) *tagName)
+            return false;
+    }
+
+    return p < end && (*p == '>' || *p == '/' || isSpace (*p));
+}
+
+//=================================================================================================
+const char* HtmlMinifier::findIgnoreCase (const char* p, const char* end, const char* text)
+{
+    const size_t length = strlen (text);
+
+    for (; (size_t) (end - p) >= length; ++p)
+    {
+        size_t i = 0;
+
+        while (i < length && CharacterFunctions::toLowerCase ((juce_wchar) (uint8) p[i]) == (juce_wchar) text[i])
+            ++i;
+
+        if (i == length)
+            return p;
+    }
+
+    return nullptr;
+}
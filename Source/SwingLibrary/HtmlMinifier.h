@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    HtmlMinifier.h
+    Created: 20 Oct 2026 0:36:12am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef HTMLMINIFIER_H_INCLUDED
+#define HTMLMINIFIER_H_INCLUDED
+
+/** Remove the needless bytes of a html, it's safe for any page, so it won't change how the page looks.
+
+    - each run of the whitespaces in the text will be a single ' ' or '\n' (if it includes a newline),
+      whitespaces between 2 inline elements are meaningful, so they won't be removed completely.
+    - the whitespaces inside a tag (not in the quoted values) will be a single ' ',
+      and the ones before '>' will be removed.
+    - comments will be removed, except the conditional comments of IE (<!--[if ...).
+    - <pre>, <textarea>, <script> and <style> will be kept intact.
+
+    It works on the UTF-8 bytes in a single pass, all the html's structure chars are ASCII.
+*/
+class HtmlMinifier
+{
+public:
+    static const String minify (const String& html);
+
+private:
+    /** p points to a '<', return true if it's the start-tag of arg-3 (case-insensitive) */
+    static const bool isStartTag (const char* p, const char* end, const char* tagName);
+
+    /** return nullptr if not found */
+    static const char* findIgnoreCase (const char* p, const char* end, const char* text);
+
+    /** p points to a '<', write the tag to arg-3 and return the char after its '>' */
+    static const char* copyTag (const char* p, const char* end, MemoryOutputStream& out);
+
+    static inline bool isSpace (const char c)   { return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f'; }
+
+    JUCE_DECLARE_NON_COPYABLE (HtmlMinifier)
+};
+
+
+#endif  // HTMLMINIFIER_H_INCLUDED
@@ -0,0 +1,360 @@
+/*
+  ==============================================================================
+
+    ImageProcessor.cpp
+    Created: 19 Oct 2026 11:02:48pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+#include "WorkerPool.h"
+#include "ImageProcessor.h"
+
+/** a band shouldn't be too small, or the threads would cost more than the work */
+enum { minRowsPerBand = 64 };
+
+/** the pixel of Image::RGB, which is 3 bytes */
+struct Pixel24
+{
+    uint8 data[3];
+};
+
+//=================================================================================================
+/** premultiplied ARGB: result = colour + background * (1 - alpha) */
+struct ImageProcessor::FlattenKernel : public ImageProcessor::RowKernel
+{
+    FlattenKernel (const Image::BitmapData& data_, const Colour& background)
+        : data (data_)
+    {
+        // the part of the background for each alpha level
+        for (uint32 a = 0; a < 256; ++a)
+        {
+            const uint32 rest = 255 - a;
+            addRed[a] = (background.getRed() * rest + 127) / 255;
+            addGreen[a] = (background.getGreen() * rest + 127) / 255;
+            addBlue[a] = (background.getBlue() * rest + 127) / 255;
+        }
+    }
+
+    void processRows (const int startRow, const int endRow) override
+    {
+        for (int y = startRow; y < endRow; ++y)
+        {
+            uint32* const line = reinterpret_cast<uint32*> (data.getLinePointer (y));
+
+            for (int x = 0; x < data.width; ++x)
+            {
+                const uint32 c = line[x];
+                const uint32 a = c >> 24;
+
+                line[x] = 0xff000000
+                    | ((((c >> 16) & 0xff) + addRed[a]) << 16)
+                    | ((((c >> 8) & 0xff) + addGreen[a]) << 8)
+                    | ((c & 0xff) + addBlue[a]);
+            }
+        }
+    }
+
+    const Image::BitmapData& data;
+    uint32 addRed[256], addGreen[256], addBlue[256];
+};
+
+//=================================================================================================
+struct ImageProcessor::TransparentKernel : public ImageProcessor::RowKernel
+{
+    TransparentKernel (const Image::BitmapData& data_, const uint8 minLevel_)
+        : data (data_), minLevel (minLevel_)
+    {
+    }
+
+    void processRows (const int startRow, const int endRow) override
+    {
+        for (int y = startRow; y < endRow; ++y)
+        {
+            uint32* const line = reinterpret_cast<uint32*> (data.getLinePointer (y));
+
+            for (int x = 0; x < data.width; ++x)
+            {
+                const uint32 c = line[x];
+                const bool isWhite = (c >> 24) == 0xff
+                    && ((c >> 16) & 0xff) >= minLevel
+                    && ((c >> 8) & 0xff) >= minLevel
+                    && (c & 0xff) >= minLevel;
+
+                line[x] = isWhite ? 0 : c;
+            }
+        }
+    }
+
+    const Image::BitmapData& data;
+    const uint32 minLevel;
+};
+
+//=================================================================================================
+/** the target rows are processed in small blocks, so that the source columns
+    which are read by a block are still in the cache for its next row */
+template <typename PixelType>
+struct ImageProcessor::RotateKernel : public ImageProcessor::RowKernel
+{
+    RotateKernel (const Image::BitmapData& source_, const Image::BitmapData& target_, const bool toLeft_)
+        : source (source_), target (target_), toLeft (toLeft_)
+    {
+        jassert (source.pixelStride == sizeof (PixelType) && target.pixelStride == sizeof (PixelType));
+    }
+
+    void processRows (const int startRow, const int endRow) override
+    {
+        enum { blockSize = 32 };
+
+        // left: target (x, y) = source (w - 1 - y, x)
+        // right: target (x, y) = source (y, h - 1 - x)
+        for (int blockY = startRow; blockY < endRow; blockY += blockSize)
+        {
+            const int blockEndY = jmin (blockY + (int) blockSize, endRow);
+
+            for (int blockX = 0; blockX < target.width; blockX += blockSize)
+            {
+                const int blockEndX = jmin (blockX + (int) blockSize, target.width);
+
+                for (int y = blockY; y < blockEndY; ++y)
+                {
+                    PixelType* const line = reinterpret_cast<PixelType*> (target.getLinePointer (y));
+                    const int sourceX = toLeft ? source.width - 1 - y : y;
+
+                    for (int x = blockX; x < blockEndX; ++x)
+                    {
+                        const int sourceY = toLeft ? x : source.height - 1 - x;
+                        line[x] = *reinterpret_cast<const PixelType*> (source.getPixelPointer (sourceX, sourceY));
+                    }
+                }
+            }
+        }
+    }
+
+    const Image::BitmapData& source;
+    const Image::BitmapData& target;
+    const bool toLeft;
+};
+
+//=================================================================================================
+void ImageProcessor::runInBands (RowKernel& kernel, const int numRows)
+{
+    const int numBands = jlimit (1, jmax (1, SystemStats::getNumCpus()), numRows / minRowsPerBand);
+
+    if (numBands == 1)
+    {
+        kernel.processRows (0, numRows);
+        return;
+    }
+
+    // inside a job of the worker pool (e.g. resizing the images of a page),
+    // the bands share the same threads rather than creating more
+    struct Bands : public WorkerPool::Task
+    {
+        Bands (RowKernel& kernel_, const int numRows_, const int numBands_)
+            : kernel (kernel_), numRows (numRows_), numBands (numBands_)
+        {
+        }
+
+        void runItem (const int index) override
+        {
+            kernel.processRows (numRows * index / numBands, numRows * (index + 1) / numBands);
+        }
+
+        RowKernel& kernel;
+        const int numRows, numBands;
+    };
+
+    Bands bands (kernel, numRows, numBands);
+    WorkerPool::getInstance()->runAll (bands, numBands);
+}
+
+//=================================================================================================
+void ImageProcessor::flattenAlpha (Image& image, const Colour& background)
+{
+    if (!image.isValid() || !image.hasAlphaChannel())
+        return;
+
+    if (image.getFormat() != Image::ARGB)
+        image = image.convertedToFormat (Image::ARGB);
+
+    const Image::BitmapData data (image, Image::BitmapData::readWrite);
+    FlattenKernel kernel (data, background);
+
+    runInBands (kernel, data.height);
+}
+
+//=================================================================================================
+void ImageProcessor::makeWhiteTransparent (Image& image, const uint8 minLevel)
+{
+    if (!image.isValid())
+        return;
+
+    // otherwise the transparent colour would be black
+    if (image.getFormat() != Image::ARGB)
+        image = image.convertedToFormat (Image::ARGB);
+
+    const Image::BitmapData data (image, Image::BitmapData::readWrite);
+    TransparentKernel kernel (data, minLevel);
+
+    runInBands (kernel, data.height);
+}
+
+//=================================================================================================
+const Image ImageProcessor::rotate90 (const Image& image, const bool toLeft)
+{
+    if (!image.isValid())
+        return Image();
+
+    Image result (image.getFormat(), image.getHeight(), image.getWidth(), false);
+
+    const Image::BitmapData source (image, Image::BitmapData::readOnly);
+    const Image::BitmapData target (result, Image::BitmapData::writeOnly);
+
+    if (source.pixelStride == 4)
+    {
+        RotateKernel<uint32> kernel (source, target, toLeft);
+        runInBands (kernel, target.height);
+    }
+    else if (source.pixelStride == 3)
+    {
+        RotateKernel<Pixel24> kernel (source, target, toLeft);
+        runInBands (kernel, target.height);
+    }
+    else
+    {
+        jassert (source.pixelStride == 1);
+
+        RotateKernel<uint8> kernel (source, target, toLeft);
+        runInBands (kernel, target.height);
+    }
+
+    return result;
+}
+
+//=================================================================================================
+const Image ImageProcessor::loadImage (const File& imageFile)
+{
+    return ImageFileFormat::loadFrom (imageFile);
+}
+
+//=================================================================================================
+const bool ImageProcessor::processFileNow (const Operation operation,
+                                           const File& source,
+                                           const File& target,
+                                           const float value)
+{
+    Image image (loadImage (source));
+
+    if (!image.isValid())
+        return false;
+
+    if (operation == convertToJpg)
+    {
+        // otherwise the transparent pixels would be black
+        flattenAlpha (image, Colours::white);
+    }
+    else if (operation == transparentWhite)
+    {
+        jassert (target.hasFileExtension ("png"));
+        makeWhiteTransparent (image);
+    }
+    else if (operation == rescaleWidth)
+    {
+        jassert (value > 0.001f);
+
+        image = image.rescaled (jmax (1, roundToInt (image.getWidth() * value)),
+                                jmax (1, roundToInt (image.getHeight() * value)),
+                                Graphics::highResamplingQuality);
+    }
+    else
+    {
+        image = rotate90 (image, operation == rotateLeft);
+    }
+
+    return writeImage (image, target, (operation == convertToJpg) ? value : -1.0f);
+}
+
+//=================================================================================================
+const bool ImageProcessor::writeResized (const File& source,
+                                         const File& target,
+                                         const int newWidth,
+                                         const float jpgQuality)
+{
+    Image image (loadImage (source));
+
+    if (!image.isValid() || newWidth < 1)
+        return false;
+
+    if (target.hasFileExtension ("jpg;jpeg"))
+        flattenAlpha (image, Colours::white);
+
+    image = image.rescaled (newWidth,
+                            jmax (1, roundToInt (image.getHeight() * newWidth / (double) image.getWidth())),
+                            Graphics::highResamplingQuality);
+
+    return writeImage (image, target, jpgQuality);
+}
+
+//=================================================================================================
+const bool ImageProcessor::writeImage (const Image& image, const File& target, const float jpgQuality)
+{
+    if (!image.isValid())
+        return false;
+
+    JPEGImageFormat jpgFormat;
+    jpgFormat.setQuality (jpgQuality);
+
+    ImageFileFormat* format = target.hasFileExtension ("jpg;jpeg")
+        ? &jpgFormat : ImageFileFormat::findImageFormatForFileExtension (target);
+
+    if (format == nullptr)
+        return false;
+
+    // the source might be the target
+    TemporaryFile tempFile (target);
+
+    {
+        ScopedPointer<FileOutputStream> out (tempFile.getFile().createOutputStream());
+
+        if (out == nullptr || out->failedToOpen() || !format->writeImageToStream (image, *out))
+            return false;
+
+        out->flush();
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+//=================================================================================================
+const bool ImageProcessor::processFile (const Operation operation,
+                                        const File& source,
+                                        const File& target,
+                                        const float value)
+{
+    struct ProcessThread : public ThreadWithProgressWindow
+    {
+        ProcessThread (const Operation operation_, const File& source_, const File& target_, const float value_)
+            : ThreadWithProgressWindow (TRANS ("Processing the image..."), true, false),
+            operation (operation_), source (source_), target (target_), value (value_), succeeded (false)
+        {
+        }
+
+        void run() override
+        {
+            setProgress (-1.0);
+            succeeded = processFileNow (operation, source, target, value);
+        }
+
+        const Operation operation;
+        const File source, target;
+        const float value;
+        bool succeeded;
+    };
+
+    ProcessThread thread (operation, source, target, value);
+
+    return thread.runThread() && thread.succeeded;
+}
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    ImageProcessor.h
+    Created: 19 Oct 2026 11:02:48pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef IMAGEPROCESSOR_H_INCLUDED
+#define IMAGEPROCESSOR_H_INCLUDED
+
+/** Process the pixels of big images fast.
+
+    The kernels work on the rows of Image::BitmapData directly instead of
+    getPixelAt() / setPixelAt(), and the rows are split into bands which
+    are processed in parallel. The inner loops are plain and branch-less
+    as far as possible, so that the compiler could vectorize them.
+
+    processFile() runs an operation on a background thread and shows a progress window,
+    it's for the ui (such as the media menu of the editor), which shouldn't be blocked.
+*/
+class ImageProcessor
+{
+public:
+    enum Operation
+    {
+        convertToJpg = 0,   /**< arg value: jpg quality */
+        transparentWhite,   /**< the result is png */
+        rescaleWidth,       /**< arg value: ratio of the original width, e.g. 0.5 */
+        rotateLeft,
+        rotateRight
+    };
+
+    /** load the source, process it, then write it to the target.
+        the source and the target could be the same file (it'll be written to a temp file first). */
+    static const bool processFileNow (const Operation operation,
+                                      const File& source,
+                                      const File& target,
+                                      const float value = 0.f);
+
+    /** same as processFileNow(), but run it on a background thread with a progress window. */
+    static const bool processFile (const Operation operation,
+                                   const File& source,
+                                   const File& target,
+                                   const float value = 0.f);
+
+    /** write a copy of the source which has the arg width (the height keeps the ratio).
+        if the target is a jpg, the transparent pixels will be white. */
+    static const bool writeResized (const File& source,
+                                    const File& target,
+                                    const int newWidth,
+                                    const float jpgQuality);
+
+    /** load an image without ImageCache, which would keep a big image in memory
+        and return the old one after the file changed. */
+    static const Image loadImage (const File& imageFile);
+
+    //=================================================================================================
+    /** composite the (semi-)transparent pixels over the arg colour. it'll be converted to ARGB if needed. */
+    static void flattenAlpha (Image& image, const Colour& background);
+
+    /** the opaque pixels whose red, green and blue are all >= arg-2 will be transparent.
+        it'll be converted to ARGB if needed. */
+    static void makeWhiteTransparent (Image& image, const uint8 minLevel = 0xf0);
+
+    /** return a new image which has the same format. */
+    static const Image rotate90 (const Image& image, const bool toLeft);
+
+private:
+    //=================================================================================================
+    /** a kernel processes some rows, it must be thread-safe between different rows */
+    struct RowKernel
+    {
+        virtual ~RowKernel() { }
+        virtual void processRows (const int startRow, const int endRow) = 0;
+    };
+
+    /** split the rows into bands and process them in parallel, return after all done */
+    static void runInBands (RowKernel& kernel, const int numRows);
+
+    static const bool writeImage (const Image& image, const File& target, const float jpgQuality);
+
+    struct FlattenKernel;
+    struct TransparentKernel;
+    template <typename PixelType> struct RotateKernel;
+
+    JUCE_DECLARE_NON_COPYABLE (ImageProcessor)
+};
+
+
+#endif  // IMAGEPROCESSOR_H_INCLUDED
@@ -9,48 +9,192 @@
 */
 
 #include "JuceHeader.h"
+#include "MultiReplacer.h"
+#include "Profiler.h"
 #include "../HtmlProcessor.h"
 #include "MD2Html.h"
 
+//=================================================================================================
+/** Lines of a string without copying any of them. Each line is an (offset, length) range
+    over the UTF-8 buffer of the string, and it's splited the same as StringArray::addLines().
+
+    All the checks work on the byte-range of a line and never allocate anything.
+    Note: the string must be alive as long as this object.
+*/
+class Md2Html::LineViews
+{
+public:
+    LineViews (const String& source) 
+        : text (source.toRawUTF8())
+    {
+        const int numBytes = (int) source.getNumBytesAsUTF8();
+
+        if (numBytes == 0)
+            return;
+
+        int lineStart = 0;
+
+        for (int i = 0; i < numBytes; ++i)
+        {
+            if (text[i] == '\n' || text[i] == '\r')
+            {
+                ranges.add (Range<int> (lineStart, i));
+
+                if (text[i] == '\r' && text[i + 1] == '\n')
+                    ++i;
+
+                lineStart = i + 1;
+            }
+        }
+
+        ranges.add (Range<int> (lineStart, numBytes));
+    }
+
+    const int size() const                         { return ranges.size(); }
+    const char* getStart (const int line) const    { return text + ranges.getReference (line).getStart(); }
+    const char* getEnd (const int line) const      { return text + ranges.getReference (line).getEnd(); }
+
+    //=================================================================================================
+    const bool startsWith (const int line, const char* prefix) const
+    {
+        return startsWith (getStart (line), getEnd (line), prefix);
+    }
+
+    const bool contains (const int line, const char* target) const
+    {
+        return contains (getStart (line), getEnd (line), target);
+    }
+
+    const bool isBlank (const int line) const
+    {
+        return skipSpaces (getStart (line), getEnd (line)) == getEnd (line);
+    }
+
+    //=================================================================================================
+    static const char* skipSpaces (const char* start, const char* end)
+    {
+        while (start < end && isSpace (*start))
+            ++start;
+
+        return start;
+    }
+
+    /** return the end after trimmed */
+    static const char* skipSpacesBackwards (const char* start, const char* end)
+    {
+        while (end > start && isSpace (*(end - 1)))
+            --end;
+
+        return end;
+    }
+
+    /** skip some characters (not bytes), but never beyond the end */
+    static const char* skipChars (const char* start, const char* end, int numChars)
+    {
+        CharPointer_UTF8 charPtr (start);
+
+        while (--numChars >= 0 && charPtr.getAddress() < end)
+            ++charPtr;
+
+        const char* result = charPtr.getAddress();
+        return (result < end) ? result : end;
+    }
+
+    static const bool startsWith (const char* start, const char* end, const char* prefix)
+    {
+        const size_t length = strlen (prefix);
+        return (size_t) (end - start) >= length && memcmp (start, prefix, length) == 0;
+    }
+
+    static const bool endsWith (const char* start, const char* end, const char* postfix)
+    {
+        const size_t length = strlen (postfix);
+        return (size_t) (end - start) >= length && memcmp (end - length, postfix, length) == 0;
+    }
+
+    static const bool contains (const char* start, const char* end, const char* target)
+    {
+        const size_t length = strlen (target);
+
+        for (const char* p = start; (size_t) (end - p) >= length; ++p)
+        {
+            if (*p == *target && memcmp (p, target, length) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    /** write the range to the stream, it does nothing if the start isn't before the end */
+    static void write (OutputStream& stream, const char* start, const char* end)
+    {
+        if (start < end)
+            stream.write (start, (size_t) (end - start));
+    }
+
+    static const String toString (const char* start, const char* end)
+    {
+        return (start < end) ? String (CharPointer_UTF8 (start), CharPointer_UTF8 (end)) : String();
+    }
+
+private:
+    static const bool isSpace (const char c)
+    {
+        return c == ' ' || (c >= 9 && c <= 13);
+    }
+
+    const char* text;
+    Array<Range<int> > ranges;
+
+    JUCE_DECLARE_NON_COPYABLE (LineViews)
+};
+
 //=================================================================================================
 const String Md2Html::mdStringToHtml (const String& mdString)
 {
     if (mdString.isEmpty())
         return String();
 
-    // parse markdown, must followed by these order
-    String htmlContent (mdString);    
+    const Profiler::ScopedTimer timer ("md2html");
+
+    // parse markdown, must followed by these order.
+    // the marks are scanned only once here, a stage only removes its marks or moves them,
+    // so a stage whose marks aren't there at all needn't to run.
+    String htmlContent (mdString);
+    int marks = scanMarks (htmlContent);
 
-    if (htmlContent.contains (")["))
+    if (marks & postilMark)
         htmlContent = postilParse (htmlContent);
 
-    if ((htmlContent.contains ("------") 
-         || htmlContent.contains ("======") 
-         || htmlContent.contains ("//////"))
-        && htmlContent.contains (" | "))
+    if ((marks & tableStyleMark) && (marks & tableCellMark))
         htmlContent = tableParse (htmlContent);
 
-    if (htmlContent.contains ("//////"))
+    if (marks & commentMark)
         htmlContent = commentParse (htmlContent);
 
-    if (htmlContent.contains ("`"))
+    if (marks & backquoteMark)
     {
-        if (htmlContent.contains ("```"))
+        if (marks & codeBlockMark)
             htmlContent = codeBlockParse (htmlContent);
 
         htmlContent = inlineCodeParse (htmlContent);
     }
 
-    if (htmlContent.contains ("[^"))
+    if (marks & endnoteMark)
+    {
         htmlContent = endnoteParse (htmlContent);
 
-    if (htmlContent.contains ("*"))
+        // the title of endnotes is bold
+        marks |= (asteriskMark | twoAsterisksMark);
+    }
+
+    if (marks & asteriskMark)
     {
-        if (htmlContent.contains ("**"))
+        if (marks & twoAsterisksMark)
         {
-            if (htmlContent.contains ("***"))
+            if (marks & threeAsterisksMark)
             {
-                if (htmlContent.contains ("******"))
+                if (marks & identifierMark)
                     htmlContent = identifierParse (htmlContent);
 
                 htmlContent = boldAndItalicParse (htmlContent);
@@ -62,41 +206,41 @@ const String Md2Html::mdStringToHtml (const String& mdString)
         htmlContent = italicParse (htmlContent);
     }
 
-    if (htmlContent.contains ("~~"))
+    if (marks & highlightMark)
     {
-        if (htmlContent.contains ("~~~"))
+        if (marks & hybridMark)
             htmlContent = hybridParse (htmlContent);
 
         htmlContent = highlightParse (htmlContent);
     }
 
-    if (htmlContent.contains ("[TOC]"))
+    if (marks & tocMark)
         htmlContent = tocParse (htmlContent);
 
     htmlContent = processByLine (htmlContent);
 
-    if (htmlContent.contains (" http"))
+    if (marks & spaceLinkMark)
         htmlContent = spaceLinkParse (htmlContent);
 
-    if (htmlContent.contains ("!["))
+    if (marks & imageMark)
         htmlContent = imageParse (htmlContent);
 
-    if (htmlContent.contains ("~[]("))
+    if (marks & audioMark)
         htmlContent = audioParse (htmlContent);
 
-    if (htmlContent.contains ("@[]("))
+    if (marks & videoMark)
         htmlContent = videoParse (htmlContent);
 
-    if (htmlContent.contains ("]("))
+    if (marks & linkMark)
         htmlContent = mdLinkParse (htmlContent);
 
-    if (htmlContent.contains ("+ "))
+    if (marks & orderedListMark)
         htmlContent = listParse (htmlContent, true);
 
-    if (htmlContent.contains ("- "))
+    if (marks & unorderedListMark)
         htmlContent = listParse (htmlContent, false);
 
-    if (htmlContent.contains (CharPointer_UTF8 ("\xef\xbc\x88")))
+    if (marks & cnBracketMark)
         htmlContent = cnBracketParse (htmlContent);
     
     htmlContent = cleanUp (htmlContent);
@@ -106,130 +250,213 @@ const String Md2Html::mdStringToHtml (const String& mdString)
 }
 
 //=================================================================================================
-const String Md2Html::tableParse (const String& mdString)
+const int Md2Html::scanMarks (const String& mdString)
 {
-    StringArray contentByLine;
-    contentByLine.addLines (mdString);
+    const char* const text = mdString.toRawUTF8();
+    const int numBytes = (int) mdString.getNumBytesAsUTF8();
+    int marks = 0;
 
-    contentByLine.insert (0, "%%__table@MDtag@Parse__%%");
-    contentByLine.add ("%%__table@MDtag@Parse__%%");
-    
-    for (int i = 1; i < contentByLine.size() - 1; ++i)
+    for (int i = 0; i < numBytes; ++i)
     {
-        String& prevLine = contentByLine.getReference (i - 1);
-        String& currentLine (contentByLine.getReference (i));
-        String& nextLine = contentByLine.getReference (i + 1);
+        const char* const p = text + i;
 
-        if ((currentLine.substring (0, 6) == "------"
-             || currentLine.substring (0, 6) == "======"
-             || currentLine.substring (0, 6) == "//////")
-            && prevLine.contains (" | ") 
-            && nextLine.contains (" | "))
+        // all other bytes (include the CJK ones) can't be the begin of any mark.
+        // the string ends with 0, so it's safe to look at the bytes after p
+        switch (*p)
         {
-            // style
-            String styleClass;
+            case '-': case '=': case '/': case '*': case '`': case '~':
+            {
+                // a run of the same char
+                int runLength = 1;
 
-            if (currentLine.substring (0, 6) == "------")
-                styleClass = "<table class=normalTable>";
+                while (p[runLength] == *p)
+                    ++runLength;
 
-            else if (currentLine.substring (0, 6) == "======")
-                styleClass = "<table class=interlacedTable>";
+                const char afterRun = p[runLength];
 
-            else if (currentLine.substring (0, 6) == "//////")
-                styleClass = "<table class=noBorderTable>";
+                if (*p == '-')
+                {
+                    if (runLength >= 6)             marks |= tableStyleMark;
+                    if (afterRun == ' ')            marks |= unorderedListMark;
+                }
+                else if (*p == '=')
+                {
+                    if (runLength >= 6)             marks |= tableStyleMark;
+                }
+                else if (*p == '/')
+                {
+                    if (runLength >= 6)             marks |= (tableStyleMark | commentMark);
+                }
+                else if (*p == '*')
+                {
+                    marks |= asteriskMark;
+                    if (runLength >= 2)             marks |= twoAsterisksMark;
+                    if (runLength >= 3)             marks |= threeAsterisksMark;
+                    if (runLength >= 6)             marks |= identifierMark;
+                }
+                else if (*p == '`')
+                {
+                    marks |= backquoteMark;
+                    if (runLength >= 3)             marks |= codeBlockMark;
+                }
+                else // '~'
+                {
+                    if (runLength >= 2)             marks |= highlightMark;
+                    if (runLength >= 3)             marks |= hybridMark;
+                    if (strncmp (p + runLength, "[](", 4) == 0)  marks |= audioMark;
+                }
 
-            // the first column's align
-            String firstColumnAlign (">");  // default for left
+                i += runLength - 1;
+                break;
+            }
 
-            if (prevLine.trimStart().substring (0, 3) == "(>)")
-                firstColumnAlign = " style=\"text-align:right;\">";
-            else if (prevLine.trimStart().substring (0, 3) == "(^)")
-                firstColumnAlign = " style=\"text-align:center;\">";
+            case ' ':
+                if (p[1] == '|' && p[2] == ' ')             marks |= tableCellMark;
+                else if (strncmp (p, " http", 5) == 0)      marks |= spaceLinkMark;
+                break;
 
-            // get align marks for other columns
-            StringArray alignArray;
-            int alignIndex = prevLine.indexOf (" | ");
+            case ')':   if (p[1] == '[')                            marks |= postilMark;        break;
+            case ']':   if (p[1] == '(')                            marks |= linkMark;          break;
+            case '!':   if (p[1] == '[')                            marks |= imageMark;         break;
+            case '+':   if (p[1] == ' ')                            marks |= orderedListMark;   break;
+            case '@':   if (strncmp (p, "@[](", 4) == 0)            marks |= videoMark;         break;
 
-            while (alignIndex != -1)
+            case '[':
+                if (p[1] == '^')                            marks |= endnoteMark;
+                else if (strncmp (p, "[TOC]", 5) == 0)      marks |= tocMark;
+                break;
+
+            case '\xef':
+                if (strncmp (p, "\xef\xbc\x88", 3) == 0)    marks |= cnBracketMark;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return marks;
+}
+
+//=================================================================================================
+const String Md2Html::tableParse (const String& mdString)
+{
+    const Profiler::ScopedTimer timer ("md2html/table");
+    const LineViews lines (mdString);
+    MemoryOutputStream result ((size_t) mdString.getNumBytesAsUTF8() + 1024);
+    
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        if (i > 0)
+            result << "\n";
+
+        // line i: table-head, i + 1: style mark, i + 2: the first row
+        if (!(i + 2 < lines.size()
+              && (lines.startsWith (i + 1, "------")
+                  || lines.startsWith (i + 1, "======")
+                  || lines.startsWith (i + 1, "//////"))
+              && lines.contains (i, " | ")
+              && lines.contains (i + 2, " | ")))
+        {
+            LineViews::write (result, lines.getStart (i), lines.getEnd (i));
+            continue;
+        }
+
+        const char* const headStart = lines.getStart (i);
+        const char* const headEnd = lines.getEnd (i);
+
+        // style
+        String styleClass;
+
+        if (lines.startsWith (i + 1, "------"))
+            styleClass = "<table class=normalTable>";
+
+        else if (lines.startsWith (i + 1, "======"))
+            styleClass = "<table class=interlacedTable>";
+
+        else
+            styleClass = "<table class=noBorderTable>";
+
+        const bool isInterlaced = lines.startsWith (i + 1, "======");
+
+        // the first column's align
+        const char* firstColumnAlign = ">";  // default for left
+        const char* const trimmedHead = LineViews::skipSpaces (headStart, headEnd);
+
+        if (LineViews::startsWith (trimmedHead, headEnd, "(>)"))
+            firstColumnAlign = " style=\"text-align:right;\">";
+        else if (LineViews::startsWith (trimmedHead, headEnd, "(^)"))
+            firstColumnAlign = " style=\"text-align:center;\">";
+
+        // get align marks for other columns
+        Array<const char*> alignArray;
+
+        for (const char* p = headStart; p + 3 <= headEnd; ++p)
+        {
+            if (LineViews::startsWith (p, headEnd, " | "))
             {
-                if (prevLine.substring (alignIndex + 3, alignIndex + 6) == "(>)")
+                if (LineViews::startsWith (p + 3, headEnd, "(>)"))
                     alignArray.add (" style=\"text-align:right;\">");
-                else if (prevLine.substring (alignIndex + 3, alignIndex + 6) == "(^)")
+                else if (LineViews::startsWith (p + 3, headEnd, "(^)"))
                     alignArray.add (" style=\"text-align:center;\">");
                 else
                     alignArray.add (">");
 
-                alignIndex = prevLine.indexOf (alignIndex + 3, " | "); // 3 for ' | '
-            }
-            
-            // process the table-head line
-            currentLine = prevLine.replace ("(>)", String()).replace ("(^)", String());
-            prevLine = styleClass;
-            currentLine = "<tr><th>" + currentLine.replace (" | ", "</th><th>") + "</th></tr>";
-
-            // process next line (the first line of this table)
-            nextLine = "<tr><td" + firstColumnAlign + nextLine.replace (" | ", "</td><td>") + "</td></tr>";
-            alignIndex = nextLine.indexOf (8, "<td>"); // 8 for at least is '<tr><td>'
-            int indexOfMarkArray = 0;
-
-            while (alignIndex != -1)
-            {
-                // here to prevent table-head columns less than this line's column
-                if (indexOfMarkArray < alignArray.size())
-                    nextLine = nextLine.replaceSection (alignIndex + 3, 1, alignArray[indexOfMarkArray]);
-                else
-                    break;
-
-                ++indexOfMarkArray;
-                alignIndex = nextLine.indexOf (alignIndex + 9, "<td>"); // 9 for '<td></td>'
+                p += 2;  // 3 for ' | '
             }
+        }
 
-            // process other lines
-            int rowNums = i + 1;
-            int numForEvenLine = 0;
+        // process the table-head line
+        const String headStr (LineViews::toString (headStart, headEnd)
+                              .replace ("(>)", String()).replace ("(^)", String()));
 
-            while (++rowNums < contentByLine.size())
-            {
-                String& thisLine = contentByLine.getReference (rowNums);
+        result << styleClass << "\n"
+            << "<tr><th>" << headStr.replace (" | ", "</th><th>") << "</th></tr>";
 
-                if (thisLine.contains (" | "))
-                {
-                    thisLine = "<tr><td" + firstColumnAlign + thisLine.replace (" | ", "</td><td>") + "</td></tr>";
+        // process the rows, the first row isn't counted for interlace style
+        int rowNums = i + 2;
+        int numForEvenLine = -1;
 
-                    // process align
-                    alignIndex = thisLine.indexOf (8, "<td>"); // 8 for at least is '<tr><td>'
-                    indexOfMarkArray = 0;
+        while (rowNums < lines.size() && lines.contains (rowNums, " | "))
+        {
+            const char* const rowEnd = lines.getEnd (rowNums);
+            const char* copiedUpTo = lines.getStart (rowNums);
+            int indexOfMarkArray = 0;
 
-                    while (alignIndex != -1)
-                    {
-                        if (indexOfMarkArray < alignArray.size())
-                            thisLine = thisLine.replaceSection (alignIndex + 3, 1, alignArray[indexOfMarkArray]);
-                        else
-                            break;
+            result << "\n" 
+                << ((isInterlaced && numForEvenLine >= 0 && numForEvenLine % 2 == 0) ? "<tr class=interlacedEven>" : "<tr>")
+                << "<td" << firstColumnAlign;
 
-                        ++indexOfMarkArray;
-                        alignIndex = thisLine.indexOf (alignIndex + 9, "<td>"); // 9 for '<td></td>'
-                    }
+            for (const char* p = copiedUpTo; p + 3 <= rowEnd; ++p)
+            {
+                if (LineViews::startsWith (p, rowEnd, " | "))
+                {
+                    LineViews::write (result, copiedUpTo, p);
 
-                    // for interlace style
-                    if (styleClass == "<table class=interlacedTable>" && (numForEvenLine % 2 == 0))
-                        thisLine = thisLine.replaceSection (0, 4, "<tr class=interlacedEven>");
+                    // the extra cells (more than table-head's) are left align
+                    result << "</td><td" 
+                        << ((indexOfMarkArray < alignArray.size()) ? alignArray[indexOfMarkArray] : ">");
 
-                    ++numForEvenLine;
-                }
-                else
-                {
-                    contentByLine.insert (rowNums, "</table>");
-                    break;
+                    ++indexOfMarkArray;
+                    p += 2;
+                    copiedUpTo = p + 1;
                 }
             }
 
-            i = rowNums;
+            LineViews::write (result, copiedUpTo, rowEnd);
+            result << "</td></tr>";
+
+            ++numForEvenLine;
+            ++rowNums;
         }
+
+        result << "\n" << "</table>";
+
+        // the line which ended this table will be processed as a normal line
+        i = rowNums - 1;
     }
 
-    contentByLine.removeString ("%%__table@MDtag@Parse__%%");
-    return contentByLine.joinIntoString ("\n");
+    return result.toUTF8();
 }
 
 //=================================================================================================
@@ -260,56 +487,90 @@ const String Md2Html::hybridParse (const String& mdString)
 
         const String contentStr (resultStr.substring (indexStart, indexEnd));
 
-        // process by line
-        StringArray lines;
-        lines.addLines (contentStr);
-
-        // remove 2 '~~~'
-        lines.remove (0);
-        lines.remove (lines.size() - 1);
+        // process by line, the first and the last are 2 '~~~'
+        const LineViews lines (contentStr);
+        int firstLine = 1;
+        int lastLine = lines.size() - 2;
 
         // make sure there isn't any empty line at the begin and end
-        while (lines.size() > 0 && lines[0].isEmpty())
-            lines.remove (0);   
+        while (firstLine <= lastLine && lines.getStart (firstLine) == lines.getEnd (firstLine))
+            ++firstLine;
 
-        while (lines.size() > 0 && lines[lines.size() - 1].isEmpty())
-            lines.remove (lines.size() - 1);
+        while (lastLine >= firstLine && lines.getStart (lastLine) == lines.getEnd (lastLine))
+            --lastLine;
 
-        // process the 1st column of the first line
-        if (lines.size() < 1)
-        {
+        if (firstLine > lastLine)
             return resultStr.replaceSection (indexStart, indexEnd - indexStart + 3, String());
-        }
-        else if (lines.size() == 1)
+
+        // which cell-tags each line needs. it must be decided from the last line to the first,
+        // because a line is judged by the next one which has been decided.
+        enum CellTag { none = 0, rowAndCellStart, cellAndRowEnd, cell, rowAndCell };
+        Array<int> tags;
+        tags.insertMultiple (0, none, lastLine - firstLine + 1);
+        int wrappedIndex = -1;
+
+        if (firstLine == lastLine)
         {
-            lines.getReference (0) = "<tr><td>" + lines[0] + "</td></tr>";
+            tags.set (0, rowAndCell);
         }
         else
         {
-            lines.getReference (0) = "<tr><td>" + lines[0] + "</td>";
+            tags.set (0, rowAndCellStart);
 
-            // process others..
-            for (int i = lines.size() - 1; --i > 0; )
+            for (int i = lastLine - 1; i > firstLine; --i)
             {
-                if (lines[i - 1].trim().isEmpty())
-                    lines.getReference (i) = "<tr><td>" + lines[i] + "</td>";
-                else if (lines[i + 1].trim().isEmpty())
-                    lines.getReference (i) = "<td>" + lines[i] + "</td></tr>";
-                else if (lines[i].trim().isNotEmpty())
-                    lines.getReference (i) = "<td>" + lines[i] + "</td>";
+                const int index = i - firstLine;
+                const bool prevIsBlank = (index - 1 > 0) && lines.isBlank (i - 1);
+                const bool nextIsBlank = (tags[index + 1] == none) && lines.isBlank (i + 1);
+
+                if (prevIsBlank)
+                    tags.set (index, rowAndCellStart);
+                else if (nextIsBlank)
+                    tags.set (index, cellAndRowEnd);
+                else if (!lines.isBlank (i))
+                    tags.set (index, cell);
             }
 
-            lines.removeEmptyStrings (true);
+            // the last column of the last line, it's the last one which isn't blank
+            int lastIndex = lastLine - firstLine;
+
+            while (lastIndex > 0 && tags[lastIndex] == none && lines.isBlank (firstLine + lastIndex))
+                --lastIndex;
 
-            // process the last column of the last line
-            lines.getReference (lines.size() - 1) = "<td>" + lines[lines.size() - 1] + "</td></tr>";
+            wrappedIndex = lastIndex;
         }
-        
-        // finally...
-        lines.insert (0, "<table class=hybridTable id=hybrid-" + String (marginNum) + ">");
-        lines.add ("</table>");
 
-        const String& htmlStr (lines.joinIntoString (newLine));
+        MemoryOutputStream htmlStream;
+        htmlStream << "<table class=hybridTable id=hybrid-" << String (marginNum) << ">";
+
+        for (int i = firstLine; i <= lastLine; ++i)
+        {
+            const int tag = tags[i - firstLine];
+            const bool wrapIt = (i - firstLine == wrappedIndex);
+
+            // blank line which isn't a cell
+            if (tag == none && !wrapIt && lines.isBlank (i))
+                continue;
+
+            htmlStream << newLine << (wrapIt ? "<td>" : "");
+
+            if (tag == rowAndCellStart || tag == rowAndCell)
+                htmlStream << "<tr><td>";
+            else if (tag != none)
+                htmlStream << "<td>";
+
+            LineViews::write (htmlStream, lines.getStart (i), lines.getEnd (i));
+
+            if (tag == cellAndRowEnd || tag == rowAndCell)
+                htmlStream << "</td></tr>";
+            else if (tag != none)
+                htmlStream << "</td>";
+
+            htmlStream << (wrapIt ? "</td></tr>" : "");
+        }
+
+        htmlStream << newLine << "</table>";
+        const String htmlStr (htmlStream.toUTF8());
 
         //DBG (htmlStr);
         resultStr = resultStr.replaceSection (indexStart, contentStr.length() + 3, htmlStr);
@@ -322,16 +583,21 @@ const String Md2Html::hybridParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::identifierParse (const String& mdString)
 {
-    StringArray lines;
-    lines.addLines (mdString);
+    const LineViews lines (mdString);
+    MemoryOutputStream result ((size_t) mdString.getNumBytesAsUTF8());
     
-    for (int i = lines.size(); --i >= 0; )
+    for (int i = 0; i < lines.size(); ++i)
     {
-        if (lines[i].substring (0, 6) == "******")
-            lines.getReference (i) = "<p>";
+        if (i > 0)
+            result << newLine;
+
+        if (lines.startsWith (i, "******"))
+            result << "<p>";
+        else
+            LineViews::write (result, lines.getStart (i), lines.getEnd (i));
     }
 
-    return lines.joinIntoString (newLine);
+    return result.toUTF8();
 }
 
 //=================================================================================================
@@ -384,6 +650,7 @@ const String Md2Html::commentParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::codeBlockParse (const String& mdString)
 {
+    const Profiler::ScopedTimer timer ("md2html/codeBlock");
     String resultStr (mdString);
     int indexStart = resultStr.indexOf (0, "```");
 
@@ -422,6 +689,7 @@ const String Md2Html::codeBlockParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::endnoteParse (const String& mdString)
 {
+    const Profiler::ScopedTimer timer ("md2html/endnote");
     String resultStr (mdString);
     int indexStart = resultStr.indexOf (0, "[^");
     int noteNumber = 0;
@@ -516,6 +784,7 @@ const String Md2Html::postilParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::inlineCodeParse (const String& mdString)
 {
+    const Profiler::ScopedTimer timer ("md2html/inlineCode");
     StringArray sa;
     sa.addLines (mdString);
 
@@ -610,6 +879,7 @@ const String Md2Html::boldAndItalicParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::boldParse (const String& mdString)
 {
+    const Profiler::ScopedTimer timer ("md2html/bold");
     String resultStr (mdString);
     int index = resultStr.indexOf (0, "**");
 
@@ -713,6 +983,7 @@ const String Md2Html::highlightParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::tocParse (const String& mdString)
 {
+    const Profiler::ScopedTimer timer ("md2html/toc");
     String resultStr (mdString);
 
     if (!resultStr.contains ("[TOC]"))
@@ -724,47 +995,59 @@ const String Md2Html::tocParse (const String& mdString)
     // escape '\[TOC]'
     resultStr = resultStr.replace ("\\[TOC]", "_@_tocParseReplaceStr_@_");
     
-    // get lines which include '#'s
-    StringArray lines;
-    lines.addLines (resultStr);
-    
-    for (int i = lines.size(); --i >= 0; )
-    {
-        if (lines[i].trimStart().substring (0, 1) != "#")
-            lines.remove (i);
-    }
+    // get lines which include '#'s and process h1, h2 and h3
+    const LineViews lines (resultStr);
+    const String dot (CharPointer_UTF8 ("\xc2\xb7"));
 
-    // doesn't extrct the title (h1) -- for article toc
-    // but when export a big-single html, it'll extrct all
-    lines.remove (0);
+    MemoryOutputStream tocStream;
+    bool titleSkipped = false;
+    int numItems = 0;
 
-    // process h1, h2 and h3
-    for (int i = lines.size(); --i >= 0; )
+    for (int i = 0; i < lines.size(); ++i)
     {
-        lines.getReference (i) = lines[i].trimStart();
+        const char* const lineEnd = lines.getEnd (i);
+        const char* const start = LineViews::skipSpaces (lines.getStart (i), lineEnd);
 
-        if (lines[i].substring (0, 2) == "# ")
-            lines.getReference (i) = "<a href=\"#" + lines[i].substring (2) + "\">"
-            + lines[i].substring (2) + "</a><br>";
+        if (!LineViews::startsWith (start, lineEnd, "#"))
+            continue;
 
-        else if (lines[i].substring (0, 3) == "## ")
-            lines.getReference (i) = " &emsp;&emsp;"
-            + String (CharPointer_UTF8 ("\xc2\xb7"))
-            + " <a href=\"#" + extractLinkText (lines[i].substring (3)) + "\">"
-            + extractLinkText (lines[i].substring (3)) + "</a><br>";
+        // doesn't extrct the title (h1) -- for article toc
+        // but when export a big-single html, it'll extrct all
+        if (!titleSkipped)
+        {
+            titleSkipped = true;
+            continue;
+        }
 
-        else if (lines[i].substring (0, 4) == "### ")
-            lines.getReference (i) = " &emsp;&emsp;&emsp;&emsp;"
-            + String (CharPointer_UTF8 ("\xc2\xb7"))
-            + " <a href=\"#"
-            + extractLinkText (lines[i].substring (4)) + "\">"
-            + extractLinkText (lines[i].substring (4)) + "</a><br>";
+        String itemStr;
 
+        if (LineViews::startsWith (start, lineEnd, "# "))
+        {
+            const String titleStr (LineViews::toString (start + 2, lineEnd));
+            itemStr = "<a href=\"#" + titleStr + "\">" + titleStr + "</a><br>";
+        }
+        else if (LineViews::startsWith (start, lineEnd, "## "))
+        {
+            const String titleStr (extractLinkText (LineViews::toString (start + 3, lineEnd)));
+            itemStr = " &emsp;&emsp;" + dot + " <a href=\"#" + titleStr + "\">" + titleStr + "</a><br>";
+        }
+        else if (LineViews::startsWith (start, lineEnd, "### "))
+        {
+            const String titleStr (extractLinkText (LineViews::toString (start + 4, lineEnd)));
+            itemStr = " &emsp;&emsp;&emsp;&emsp;" + dot + " <a href=\"#" + titleStr + "\">" + titleStr + "</a><br>";
+        }
         else
-            lines.remove (i);
+        {
+            continue;
+        }
+
+        if (numItems++ > 0)
+            tocStream << newLine;
+
+        tocStream << itemStr;
     }
 
-    const String tocContent ("<div class=toc>" + lines.joinIntoString (newLine) + "</div>");
+    const String tocContent ("<div class=toc>" + tocStream.toUTF8() + "</div>");
     resultStr = resultStr.replace ("[TOC]", tocContent);
     resultStr = resultStr.replace ("_@_tocParseReplaceStr_@_", "[TOC]");
     
@@ -774,91 +1057,158 @@ const String Md2Html::tocParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::processByLine (const String& mdString)
 {
-    StringArray contentByLine;
-    contentByLine.addLines (mdString);
-
-    for (int i = contentByLine.size(); --i >= 0; )
+    const Profiler::ScopedTimer timer ("md2html/byLine");
+    // <h6> ~ <h1>, also parse Chinese '#'
+    static const char* const headMarks[][2] =
     {
-        String& currentLine (contentByLine.getReference (i));
+        { "###### ", "\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83 " },
+        { "##### ",  "\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83 " },
+        { "#### ",   "\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83 " },
+        { "### ",    "\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83 " },
+        { "## ",     "\xef\xbc\x83\xef\xbc\x83 " },
+        { "# ",      "\xef\xbc\x83 " }
+    };
+
+    const LineViews lines (mdString);
+    MemoryOutputStream result ((size_t) mdString.getNumBytesAsUTF8() + 1024);
+
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        if (i > 0)
+            result << newLine;
+
+        const char* const lineStart = lines.getStart (i);
+        const char* const lineEnd = lines.getEnd (i);
+
+        // trimStart() and trim() of this line
+        const char* const start = LineViews::skipSpaces (lineStart, lineEnd);
+        const char* const end = LineViews::skipSpacesBackwards (start, lineEnd);
+
+        // head level (1 ~ 6) and the length of its mark, 0 for not a head
+        int headLevel = 0;
+        const char* afterMark = nullptr;
+
+        for (int m = 0; m < numElementsInArray (headMarks) && headLevel == 0; ++m)
+        {
+            for (int n = 0; n < 2; ++n)
+            {
+                if (LineViews::startsWith (start, lineEnd, headMarks[m][n]))
+                {
+                    headLevel = 6 - m;
+                    afterMark = start + strlen (headMarks[m][n]);
+                    break;
+                }
+            }
+        }
 
         // <hr>
-        if (currentLine.trimStart().substring (0, 3) == "---")
-            currentLine = "<hr>";
+        if (LineViews::startsWith (start, lineEnd, "---"))
+        {
+            result << "<hr>";
+        }
 
         // <blockquote>
-        else if (currentLine.trimStart().substring (0, 2) == "> ")
-            currentLine = "<blockquote>" + currentLine.trim().substring (2) + "</blockquote>";
-
-        // <h6> ~ <h1>, also parse Chinese '#'
-        else if (currentLine.trimStart().substring (0, 7) == "###### "
-                 || currentLine.trimStart().substring (0, 7) ==
-                 CharPointer_UTF8 ("\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83 "))
-            currentLine = "<h6>" + currentLine.trim().substring (7) + "</h6>";
-
-        else if (currentLine.trimStart().substring (0, 6) == "##### "
-                 || currentLine.trimStart().substring (0, 6) ==
-                 CharPointer_UTF8 ("\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83 "))
-            currentLine = "<h5>" + currentLine.trim().substring (6) + "</h5>";
-
-        else if (currentLine.trimStart().substring (0, 5) == "#### "
-                 || currentLine.trimStart().substring (0, 5) ==
-                 CharPointer_UTF8 ("\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83 "))
-            currentLine = "<h4>" + currentLine.trim().substring (5) + "</h4>";
-
-        // <h3> anchor
-        else if (currentLine.trimStart().substring (0, 4) == "### "
-                 || currentLine.trimStart().substring (0, 4) ==
-                 CharPointer_UTF8 ("\xef\xbc\x83\xef\xbc\x83\xef\xbc\x83 "))
-            currentLine = "<h3 id=\"" + extractLinkText (currentLine.trim().substring (4)) + "\">"
-            + currentLine.trim().substring (4) + "</h3>";
-
-        // <h2> anchor
-        else if (currentLine.trimStart().substring (0, 3) == "## "
-                 || currentLine.trimStart().substring (0, 3) ==
-                 CharPointer_UTF8 ("\xef\xbc\x83\xef\xbc\x83 "))
-            currentLine = "<h2 id=\"" + extractLinkText (currentLine.trim().substring (3)) + "\">"
-            + currentLine.trim().substring (3) + "</h2><hr>";
+        else if (LineViews::startsWith (start, lineEnd, "> "))
+        {
+            result << "<blockquote>";
+            LineViews::write (result, start + 2, end);
+            result << "</blockquote>";
+        }
+
+        // <h6> ~ <h4>
+        else if (headLevel >= 4)
+        {
+            result << "<h" << headLevel << ">";
+            LineViews::write (result, afterMark, end);
+            result << "</h" << headLevel << ">";
+        }
+
+        // <h3>, <h2> anchor
+        else if (headLevel == 3 || headLevel == 2)
+        {
+            const String titleStr (LineViews::toString (afterMark, end));
+
+            result << "<h" << headLevel << " id=\"" << extractLinkText (titleStr) << "\">" 
+                << titleStr << "</h" << headLevel << ">" << (headLevel == 2 ? "<hr>" : "");
+        }
 
         // <h1> anchor
-        else if (currentLine.trimStart().substring (0, 2) == "# "
-                 || currentLine.trimStart().substring (0, 2) ==
-                 CharPointer_UTF8 ("\xef\xbc\x83 "))
-            currentLine = "<h1 id=\"" + currentLine.trim().substring (2) + "\">"
-            + currentLine.trim().substring (2) + "</h1>";
+        else if (headLevel == 1)
+        {
+            result << "<h1 id=\"";
+            LineViews::write (result, afterMark, end);
+            result << "\">";
+            LineViews::write (result, afterMark, end);
+            result << "</h1>";
+        }
 
         // align
-        else if (currentLine.trimStart().substring (0, 4) == "(^) ")
-            currentLine = "<div style=\"text-indent:-1em; text-align:center;\">" + currentLine.trim().substring (4) + "</div>";
+        else if (LineViews::startsWith (start, lineEnd, "(^) "))
+        {
+            result << "<div style=\"text-indent:-1em; text-align:center;\">";
+            LineViews::write (result, start + 4, end);
+            result << "</div>";
+        }
 
-        else if (currentLine.trimStart().substring (0, 4) == "(>) ")
-            currentLine = "<div style=\"text-align:right;\">" + currentLine.trim().substring (4) + "</div>";
+        else if (LineViews::startsWith (start, lineEnd, "(>) "))
+        {
+            result << "<div style=\"text-align:right;\">";
+            LineViews::write (result, start + 4, end);
+            result << "</div>";
+        }
 
         // diagram description
-        else if (currentLine.trimStart().substring (0, 3) == "^^ ")
-            currentLine = "<h5 style=\"text-indent:-1em; text-align:center;\">" + currentLine.trim().substring (3) + "</h5>";
+        else if (LineViews::startsWith (start, lineEnd, "^^ "))
+        {
+            result << "<h5 style=\"text-indent:-1em; text-align:center;\">";
+            LineViews::write (result, start + 3, end);
+            result << "</h5>";
+        }
 
         // indent (it might be inside a table)
-        else if (currentLine.trimStart().substring (0, 4) == "(+) ")
-            currentLine = "<div style=\"text-indent: 2em; padding: 0;\">"
-            + currentLine.trim().substring (4) + "</div>";
+        else if (LineViews::startsWith (start, lineEnd, "(+) "))
+        {
+            result << "<div style=\"text-indent: 2em; padding: 0;\">";
+            LineViews::write (result, start + 4, end);
+            result << "</div>";
+        }
 
-        else if (currentLine.trimStart().substring (4, 8) == "(+) ")
-            currentLine = currentLine.trim().substring (0, 4)
-            + "<div style=\"text-indent: 2em; padding: 0;\">"
-            + currentLine.trim().substring (8) + "</div>";
+        else if (LineViews::startsWith (LineViews::skipChars (start, lineEnd, 4), lineEnd, "(+) "))
+        {
+            const char* const markStart = LineViews::skipChars (start, lineEnd, 4);
 
-        else if (currentLine.trimStart().substring (8, 12) == "(+) ")
-            currentLine = currentLine.trim().substring (0, 8)
-            + "<div style=\"text-indent: 2em; padding: 0;\">"
-            + currentLine.trim().substring (12) + "</div>";
+            LineViews::write (result, start, jmin (markStart, end));
+            result << "<div style=\"text-indent: 2em; padding: 0;\">";
+            LineViews::write (result, markStart + 4, end);
+            result << "</div>";
+        }
+
+        else if (LineViews::startsWith (LineViews::skipChars (start, lineEnd, 8), lineEnd, "(+) "))
+        {
+            const char* const markStart = LineViews::skipChars (start, lineEnd, 8);
+
+            LineViews::write (result, start, jmin (markStart, end));
+            result << "<div style=\"text-indent: 2em; padding: 0;\">";
+            LineViews::write (result, markStart + 4, end);
+            result << "</div>";
+        }
 
         // anti-indent
-        else if (currentLine.trimStart().substring (0, 4) == "(-) ")
-            currentLine = "<div style=\"text-indent: 0; padding: 0;\">" 
-            + currentLine.trim().substring (4) + "</div>";
+        else if (LineViews::startsWith (start, lineEnd, "(-) "))
+        {
+            result << "<div style=\"text-indent: 0; padding: 0;\">";
+            LineViews::write (result, start + 4, end);
+            result << "</div>";
+        }
+
+        // nothing to do
+        else
+        {
+            LineViews::write (result, lineStart, lineEnd);
+        }
     }
 
-    return contentByLine.joinIntoString (newLine);
+    return result.toUTF8();
 }
 
 //=================================================================================================
@@ -898,6 +1248,7 @@ const String Md2Html::spaceLinkParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::imageParse (const String& mdString)
 {
+    const Profiler::ScopedTimer timer ("md2html/image");
     /**< ![](media/xxx.jpg =500) */
     String resultStr (mdString);
     int indexStart = resultStr.indexOf (0, "![");
@@ -1031,6 +1382,7 @@ const String Md2Html::videoParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::mdLinkParse (const String& mdString)
 {
+    const Profiler::ScopedTimer timer ("md2html/link");
     // [](http://xxx.com)
     String resultStr (mdString);
     int linkPathStart = resultStr.indexOf (0, "](");
@@ -1091,61 +1443,93 @@ const String Md2Html::mdLinkParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::listParse (const String& mdString, const bool isOrdered)
 {
-    StringArray contentByLine;
-    contentByLine.addLines (mdString.replace ("\\- ", "%^&listEscape&^%")); // escape
+    const Profiler::ScopedTimer timer ("md2html/list");
+    const String escapedStr (mdString.replace ("\\- ", "%^&listEscape&^%")); // escape
+    const LineViews lines (escapedStr);
+
+    const char* const nestTag = (isOrdered ? "    + " : "    - ");
+    const char* const nestedStart = (isOrdered ? "    <ol>" : "    <ul>");
+    const char* const nestedEnd = (isOrdered ? "    </ol>" : "    </ul>");
+    const char* const listTag = (isOrdered ? "+ " : "- ");
+    const char* const listStart = (isOrdered ? "<ol>" : "<ul>");
+    const char* const listEnd = (isOrdered ? "</ol>" : "</ul>");
+
+    // what the previous line looks like after it has been processed. 
+    // all false for the first line
+    bool prevIsNestItem = false;         // begin with nestTag
+    bool prevIsNestedOrItem = false;     // begin with nestedStart or "    <li>"
+    bool prevIsListItem = false;         // begin with listTag
+    bool prevIsItemOrListStart = false;  // begin with "<li>" or listStart after trimStart()
+
+    MemoryOutputStream result ((size_t) escapedStr.getNumBytesAsUTF8() + 1024);
+
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        if (i > 0)
+            result << newLine;
 
-    contentByLine.insert (0, "%%__ordered@List@Parse__%%");
-    contentByLine.add ("%%__ordered@List@Parse__%%");
+        const char* const start = lines.getStart (i);
+        const char* const end = lines.getEnd (i);
 
-    for (int i = 1; i < contentByLine.size() - 1; ++i)
-    {
-        const String& prevLine = contentByLine.getReference (i - 1);
-        const String& nextLine = contentByLine.getReference (i + 1);
-        String& currentLine (contentByLine.getReference (i));
-        String prefix, postfix;
+        const char* const nextStart = (i + 1 < lines.size()) ? lines.getStart (i + 1) : end;
+        const char* const nextEnd = (i + 1 < lines.size()) ? lines.getEnd (i + 1) : end;
 
-        const String nestTag (isOrdered ? "    + " : "    - ");
-        const String nestedStart (isOrdered ? "    <ol>" : "    <ul>");
-        const String nestedEnd (isOrdered ? "    </ol>" : "    </ul>");
-        const String listTag (isOrdered ? "+ " : "- ");
-        const String listStart (isOrdered ? "<ol>" : "<ul>");
-        const String listEnd (isOrdered ? "</ol>" : "</ul>");
+        const bool nextIsNestItem = LineViews::startsWith (nextStart, nextEnd, nestTag);
+        const bool nextIsListItem = LineViews::startsWith (nextStart, nextEnd, listTag);
 
-        if (currentLine.substring (0, 6) == nestTag)
+        if (LineViews::startsWith (start, end, nestTag))
         {
-            if (prevLine.substring (0, 6) != nestTag
-                && prevLine.substring (0, 8) != nestedStart
-                && prevLine.substring (0, 8) != "    <li>")
-                prefix = nestedStart;
-            if (nextLine.substring (0, 6) != nestTag)
-                postfix = nestedEnd;
+            const bool needPostfix = !nextIsNestItem;
+
+            if (!prevIsNestItem && !prevIsNestedOrItem)
+                result << nestedStart;
 
-            currentLine = prefix + "    <li>" + currentLine.fromFirstOccurrenceOf (nestTag, false, false) + "</li>" + postfix;
+            result << "    <li>";
+            LineViews::write (result, start + strlen (nestTag), end);
+            result << "</li>" << (needPostfix ? nestedEnd : "");
+
+            // the end of the nested list, also the end of its outside list
+            if (needPostfix && !nextIsListItem)
+                result << listEnd;
+
+            prevIsNestItem = false;
+            prevIsNestedOrItem = true;
+            prevIsListItem = false;
+            prevIsItemOrListStart = true;
         }
-        else if (currentLine.substring (0, 2) == listTag)
+        else if (LineViews::startsWith (start, end, listTag))
         {
-            if (prevLine.substring (0, 2) != listTag
-                && prevLine.trimStart().substring (0, 4) != "<li>"
-                && prevLine.trimStart().substring (0, 4) != listStart)
-                prefix = listStart;
-            if (nextLine.substring (0, 2) != listTag
-                && nextLine.substring (0, 6) != nestTag)
-                postfix = listEnd;
+            if (!prevIsListItem && !prevIsItemOrListStart)
+                result << listStart;
 
-            currentLine = prefix + "<li>" + currentLine.fromFirstOccurrenceOf (listTag, false, false) + "</li>" + postfix;
-        }
+            result << "<li>";
+            LineViews::write (result, start + strlen (listTag), end);
+            result << "</li>" << ((!nextIsListItem && !nextIsNestItem) ? listEnd : "");
 
-        if ((currentLine.substring (0, 8) == "    <li>"
-             || currentLine.substring (0, 8) == nestedStart)
-            && currentLine.getLastCharacters (5) == listEnd
-            && nextLine.substring (0, 2) != listTag)
+            prevIsNestItem = false;
+            prevIsNestedOrItem = false;
+            prevIsListItem = false;
+            prevIsItemOrListStart = true;
+        }
+        else
         {
-            currentLine += listEnd;
+            const char* const trimmedStart = LineViews::skipSpaces (start, end);
+
+            prevIsNestItem = false;
+            prevIsNestedOrItem = (LineViews::startsWith (start, end, nestedStart)
+                                  || LineViews::startsWith (start, end, "    <li>"));
+            prevIsListItem = false;
+            prevIsItemOrListStart = (LineViews::startsWith (trimmedStart, end, "<li>")
+                                     || LineViews::startsWith (trimmedStart, end, listStart));
+
+            LineViews::write (result, start, end);
+
+            if (prevIsNestedOrItem && LineViews::endsWith (start, end, listEnd) && !nextIsListItem)
+                result << listEnd;
         }
     }
 
-    contentByLine.removeString ("%%__ordered@List@Parse__%%");
-    return contentByLine.joinIntoString (newLine);
+    return result.toUTF8();
 }
 
 //=================================================================================================
@@ -1180,133 +1564,314 @@ const String Md2Html::cnBracketParse (const String& mdString)
 //=================================================================================================
 const String Md2Html::cleanUp (const String& mdString)
 {
-    // transform newLine to <p> and <br>
-    String&& resultStr (mdString
-                      .replace (newLine + newLine, "<p>\n")
-                      .replace (newLine, "<br>\n"));
+    const Profiler::ScopedTimer timer ("md2html/cleanUp");
+    String resultStr (lineBreakParse (mdString));
+    resultStr = tagAndEscapeParse (resultStr);
+
+    // for scroll to bottom
+    resultStr += newLine + "<span id=\"wdtpPageBottom\"></span>";
 
-    // parse linespacing
-    linespacingParse (resultStr);
+    //DBG (resultStr);
+    return resultStr;
+}
 
-    // clean extra <br> when it's after any html-tag
-    int indexBr = resultStr.indexOf (0, "<br>");
+//=================================================================================================
+const String Md2Html::lineBreakParse (const String& mdString)
+{
+    const char* const text = mdString.toRawUTF8();
+    const int numBytes = (int) mdString.getNumBytesAsUTF8();
 
-    while (indexBr != -1)
-    {
-        if (resultStr.substring (indexBr - 1, indexBr) == ">"
-            // prevent extra empty row of code-block (the first row of it)
-            && resultStr.substring (indexBr - 2, indexBr) != "\">")
-            resultStr = resultStr.replaceSection (indexBr, 4, newLine);
+    // '\(|)' and '\(||)' only be the escape when there's any linespacing mark
+    const bool hasLinespacing = (strstr (text, "(|)") != nullptr || strstr (text, "(||)") != nullptr);
 
-        indexBr = resultStr.indexOf (indexBr + 4, "<br>");
-    }
+    MemoryOutputStream result ((size_t) numBytes + (size_t) numBytes / 4);
+
+    // the last 2 chars before the current position, but it's what they were before
+    // the <p> and <br> inside code-block and js-code had been removed.
+    // an extra <br> is only judged by them.
+    char last = 0, beforeLast = 0;
 
-    // clean extra <p> and <br> of code-block(s)
-    int indexCodeStart = resultStr.indexOf (0, "<pre><code class=");
+    int copiedUpTo = 0;
+    int blockEnd = -1;  // end of the current code-block or js-code, -1 for outside
+    int i = 0;
 
-    while (indexCodeStart != -1 && indexCodeStart + 20 <= resultStr.length())
+    while (i < numBytes)
     {
-        const int indexCodeEnd = resultStr.indexOf (indexCodeStart + 20, "</code></pre>");
+        const char* const p = text + i;
 
-        if (indexCodeEnd == -1)
-            break;
+        if (blockEnd >= 0 && i >= blockEnd)
+            blockEnd = -1;
 
-        const String mdCode (resultStr.substring (indexCodeStart, indexCodeEnd));
-        const String codeHtml (mdCode.replace ("<p>", newLine).replace ("<br>", String()));
+        // check the mark at this position
+        const char* mark = nullptr;
+        int markLength = 0;
+        bool isParagraph = false;
+        bool isNewLine = false;
 
-        resultStr = resultStr.replaceSection (indexCodeStart, mdCode.length(), codeHtml);
-        indexCodeStart = resultStr.indexOf (indexCodeStart + 33, "<pre><code class=");
-    }
+        if (*p == '\r' && strncmp (p, "\r\n\r\n", 4) == 0)
+        {
+            isParagraph = isNewLine = true;
+            markLength = 4;
+        }
+        else if (*p == '\r' && p[1] == '\n')
+        {
+            isNewLine = true;
+            markLength = 2;
+        }
+        else if (*p == '<' && strncmp (p, "<p>", 3) == 0)
+        {
+            isParagraph = true;
+            markLength = 3;
+        }
+        else if (*p == '<' && strncmp (p, "<br>", 4) == 0)
+        {
+            markLength = 4;
+        }
+        else if (*p == '<' && blockEnd < 0)
+        {
+            // code-block and page's js-code: their <p> and <br> need to be cleaned
+            const char* blockEndPtr = nullptr;
 
-    // clean extra <p> and <br> of page's js-code (inside <body/>)
-    indexCodeStart = resultStr.indexOf (0, "<script");
+            if (strncmp (p, "<pre><code class=", 17) == 0)
+                blockEndPtr = strstr (p + 17, "</code></pre>");
+            else if (strncmp (p, "<script", 7) == 0)
+                blockEndPtr = strstr (p + 7, "</script>");
 
-    while (indexCodeStart != -1 && indexCodeStart + 8 <= resultStr.length())
-    {
-        const int indexCodeEnd = resultStr.indexOf (indexCodeStart + 8, "</script>");
+            blockEnd = (blockEndPtr != nullptr) ? (int) (blockEndPtr - text) : -1;
+        }
+        else if (hasLinespacing && (*p == '(' || *p == '\\'))
+        {
+            // '(|)', '(||)': increase line-spacing
+            static const char* const linespacings[][2] =
+            {
+                { "\\(|)",  "(|)" },
+                { "\\(||)", "(||)" },
+                { "(|)",    "<div style=\"height:2em;\"></div>" },
+                { "(||)",   "<div style=\"height:4em;\"></div>" }
+            };
 
-        if (indexCodeEnd == -1)
-            break;
+            for (int m = 0; m < numElementsInArray (linespacings); ++m)
+            {
+                const int length = (int) strlen (linespacings[m][0]);
 
-        const String jsCode (resultStr.substring (indexCodeStart, indexCodeEnd));
-        const String codeHtml (jsCode.replace ("<p>", newLine).replace ("<br>", String()));
+                if (strncmp (p, linespacings[m][0], (size_t) length) == 0)
+                {
+                    mark = linespacings[m][1];
+                    markLength = length;
+                    isParagraph = (m >= 2);  // followed by a <p>
+                    break;
+                }
+            }
+        }
 
-        resultStr = resultStr.replaceSection (indexCodeStart, jsCode.length(), codeHtml);
-        indexCodeStart = resultStr.indexOf (indexCodeStart + 17, "<script");
-    }
+        if (markLength == 0)
+        {
+            ++i;
+            continue;
+        }
 
-    // clean up empty line in table
-    resultStr = resultStr.replace ("\n\n<td>", "\n<td>")
-        .replace ("\n<tr>", "<tr>")
-        .replace ("</tr>\n", "<tr>")
-        .replace ("\n</table>", "</table>");
-
-    // clean extra <br> and <p> which before <pre><code>
-    resultStr = resultStr.replace ("<br>\n<pre>", newLine + "<pre>")
-        .replace ("<p>\n<pre>", newLine + "<pre>");
-
-    // make the <pre><code> at the same line with the code
-    // otherwise the vertical-gap will too wide
-    resultStr = resultStr.replace (String ("<pre><code>") + newLine, "<pre><code>");
-
-    // give it a <p> after '<hr>' and '</code></pre>'
-    //resultStr = resultStr.replace (String ("</table>") + newLine, "</table><p>");
-    resultStr = resultStr.replace (String ("<hr>") + newLine, "<hr>\n<p>");
-    resultStr = resultStr.replace (String ("</code></pre>") + newLine, "</code></pre>\n<p>");
-
-    // for escape
-    resultStr = resultStr.replace ("\\*", "*");
-    resultStr = resultStr.replace ("\\(", "(");
-    resultStr = resultStr.replace ("\\~", "~");
-    resultStr = resultStr.replace ("\\`", "`");
-    resultStr = resultStr.replace ("\\```", "```");
-    resultStr = resultStr.replace ("\\#", "#");
-    resultStr = resultStr.replace ("\\[TOP]", "@@##ToTOPOfThePage##@@");  // escape for [TOP]
-    resultStr = resultStr.replace ("\\[", "[");
-    resultStr = resultStr.replace ("\\![", "![");
-    resultStr = resultStr.replace ("\\~[", "~[");
-    resultStr = resultStr.replace ("\\@[", "@[");
-    resultStr = resultStr.replace ("\\[^", "[^");
-    resultStr = resultStr.replace ("\\]", "]");
-    resultStr = resultStr.replace ("\\/", "/");
-    resultStr = resultStr.replace ("%^&listEscape&^%", "- ");    
-    resultStr = resultStr.replace ("<p><br>", "<p>"); 
-    resultStr = resultStr.replace ("<!--<br>", "<!--");
-    resultStr = resultStr.replace ("<!--<p>", "<!--");
-    resultStr = resultStr.replace ("_%7x|z%!@@!_", "---");      // see code block parse
+        // copy the text before the mark
+        if (i - copiedUpTo >= 2)
+        {
+            beforeLast = text[i - 2];
+            last = text[i - 1];
+        }
+        else if (i - copiedUpTo == 1)
+        {
+            beforeLast = last;
+            last = text[i - 1];
+        }
 
-    // parse [TOP]: a html-button on page for 'back to top'
-    resultStr = resultStr.replace ("[TOP]", "<div class=page_navi id=right><a href=\"#top\">" 
-                                   + TRANS ("Back to Top") + "</a></div>");
-    resultStr = resultStr.replace ("@@##ToTOPOfThePage##@@", "[TOP]");
+        result.write (text + copiedUpTo, (size_t) (i - copiedUpTo));
 
-    // font-size, color, font-name
-    if (resultStr.contains ("</>"))
-    {
-        resultStr = resultStr.replace ("<size=", "<span style=font-size:")
-            .replace ("<color=", "<span style=color:")
-            .replace ("<font=", "<span style=font-family:")
-            .replace ("</>", "</span>");
+        const bool insideBlock = (blockEnd >= 0);
+
+        if (mark != nullptr)
+        {
+            result << mark;
+
+            const int length = (int) strlen (mark);
+            beforeLast = (length >= 2) ? mark[length - 2] : last;
+            last = mark[length - 1];
+        }
+
+        if (isParagraph)
+        {
+            result << (insideBlock ? "\r\n" : "<p>");
+            beforeLast = 'p';
+            last = '>';
+        }
+        else if (mark != nullptr)
+        {
+            // escaped linespacing mark, nothing more to do
+        }
+        else if (last == '>' && beforeLast != '"')
+        {
+            // clean extra <br> when it's after any html-tag, 
+            // but not the first row of a code-block (prevent an extra empty row)
+            result << "\r\n";
+            beforeLast = '\r';
+            last = '\n';
+        }
+        else
+        {
+            if (!insideBlock)
+                result << "<br>";
+
+            beforeLast = 'r';
+            last = '>';
+        }
+
+        if (isNewLine)
+        {
+            result << "\n";
+            beforeLast = last;
+            last = '\n';
+        }
+
+        i += markLength;
+        copiedUpTo = i;
     }
 
-    // for scroll to bottom
-    resultStr += newLine + "<span id=\"wdtpPageBottom\"></span>";
+    result.write (text + copiedUpTo, (size_t) (numBytes - copiedUpTo));
 
-    //DBG (resultStr);
-    return resultStr;
+    return result.toUTF8();
 }
 
 //=================================================================================================
-void Md2Html::linespacingParse (String& mdString)
+const String Md2Html::tagAndEscapeParse (const String& htmlString)
 {
-    if (mdString.contains ("(|)") || mdString.contains ("(||)"))
+    const char* const text = htmlString.toRawUTF8();
+    const int numBytes = (int) htmlString.getNumBytesAsUTF8();
+
+    // at each position, the first matched one wins
+    static const char* const replaces[][2] =
+    {
+        // clean up empty line in table
+        { "\n\n<td>",   "\n<td>" },
+        { "</tr>\n<tr>", "</tr><tr>" },    // must before the next two
+        { "\n<tr>",     "<tr>" },
+        { "</tr>\n",    "<tr>" },
+        { "\n</table>", "</table>" },
+
+        // clean extra <br> and <p> which before <pre><code>
+        { "<br>\n<pre>", "\r\n<pre>" },
+        { "<p>\n<pre>",  "\r\n<pre>" },
+
+        // make the <pre><code> at the same line with the code
+        // otherwise the vertical-gap will too wide
+        { "<pre><code>\r\n", "<pre><code>" },
+
+        // give it a <p> after '<hr>' and '</code></pre>'
+        { "<hr>\r\n",          "<hr>\n<p>" },
+        { "</code></pre>\r\n", "</code></pre>\n<p>" },
+
+        // for escape, '\[TOP]' must before '\['
+        { "\\[TOP]", "[TOP]" },
+        { "\\![",    "![" },
+        { "\\*",     "*" },
+        { "\\(",     "(" },
+        { "\\~",     "~" },
+        { "\\`",     "`" },
+        { "\\#",     "#" },
+        { "\\@[",    "@[" },
+        { "\\[",     "[" },
+        { "\\]",     "]" },
+        { "\\/",     "/" },
+        { "%^&listEscape&^%", "- " },
+        { "<p><br>",  "<p>" },
+        { "<!--<br>", "<!--" },
+        { "<!--<p>",  "<!--" },
+        { "_%7x|z%!@@!_", "---" }   // see code block parse
+    };
+
+    // font-size, color, font-name
+    static const char* const fontReplaces[][2] =
+    {
+        { "<size=",  "<span style=font-size:" },
+        { "<color=", "<span style=color:" },
+        { "<font=",  "<span style=font-family:" },
+        { "</>",     "</span>" },
+        { "<\\/>",   "</span>" }
+    };
+
+    const bool hasFontMark = (strstr (text, "</>") != nullptr || strstr (text, "<\\/>") != nullptr);
+
+    // parse [TOP]: a html-button on page for 'back to top'
+    const String toTop ("<div class=page_navi id=right><a href=\"#top\">" 
+                        + TRANS ("Back to Top") + "</a></div>");
+
+    MemoryOutputStream result ((size_t) numBytes + (size_t) numBytes / 8);
+    int copiedUpTo = 0;
+    int i = 0;
+
+    while (i < numBytes)
     {
-        mdString = mdString.replace ("\\(|)", "_##@|)").replace ("\\(||)", "_###@||)")
-            .replace ("(|)", "<div style=\"height:2em;\"></div><p>")
-            .replace ("(||)", "<div style=\"height:4em;\"></div><p>");
+        const char* const p = text + i;
+
+        if (*p != '\n' && *p != '<' && *p != '\\' && *p != '%' && *p != '_' && *p != '[')
+        {
+            ++i;
+            continue;
+        }
+
+        const char* replaceWith = nullptr;
+        int matchedLength = 0;
+
+        for (int m = 0; m < numElementsInArray (replaces) && matchedLength == 0; ++m)
+        {
+            const int length = (int) strlen (replaces[m][0]);
+
+            if (*p == replaces[m][0][0] && strncmp (p, replaces[m][0], (size_t) length) == 0)
+            {
+                replaceWith = replaces[m][1];
+                matchedLength = length;
+            }
+        }
+
+        for (int m = 0; hasFontMark && m < numElementsInArray (fontReplaces) && matchedLength == 0; ++m)
+        {
+            const int length = (int) strlen (fontReplaces[m][0]);
 
-        mdString = mdString.replace ("_##@|)", "(|)").replace ("_###@||)", "(||)");
+            if (*p == fontReplaces[m][0][0] && strncmp (p, fontReplaces[m][0], (size_t) length) == 0)
+            {
+                replaceWith = fontReplaces[m][1];
+                matchedLength = length;
+            }
+        }
+
+        if (matchedLength == 0 && strncmp (p, "[TOP]", 5) == 0)
+            matchedLength = 5;
+
+        if (matchedLength == 0)
+        {
+            ++i;
+            continue;
+        }
+
+        result.write (text + copiedUpTo, (size_t) (i - copiedUpTo));
+
+        if (replaceWith != nullptr)
+            result << replaceWith;
+        else
+            result << toTop;
+
+        i += matchedLength;
+
+        // the <p> after '<hr>' and '</code></pre>' doesn't need the <br> which followed it
+        if (replaceWith != nullptr && strlen (replaceWith) > 3
+            && strcmp (replaceWith + strlen (replaceWith) - 3, "<p>") == 0
+            && strncmp (text + i, "<br>", 4) == 0)
+        {
+            i += 4;
+        }
+
+        copiedUpTo = i;
     }
+
+    result.write (text + copiedUpTo, (size_t) (numBytes - copiedUpTo));
+
+    return result.toUTF8();
 }
 
 //=================================================================================================
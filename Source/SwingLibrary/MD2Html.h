@@ -18,6 +18,41 @@ public:
     static const String mdStringToHtml (const String& mdString);
 
 private:
+    /** the marks which decide the parse stages of mdStringToHtml() */
+    enum MarkFlag
+    {
+        postilMark          = 1 << 0,   /**< )[ */
+        tableStyleMark      = 1 << 1,   /**< ------, ====== or ////// */
+        tableCellMark       = 1 << 2,   /**< ' | ' */
+        commentMark         = 1 << 3,   /**< ////// */
+        backquoteMark       = 1 << 4,   /**< ` */
+        codeBlockMark       = 1 << 5,   /**< ``` */
+        endnoteMark         = 1 << 6,   /**< [^ */
+        asteriskMark        = 1 << 7,   /**< * */
+        twoAsterisksMark    = 1 << 8,   /**< ** */
+        threeAsterisksMark  = 1 << 9,   /**< *** */
+        identifierMark      = 1 << 10,  /**< ****** */
+        highlightMark       = 1 << 11,  /**< ~~ */
+        hybridMark          = 1 << 12,  /**< ~~~ */
+        tocMark             = 1 << 13,  /**< [TOC] */
+        spaceLinkMark       = 1 << 14,  /**< ' http' */
+        imageMark           = 1 << 15,  /**< ![ */
+        audioMark           = 1 << 16,  /**< ~[]( */
+        videoMark           = 1 << 17,  /**< @[]( */
+        linkMark            = 1 << 18,  /**< ]( */
+        orderedListMark     = 1 << 19,  /**< '+ ' */
+        unorderedListMark   = 1 << 20,  /**< '- ' */
+        cnBracketMark       = 1 << 21   /**< Chinese left bracket */
+    };
+
+    /** scan the doc only once and return all the marks (see MarkFlag) it has.
+        instead of a contains() for each stage which searches the whole doc again and again. */
+    static const int scanMarks (const String& mdString);
+
+    /** the block parsers (table, list, toc, hybrid and by-line) share it, 
+        so that they needn't a String for each line. see MD2Html.cpp */
+    class LineViews;
+
     //=================================================================================================
     // call these methods must according to the below order
 
@@ -140,9 +175,13 @@ private:
     /** include [TOP] parse */
     static const String cleanUp (const String& mdString);
 
-    /** '(|), (||)': increase line-spacing. 
+    /** scan once: newLine to <p> and <br>, '(|), (||)' for increase line-spacing,
+        clean the extra <br> after html-tag and the <p>, <br> inside code-block and js-code. 
         NOTE: this method must be called at the begin of cleanup(). */
-    static void linespacingParse (String& mdString);
+    static const String lineBreakParse (const String& mdString);
+
+    /** scan once: tag fixes, escapes, [TOP] and font-size/color/font-name. see the table inside. */
+    static const String tagAndEscapeParse (const String& htmlString);
 
 public:
     /** extract the text which first encountered in '[]'. 
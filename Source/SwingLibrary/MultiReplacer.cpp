@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    MultiReplacer.cpp
+    Created: 19 Oct 2026 9:12:40am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+#include "MultiReplacer.h"
+
+//=================================================================================================
+MultiReplacer::MultiReplacer (const StringArray& targets, const StringArray& replacements)
+{
+    jassert (targets.size() == replacements.size());
+
+    nodes.add (new Node());  // root
+
+    for (int i = 0; i < targets.size(); ++i)
+        addTarget (targets[i], replacements[i]);
+
+    buildFailLinks();
+}
+
+//=================================================================================================
+void MultiReplacer::addTarget (const String& target, const String& replacement)
+{
+    if (target.isEmpty())
+        return;
+
+    // the automaton works on UTF-8 bytes. since a UTF-8 lead byte never equals to
+    // a continuation byte, a match always begins and ends at a character boundary.
+    const uint8* bytes = (const uint8*) target.toRawUTF8();
+    const int numBytes = (int) target.getNumBytesAsUTF8();
+    int state = 0;
+
+    for (int i = 0; i < numBytes; ++i)
+    {
+        int child = getChild (state, bytes[i]);
+
+        if (child < 0)
+        {
+            child = nodes.size();
+            Node* newNode = nodes.add (new Node());
+            newNode->depth = nodes[state]->depth + 1;
+
+            nodes[state]->keys.add (bytes[i]);
+            nodes[state]->children.add (child);
+        }
+
+        state = child;
+    }
+
+    // duplicated target, the first one wins
+    if (nodes[state]->output >= 0)
+        return;
+
+    nodes[state]->output = replaceStrs.size();
+    nodes[state]->outputLength = numBytes;
+    replaceStrs.add (replacement);
+}
+
+//=================================================================================================
+void MultiReplacer::buildFailLinks()
+{
+    // breadth-first, so that the fail-node of each node has been done before itself
+    Array<int> queue (nodes[0]->children);
+
+    for (int head = 0; head < queue.size(); ++head)
+    {
+        const Node* parent = nodes[queue[head]];
+
+        for (int i = 0; i < parent->children.size(); ++i)
+        {
+            const int childIndex = parent->children[i];
+            Node* child = nodes[childIndex];
+
+            child->fail = (queue[head] == 0) ? 0 : getNextState (parent->fail, parent->keys[i]);
+
+            // non-end node: inherit the longest target which is a suffix of this node
+            if (child->output < 0)
+            {
+                child->output = nodes[child->fail]->output;
+                child->outputLength = nodes[child->fail]->outputLength;
+            }
+
+            queue.add (childIndex);
+        }
+    }
+}
+
+//=================================================================================================
+const int MultiReplacer::getChild (const int nodeIndex, const uint8 key) const
+{
+    const Node* node = nodes.getUnchecked (nodeIndex);
+    const int index = node->keys.indexOf (key);
+
+    return (index >= 0) ? node->children.getUnchecked (index) : -1;
+}
+
+//=================================================================================================
+const int MultiReplacer::getNextState (int state, const uint8 key) const
+{
+    for (;;)
+    {
+        const int child = getChild (state, key);
+
+        if (child >= 0)
+            return child;
+
+        if (state == 0)
+            return 0;
+
+        state = nodes.getUnchecked (state)->fail;
+    }
+}
+
+//=================================================================================================
+const String MultiReplacer::replaceAll (const String& source) const
+{
+    if (replaceStrs.size() == 0 || source.isEmpty())
+        return source;
+
+    const uint8* const text = (const uint8*) source.toRawUTF8();
+    const int numBytes = (int) source.getNumBytesAsUTF8();
+
+    MemoryOutputStream result ((size_t) numBytes + (size_t) numBytes / 4);
+
+    int copiedUpTo = 0;     // all bytes before it have been written
+    int matchStart = -1;    // the pending (leftmost-longest) match
+    int matchLength = 0;
+    int matchIndex = -1;
+    int state = 0;
+    int i = 0;
+
+    for (;;)
+    {
+        if (i < numBytes)
+        {
+            state = getNextState (state, text[i]);
+            const Node* node = nodes.getUnchecked (state);
+
+            // a later end with the same (or an earlier) start means it's longer
+            if (node->output >= 0)
+            {
+                const int start = i + 1 - node->outputLength;
+
+                if (matchIndex < 0 || start <= matchStart)
+                {
+                    matchStart = start;
+                    matchLength = node->outputLength;
+                    matchIndex = node->output;
+                }
+            }
+
+            // take the pending match only when no match could start before it any more
+            if (matchIndex < 0 || matchStart >= i + 1 - node->depth)
+            {
+                ++i;
+                continue;
+            }
+        }
+        else if (matchIndex < 0)
+        {
+            break;
+        }
+
+        // write the pending match, then go on from its end
+        result.write (text + copiedUpTo, (size_t) (matchStart - copiedUpTo));
+        result << replaceStrs[matchIndex];
+
+        copiedUpTo = matchStart + matchLength;
+        i = copiedUpTo;
+        state = 0;
+        matchIndex = -1;
+    }
+
+    result.write (text + copiedUpTo, (size_t) (numBytes - copiedUpTo));
+
+    return result.toUTF8();
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    MultiReplacer.h
+    Created: 19 Oct 2026 9:12:40am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef MULTIREPLACER_H_INCLUDED
+#define MULTIREPLACER_H_INCLUDED
+
+/** Replace lots of different strings in a single pass, based on Aho-Corasick automaton.
+
+    The source will be scanned from left to right only once. If several targets start
+    at the same position, the longest one wins. A replaced piece will never be matched
+    again, so the result doesn't depend on the order of the targets.
+
+    The automaton is built in the constructor and never be changed after that,
+    so an object could be shared and used by several threads at the same time.
+
+    Usage: create it once, keep it (see Ptr), then call replaceAll() as many times as you like.
+*/
+class MultiReplacer : public ReferenceCountedObject
+{
+public:
+    /** arg-1 and arg-2 must have the same size. the matching is case-sensitive.
+        empty target will be ignored, and for duplicated targets, the first one wins. */
+    MultiReplacer (const StringArray& targets, const StringArray& replacements);
+    ~MultiReplacer() { }
+
+    typedef ReferenceCountedObjectPtr<MultiReplacer> Ptr;
+
+    const String replaceAll (const String& source) const;
+    const int getNumTargets() const          { return replaceStrs.size(); }
+
+private:
+    //=================================================================================================
+    struct Node
+    {
+        Node() : fail (0), depth (0), output (-1), outputLength (0) { }
+
+        Array<uint8> keys;
+        Array<int> children;
+
+        int fail, depth;
+
+        // index of the longest target which ends at this node (include the ones via fail-link),
+        // -1 for none. outputLength is its length in bytes.
+        int output, outputLength;
+    };
+
+    void addTarget (const String& target, const String& replacement);
+    void buildFailLinks();
+
+    const int getChild (const int nodeIndex, const uint8 key) const;
+    const int getNextState (int state, const uint8 key) const;
+
+    //=================================================================================================
+    OwnedArray<Node> nodes;
+    StringArray replaceStrs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiReplacer)
+};
+
+#endif  // MULTIREPLACER_H_INCLUDED
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+    Profiler.cpp
+    Created: 20 Oct 2026 3:47:26am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+#include "Profiler.h"
+
+//=================================================================================================
+Profiler::ScopedTimer::ScopedTimer (const char* stageName_, const String& itemName_)
+    : stageName (stageName_),
+      itemName (itemName_),
+      startTicks (isRunning() ? Time::getHighResolutionTicks() : 0)
+{
+}
+
+Profiler::ScopedTimer::~ScopedTimer()
+{
+    if (startTicks != 0)
+        addTime (stageName, itemName, startTicks);
+}
+
+//=================================================================================================
+Profiler::State& Profiler::getState()
+{
+    static State state;
+    return state;
+}
+
+//=================================================================================================
+const bool Profiler::isRunning() noexcept
+{
+    return getState().running.get() != 0;
+}
+
+//=================================================================================================
+void Profiler::start (const bool recordEvents)
+{
+    State& state (getState());
+    const ScopedLock sl (state.lock);
+
+    state.stages.clear();
+    state.counters.clear();
+    state.items.clear();
+    state.events.clearQuick();
+    state.threads.clearQuick();
+    state.droppedEvents = 0;
+
+    state.recordEvents = recordEvents;
+    state.startTicks = Time::getHighResolutionTicks();
+    state.endTicks = state.startTicks;
+    state.running = 1;
+}
+
+//=================================================================================================
+void Profiler::addTime (const char* stageName, const String& itemName, const int64 startTicks)
+{
+    const int64 endTicks = Time::getHighResolutionTicks();
+    State& state (getState());
+    const ScopedLock sl (state.lock);
+
+    // it has been stopped while this stage was running
+    if (state.running.get() == 0)
+        return;
+
+    const String stageKey (stageName);
+    Stage stage (state.stages[stageKey]);
+    stage.ticks += endTicks - startTicks;
+    ++stage.calls;
+    state.stages.set (stageKey, stage);
+
+    if (itemName.isNotEmpty())
+        state.items.set (itemName, state.items[itemName] + endTicks - startTicks);
+
+    if (!state.recordEvents)
+        return;
+
+    if (state.events.size() >= maxEvents)
+    {
+        ++state.droppedEvents;
+        return;
+    }
+
+    const Thread::ThreadID threadId = Thread::getCurrentThreadId();
+    int threadIndex = state.threads.indexOf (threadId);
+
+    if (threadIndex < 0)
+    {
+        threadIndex = state.threads.size();
+        state.threads.add (threadId);
+    }
+
+    Event event;
+    event.stageName = stageName;
+    event.itemName = itemName;
+    event.startTicks = startTicks;
+    event.endTicks = endTicks;
+    event.threadIndex = threadIndex;
+
+    state.events.add (event);
+}
+
+//=================================================================================================
+void Profiler::addCount (const char* counterName, const int64 amount)
+{
+    if (!isRunning())
+        return;
+
+    State& state (getState());
+    const ScopedLock sl (state.lock);
+
+    const String counterKey (counterName);
+    state.counters.set (counterKey, state.counters[counterKey] + amount);
+}
+
+//=================================================================================================
+const String Profiler::stop()
+{
+    State& state (getState());
+    const ScopedLock sl (state.lock);
+
+    if (state.running.get() == 0)
+        return String();
+
+    state.running = 0;
+    state.endTicks = Time::getHighResolutionTicks();
+
+    // sort by the time, the longest first
+    struct Line
+    {
+        String name;
+        int64 ticks;
+        int calls;
+    };
+
+    struct Sorter
+    {
+        int compareElements (const Line& first, const Line& second) const
+        {
+            return (first.ticks > second.ticks) ? -1 : ((first.ticks < second.ticks) ? 1 : 0);
+        }
+    };
+
+    Sorter sorter;
+    Array<Line> stages, items;
+
+    for (HashMap<String, Stage>::Iterator itr (state.stages); itr.next(); )
+    {
+        const Line line = { itr.getKey(), itr.getValue().ticks, itr.getValue().calls };
+        stages.add (line);
+    }
+
+    for (HashMap<String, int64>::Iterator itr (state.items); itr.next(); )
+    {
+        const Line line = { itr.getKey(), itr.getValue(), 1 };
+        items.add (line);
+    }
+
+    stages.sort (sorter);
+    items.sort (sorter);
+
+    String report;
+    report << "Total: " << ticksToMs (state.endTicks - state.startTicks) << " ms, "
+        << String (jmax (1, state.threads.size())) << " thread(s)" << newLine << newLine;
+
+    // the nested stages are included, and it's summed over all threads
+    report << "Stages (ms / calls / ms per call):" << newLine;
+
+    for (int i = 0; i < stages.size(); ++i)
+    {
+        const Line& line (stages.getReference (i));
+
+        report << "  " << line.name.paddedRight (' ', 24) << ticksToMs (line.ticks).paddedLeft (' ', 12)
+            << String (line.calls).paddedLeft (' ', 10)
+            << ticksToMs (line.ticks / jmax (1, line.calls)).paddedLeft (' ', 12) << newLine;
+    }
+
+    report << newLine << "Counters:" << newLine;
+    StringArray counterNames;
+
+    for (HashMap<String, int64>::Iterator itr (state.counters); itr.next(); )
+        counterNames.add (itr.getKey());
+
+    counterNames.sort (true);
+
+    for (int i = 0; i < counterNames.size(); ++i)
+        report << "  " << counterNames[i].paddedRight (' ', 24)
+            << String (state.counters[counterNames[i]]).paddedLeft (' ', 12) << newLine;
+
+    report << newLine << "Slowest:" << newLine;
+
+    for (int i = 0; i < jmin (20, items.size()); ++i)
+        report << "  " << ticksToMs (items.getReference (i).ticks).paddedLeft (' ', 12)
+            << "  " << items.getReference (i).name << newLine;
+
+    if (state.droppedEvents > 0)
+        report << newLine << String (state.droppedEvents) << " event(s) weren't recorded for the trace" << newLine;
+
+    return report;
+}
+
+//=================================================================================================
+const bool Profiler::writeTrace (const File& jsonFile)
+{
+    State& state (getState());
+    const ScopedLock sl (state.lock);
+
+    if (state.events.size() == 0)
+        return false;
+
+    const double usPerTick = 1000000.0 / (double) Time::getHighResolutionTicksPerSecond();
+    MemoryOutputStream json;
+
+    json << "{\"traceEvents\":[" << newLine;
+
+    for (int i = 0; i < state.events.size(); ++i)
+    {
+        const Event& event (state.events.getReference (i));
+
+        // 'X': a complete event, which has its start and duration (in microseconds)
+        json << ((i > 0) ? "," : "") << "{\"name\":" << JSON::toString (var (String (event.stageName)))
+            << ",\"cat\":\"generation\",\"ph\":\"X\""
+            << ",\"ts\":" << String ((event.startTicks - state.startTicks) * usPerTick, 1)
+            << ",\"dur\":" << String ((event.endTicks - event.startTicks) * usPerTick, 1)
+            << ",\"pid\":1,\"tid\":" << String (event.threadIndex);
+
+        if (event.itemName.isNotEmpty())
+            json << ",\"args\":{\"item\":" << JSON::toString (var (event.itemName)) << "}";
+
+        json << "}" << newLine;
+    }
+
+    json << "],\"displayTimeUnit\":\"ms\"}" << newLine;
+
+    return jsonFile.replaceWithData (json.getData(), json.getDataSize());
+}
+
+//=================================================================================================
+const String Profiler::ticksToMs (const int64 ticks)
+{
+    return String (ticks * 1000.0 / (double) Time::getHighResolutionTicksPerSecond(), 3);
+}
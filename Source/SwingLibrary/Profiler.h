@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    Profiler.h
+    Created: 20 Oct 2026 3:47:26am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef PROFILER_H_INCLUDED
+#define PROFILER_H_INCLUDED
+
+/** Where the time of a long work (e.g. generating the whole site) goes.
+
+    Put a ScopedTimer on the stack in a stage, and call addCount() for the things which
+    should be counted (e.g. the bytes written). Between start() and stop(), the time of each stage
+    and the counters are summed up, stop() returns a report of them and the slowest items
+    (e.g. pages). If the events are recorded, writeTrace() writes them as Chrome's
+    trace-event JSON, which can be opened in chrome://tracing or Perfetto.
+
+    When it isn't running, a timer only reads a flag, so the timers could be left in the hot paths.
+    It could be used on any thread.
+*/
+class Profiler
+{
+public:
+    /** begin a run, the data of the last run will be cleared.
+        arg: record each timer's start and duration as well, for writeTrace() */
+    static void start (const bool recordEvents);
+
+    /** end the run and return its report */
+    static const String stop();
+
+    static const bool isRunning() noexcept;
+
+    /** write the events of the last run, return false if there's none or it couldn't be written */
+    static const bool writeTrace (const File& jsonFile);
+
+    static void addCount (const char* counterName, const int64 amount = 1);
+
+    //=================================================================================================
+    class ScopedTimer
+    {
+    public:
+        /** arg-1 must be a string literal. arg-2 is the page (or file) it works on,
+            the report lists the slowest of them. */
+        explicit ScopedTimer (const char* stageName, const String& itemName = String());
+        ~ScopedTimer();
+
+    private:
+        const char* const stageName;
+        const String itemName;
+        const int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+    };
+
+private:
+    struct Stage
+    {
+        Stage() : ticks (0), calls (0) { }
+
+        int64 ticks;
+        int calls;
+    };
+
+    struct Event
+    {
+        const char* stageName;
+        String itemName;
+        int64 startTicks, endTicks;
+        int threadIndex;
+    };
+
+    struct State
+    {
+        State() : recordEvents (false), startTicks (0), endTicks (0), droppedEvents (0) { }
+
+        CriticalSection lock;
+        Atomic<int> running;
+        bool recordEvents;
+        int64 startTicks, endTicks;
+
+        HashMap<String, Stage> stages;
+        HashMap<String, int64> counters;
+        HashMap<String, int64> items;       // ticks of each item
+        Array<Event> events;
+        Array<Thread::ThreadID> threads;    // the index is the 'tid' of the trace
+        int droppedEvents;
+    };
+
+    static State& getState();
+    static void addTime (const char* stageName, const String& itemName, const int64 startTicks);
+
+    static const String ticksToMs (const int64 ticks);
+
+    /** so that a huge run won't eat up the memory */
+    enum { maxEvents = 1000000 };
+
+    JUCE_DECLARE_NON_COPYABLE (Profiler)
+};
+
+
+#endif  // PROFILER_H_INCLUDED
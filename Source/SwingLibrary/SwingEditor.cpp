@@ -275,24 +275,25 @@ void SwingEditor::shiftTabInput()
 //=================================================================================================
 const String SwingEditor::getCurrentParagraph() const
 {
+    const String text (getText());
     const int caretPos = getCaretPosition();
-    const int paraStart = getText().substring (0, caretPos).lastIndexOf ("\n");
-    const int paraEnd = getText().indexOf (caretPos, "\n");
+    const int paraStart = text.substring (0, caretPos).lastIndexOf ("\n");
+    const int paraEnd = text.indexOf (caretPos, "\n");
 
     if (paraStart == paraEnd && paraStart != -1)
         return String();
 
     else if (paraStart == -1 && paraEnd == -1)
-        return getText();
+        return text;
 
     else if (paraStart != -1 && paraEnd == -1)
-        return getText().substring (paraStart);
+        return text.substring (paraStart);
 
     else if (paraStart == -1 && paraEnd != -1)
-        return getText().substring (0, paraEnd);
+        return text.substring (0, paraEnd);
 
     else  
-        return getTextInRange (Range<int> (paraStart, paraEnd));
+        return text.substring (paraStart, paraEnd);
 }
 
 //=================================================================================================
@@ -326,163 +326,6 @@ const String SwingUtilities::convertANSIString (const File& ansiTextFile)
 #endif
 }
 
-//=================================================================================================
-const bool SwingUtilities::convertPngToJpg (const File& pngFile,
-                                            const File& jpgFile,
-                                            const float jpgQuality /*= 0.75*/,
-                                            const bool deletePngFileAfterConvert/* = true*/)
-{
-    jassert (pngFile.getFileExtension().toLowerCase() == ".png");
-    ScopedPointer<FileOutputStream> outputStream (jpgFile.createOutputStream());
-
-    JPEGImageFormat jpgFormat;
-    jpgFormat.setQuality (jpgQuality);
-
-    // here must convert its transprent pixel to white
-    // otherwise, they will be black
-    Image img (ImageCache::getFromFile (pngFile));
-
-    for (int i = img.getWidth(); --i >= 0; )
-    {
-        for (int j = img.getHeight(); --j >= 0; )
-        {
-            if (img.getPixelAt (i, j) == Colour (0x00))
-                img.setPixelAt (i, j, Colour (0xffffffff));
-        }
-    }
-
-    if (jpgFormat.writeImageToStream (img, *outputStream))
-    {
-        outputStream->flush();
-        outputStream = nullptr;
-
-        if (deletePngFileAfterConvert)
-            pngFile.deleteFile();
-
-        return true;
-    }
-    else
-    {
-        return false;
-    }
-}
-
-//=================================================================================================
-const bool SwingUtilities::processImageWidth (const File& imgFile, 
-                                              const float newPercentWidth)
-{
-    jassert (newPercentWidth > 0.001f);
-
-    Image img (ImageCache::getFromFile (imgFile));
-    img = img.rescaled ((int)(img.getWidth() * newPercentWidth),
-                        (int)(img.getHeight() * newPercentWidth));
-
-    if (img.isValid())
-    {
-        ImageFileFormat* imgFormat = ImageFileFormat::findImageFormatForFileExtension (imgFile);
-        const File tempFile (imgFile.withFileExtension ("tempForImg"));
-        ScopedPointer<FileOutputStream> outputStream (tempFile.createOutputStream());
-
-        if (imgFormat->writeImageToStream (img, *outputStream))
-        {
-            outputStream->flush();
-            outputStream = nullptr;
-
-            return tempFile.moveFileTo (imgFile);
-        }
-    }
-
-    return false;
-}
-
-//=================================================================================================
-const bool SwingUtilities::transparentImage (const File& originalImgFile,
-                                             const File& transprentImgFile,
-                                             const bool deleteImgFileAfterConvert/* = true*/)
-{
-    jassert (transprentImgFile.getFileExtension() == ".png");
-    Image img (ImageCache::getFromFile (originalImgFile));
-
-    if (!img.isValid())
-        return false;
-
-    // here must convert its pixel format, 
-    // otherwise the transparent color will be black
-    img = img.convertedToFormat (Image::ARGB);
-
-    // make the white color transprent
-    for (int i = img.getWidth(); --i >= 0; )
-    {
-    	for (int j = img.getHeight(); --j >= 0; )
-    	{
-            if (img.getPixelAt (i, j).getARGB() <= Colour (0xffffffff).getARGB()
-                && img.getPixelAt (i, j).getARGB() > Colour (0xfff0f0f0).getARGB())
-                img.setPixelAt (i, j, Colour (0x00));
-    	}
-    }
-
-    ScopedPointer<FileOutputStream> outputStream (transprentImgFile.createOutputStream());
-    PNGImageFormat pngFormat;
-
-    if (pngFormat.writeImageToStream (img, *outputStream))
-    {
-        outputStream->flush();
-        outputStream = nullptr;
-
-        if (deleteImgFileAfterConvert)
-            originalImgFile.deleteFile();
-
-        return true;
-    }
- 
-    return false;
-}
-
-//=================================================================================================
-const bool SwingUtilities::rotateImage (const File& originalImgFile, 
-                                        const File& targetImgFile, 
-                                        const bool leftRotate,
-                                        const bool deleteOriginal /*= true*/)
-{
-    jassert (originalImgFile.getFileExtension() == targetImgFile.getFileExtension());
-    Image originalImg (ImageCache::getFromFile (originalImgFile));
-
-    if (!originalImg.isValid())
-        return false;
-
-    Image targetImg (originalImg.getFormat(), originalImg.getHeight(), originalImg.getWidth(), true);
-    
-    // process by pixel
-    int tx = 0, ty = 0;
-
-    for (int x = originalImg.getWidth(); --x >= 0; )
-    {
-        for (int y = originalImg.getHeight(); --y >= 0; )
-        {            
-            tx = (leftRotate ? y : targetImg.getWidth() - y);
-            ty = (leftRotate ? targetImg.getHeight() - x : x);
-
-            targetImg.setPixelAt (tx, ty, originalImg.getPixelAt (x, y));
-        }
-    }
-    
-    ScopedPointer<FileOutputStream> outputStream (targetImgFile.createOutputStream());
-    ImageFileFormat* format = ImageFileFormat::findImageFormatForFileExtension (originalImgFile);
-
-    if (format->writeImageToStream (targetImg, *outputStream))
-    {
-        outputStream->flush();
-        outputStream = nullptr;
-
-        if (deleteOriginal)
-            originalImgFile.deleteFile();
-
-        return true;
-    }
-
-    return false;
-}
-
 //=================================================================================================
 template<class ComponentClass>
 ComponentClass* SwingUtilities::getChildComponentOfClass (Component* parent)
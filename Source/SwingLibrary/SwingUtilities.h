@@ -136,30 +136,6 @@ struct SwingUtilities
     */
     static const String convertANSIString (const File& ansiTextFile);
 
-    //=================================================================================================
-    /** */
-    static const bool convertPngToJpg (const File& pngFile, 
-                                       const File& jpgFile,
-                                       const float jpgQuality = 0.75,
-                                       const bool deletePngFileAfterConvert = true);
-
-    /** arg-3 should be percent value of the original image width and must more than 0.001f */
-    static const bool processImageWidth (const File& imgFile, 
-                                         const float newPercentWidth);
-
-    /** the process result is png format and write to arg-2 file. */
-    static const bool transparentImage (const File& originalImgFile,
-                                        const File& transprentFile,
-                                        const bool deleteImgFileAfterConvert = true);
-
-    /** the format of the process result is same as the original 
-        @para leftRotate false for right rotate 90'
-    */
-    static const bool rotateImage (const File& originalImgFile,
-                                   const File& targetImgFile,
-                                   const bool leftRotate90Degress,
-                                   const bool deleteOriginal = true);
-
     //=================================================================================================
     template<class ComponentClass>
     static ComponentClass* getChildComponentOfClass (Component* parent);
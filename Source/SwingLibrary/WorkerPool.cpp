@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    WorkerPool.cpp
+    Created: 20 Oct 2026 5:02:37am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+#include "WorkerPool.h"
+
+/** the state of a runAll(), it's shared by the caller and its helper jobs.
+    a helper which begins after all the items have been taken only reads the counter,
+    so the Task could be gone by then. */
+class WorkerPool::Batch : public ReferenceCountedObject
+{
+public:
+    typedef ReferenceCountedObjectPtr<Batch> Ptr;
+
+    Batch (Task& task_, const int numItems_, Thread* threadToCheck_)
+        : task (task_), numItems (numItems_), threadToCheck (threadToCheck_), allDone (true)
+    {
+    }
+
+    /** take the next item until there's none left */
+    void runItems()
+    {
+        for (;;)
+        {
+            const int index = (++nextIndex) - 1;
+
+            if (index >= numItems)
+                return;
+
+            if (threadToCheck != nullptr && threadToCheck->threadShouldExit())
+                cancelled = 1;
+            else
+                task.runItem (index);
+
+            if (++numDone == numItems)
+                allDone.signal();
+        }
+    }
+
+    Task& task;
+    const int numItems;
+    Thread* const threadToCheck;
+
+    Atomic<int> nextIndex, numDone, cancelled;
+    WaitableEvent allDone;
+
+    JUCE_DECLARE_NON_COPYABLE (Batch)
+};
+
+//=================================================================================================
+class WorkerPool::HelperJob : public ThreadPoolJob
+{
+public:
+    HelperJob (Batch* batch_) : ThreadPoolJob ("WorkerPoolHelper"), batch (batch_) { }
+
+    JobStatus runJob() override
+    {
+        batch->runItems();
+        return jobHasFinished;
+    }
+
+private:
+    const Batch::Ptr batch;
+};
+
+//=================================================================================================
+WorkerPool::WorkerPool()
+    : pool (jmax (1, SystemStats::getNumCpus()))
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+    pool.removeAllJobs (true, 5000);
+    clearSingletonInstance();
+}
+
+juce_ImplementSingleton (WorkerPool);
+
+//=================================================================================================
+const bool WorkerPool::runAll (Task& task, const int numItems, Thread* threadToCheck)
+{
+    if (numItems <= 0)
+        return true;
+
+    Batch::Ptr batch (new Batch (task, numItems, threadToCheck));
+    const int numHelpers = jmin (numItems - 1, pool.getNumThreads());
+
+    for (int i = 0; i < numHelpers; ++i)
+        pool.addJob (new HelperJob (batch), true);
+
+    batch->runItems();
+    batch->allDone.wait (-1);
+
+    return batch->cancelled.get() == 0;
+}
+
+//=================================================================================================
+void WorkerPool::addJob (ThreadPoolJob* job)
+{
+    pool.addJob (job, true);
+}
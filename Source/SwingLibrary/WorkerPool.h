@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    WorkerPool.h
+    Created: 20 Oct 2026 5:02:37am
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef WORKERPOOL_H_INCLUDED
+#define WORKERPOOL_H_INCLUDED
+
+/** The one thread pool of the app for the works which could be split into items,
+    e.g. the pages of a blog list, the images to be resized, the docs to be imported.
+
+    runAll() runs a Task's items on the pool and on the calling thread, then blocks
+    (without polling) until all of them have been done. The caller takes the items as well,
+    so it could be called from inside an item of another Task: that doesn't create more
+    threads, and it won't wait for a worker which is busy.
+
+    It doesn't show anything, the caller which could take long and is started from the ui
+    should run it in a ThreadWithProgressWindow and pass it as the 'threadToCheck'.
+*/
+class WorkerPool
+{
+public:
+    ~WorkerPool();
+    juce_DeclareSingleton (WorkerPool, true);
+
+    class Task
+    {
+    public:
+        virtual ~Task() { }
+
+        /** it's called once for each index, on any thread of the pool or the caller's */
+        virtual void runItem (const int index) = 0;
+    };
+
+    /** run task.runItem (0 ~ numItems - 1) and wait for them.
+        if arg-3 isn't nullptr, the items which haven't begun will be skipped once it should exit,
+        and false will be returned. */
+    const bool runAll (Task& task, const int numItems, Thread* threadToCheck = nullptr);
+
+    /** run a job in background, it'll be deleted when it's finished */
+    void addJob (ThreadPoolJob* job);
+
+private:
+    WorkerPool();
+
+    class Batch;
+    class HelperJob;
+
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerPool)
+};
+
+
+#endif  // WORKERPOOL_H_INCLUDED
@@ -0,0 +1,693 @@
+/*
+  ==============================================================================
+
+    ZipPacker.cpp
+    Created: 19 Oct 2026 7:41:03pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+#include "ZipPacker.h"
+
+enum
+{
+    bufferSize = 64 * 1024,
+    bigFileSize = 32 * 1024 * 1024,     // a file larger than this will be compressed to a temp file
+    localHeaderSize = 30,
+    centralHeaderSize = 46,
+    endOfDirectorySize = 22
+};
+
+static const int64 maxUint32 = 0xffffffffLL;
+static const int64 maxUint16 = 0xffffLL;
+
+//=================================================================================================
+static const uint64 readUint64 (const char* data)
+{
+    return (uint64) ByteOrder::littleEndianInt (data)
+        | ((uint64) ByteOrder::littleEndianInt (data + 4) << 32);
+}
+
+//=================================================================================================
+static const bool needsZip64Sizes (const ZipPacker::EntryInfo& entry)
+{
+    return entry.compressedSize >= maxUint32 || entry.uncompressedSize >= maxUint32;
+}
+
+//=================================================================================================
+/** compress a file into memory (or a temp file when it's big), and calculate its crc */
+class ZipPacker::CompressJob : public ThreadPoolJob
+{
+public:
+    CompressJob (const Item& item_, const int level_)
+        : ThreadPoolJob ("ZipCompress"), item (item_), level (level_),
+        crc (0), compressedSize (0), failed (false)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        ScopedPointer<FileInputStream> in (item.file.createInputStream());
+
+        if (in == nullptr || in->failedToOpen())
+        {
+            failed = true;
+            return jobHasFinished;
+        }
+
+        ScopedPointer<OutputStream> target;
+
+        if (item.fileSize > bigFileSize)
+        {
+            tempFile = new TemporaryFile (item.file);
+            target = tempFile->getFile().createOutputStream();
+        }
+        else
+        {
+            target = new MemoryOutputStream (data, false);
+        }
+
+        if (target == nullptr)
+        {
+            failed = true;
+            return jobHasFinished;
+        }
+
+        {
+            GZIPCompressorOutputStream compressor (target, level, false,
+                                                   GZIPCompressorOutputStream::windowBitsRaw);
+            HeapBlock<char> buffer (bufferSize);
+            int64 numCompressed = 0;
+
+            for (;;)
+            {
+                if (shouldExit())
+                {
+                    failed = true;
+                    break;
+                }
+
+                const int numRead = in->read (buffer, bufferSize);
+
+                if (numRead <= 0)
+                    break;
+
+                crc = ZipPacker::updateCrc (crc, buffer, (size_t) numRead);
+                compressor.write (buffer, (size_t) numRead);
+                numCompressed += numRead;
+            }
+
+            compressor.flush();
+
+            // the file has been changed after it was added
+            if (numCompressed != item.fileSize)
+                failed = true;
+        }
+
+        compressedSize = target->getPosition();
+        target = nullptr;
+
+        return jobHasFinished;
+    }
+
+    /** copy the compressed data into the archive */
+    const bool writeTo (OutputStream& out)
+    {
+        if (tempFile == nullptr)
+            return out.write (data.getData(), data.getSize());
+
+        FileInputStream in (tempFile->getFile());
+
+        return !in.failedToOpen() && out.writeFromInputStream (in, -1) == compressedSize;
+    }
+
+    const Item& item;
+    const int level;
+    MemoryBlock data;
+    ScopedPointer<TemporaryFile> tempFile;
+    uint32 crc;
+    int64 compressedSize;
+    bool failed;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE (CompressJob)
+};
+
+//=================================================================================================
+ZipPacker::ZipPacker (const int compressionLevel_)
+    : compressionLevel (jlimit (1, 9, compressionLevel_))
+{
+}
+
+//=================================================================================================
+ZipPacker::~ZipPacker()
+{
+}
+
+//=================================================================================================
+void ZipPacker::addFile (const File& file, const String& storedPathName)
+{
+    if (!file.existsAsFile())
+        return;
+
+    const Time t (file.getLastModificationTime());
+
+    Item* item = items.add (new Item());
+    item->file = file;
+    item->storedPathName = storedPathName.replaceCharacter ('\\', '/');
+    item->fileSize = file.getSize();
+    item->dosTime = (t.getSeconds() >> 1) | (t.getMinutes() << 5) | (t.getHours() << 11);
+    item->dosDate = t.getDayOfMonth() | ((t.getMonth() + 1) << 5) | (jmax (0, t.getYear() - 1980) << 9);
+    item->compress = !isCompressedFormat (file);
+}
+
+//=================================================================================================
+const bool ZipPacker::isCompressedFormat (const File& file)
+{
+    return file.hasFileExtension ("jpg;jpeg;png;gif;webp;mp3;mp4;m4a;aac;ogg;"
+                                  "zip;gz;7z;rar;wpck;mov;avi;mkv;webm;woff;woff2");
+}
+
+//=================================================================================================
+const bool ZipPacker::writeToFile (const File& zipFile,
+                                   Listener* listener,
+                                   const File& previousZip,
+                                   Thread* threadToCheck)
+{
+    // the entries of the previous archive which could be reused
+    ScopedPointer<FileInputStream> previousStream;
+    Array<EntryInfo> previousEntries;
+    HashMap<String, int> previousIndices;
+
+    if (previousZip.existsAsFile())
+    {
+        previousStream = previousZip.createInputStream();
+
+        if (previousStream != nullptr && readEntries (*previousStream, previousEntries))
+        {
+            for (int i = previousEntries.size(); --i >= 0; )
+                previousIndices.set (previousEntries.getReference (i).name, i);
+        }
+        else
+        {
+            previousEntries.clear();
+            previousStream = nullptr;
+        }
+    }
+
+    // how to write each item: reuse an old entry, compress it, or store it
+    Array<int> reuseIndices;
+    Array<int> compressItems;
+    int64 totalBytes = 0;
+
+    for (int i = 0; i < items.size(); ++i)
+    {
+        const Item* item = items.getUnchecked (i);
+        int reuseIndex = -1;
+
+        if (previousIndices.contains (item->storedPathName))
+        {
+            const EntryInfo& old = previousEntries.getReference (previousIndices[item->storedPathName]);
+
+            if (old.uncompressedSize == item->fileSize
+                && old.dosTime == item->dosTime
+                && old.dosDate == item->dosDate
+                && old.method == (item->compress ? 8 : 0))
+                reuseIndex = previousIndices[item->storedPathName];
+        }
+
+        reuseIndices.add (reuseIndex);
+        totalBytes += item->fileSize;
+
+        if (reuseIndex < 0 && item->compress)
+            compressItems.add (i);
+    }
+
+    TemporaryFile tempFile (zipFile);
+    ScopedPointer<FileOutputStream> out (tempFile.getFile().createOutputStream());
+
+    if (out == nullptr || out->failedToOpen())
+        return false;
+
+    // the compressing jobs run ahead of the writer, but not too far,
+    // otherwise all compressed data would be held in memory at the same time
+    OwnedArray<CompressJob> jobsHolder;
+    HashMap<int, CompressJob*> jobs;
+    ThreadPool pool (jmax (1, SystemStats::getNumCpus()));
+    const int maxJobsAhead = pool.getNumThreads() * 2;
+    int nextCompress = 0;
+
+    Array<EntryInfo> entries;
+    int64 doneBytes = 0;
+    bool succeeded = true;
+
+    for (int i = 0; i < items.size() && succeeded; ++i)
+    {
+        while (nextCompress < compressItems.size() && jobs.size() < maxJobsAhead)
+        {
+            const int itemIndex = compressItems[nextCompress++];
+            CompressJob* job = jobsHolder.add (new CompressJob (*items.getUnchecked (itemIndex), compressionLevel));
+            jobs.set (itemIndex, job);
+            pool.addJob (job, false);
+        }
+
+        if (threadToCheck != nullptr && threadToCheck->threadShouldExit())
+        {
+            succeeded = false;
+            break;
+        }
+
+        const Item& item = *items.getUnchecked (i);
+        const int reuseIndex = reuseIndices[i];
+
+        EntryInfo entry;
+        entry.name = item.storedPathName;
+        entry.dosTime = item.dosTime;
+        entry.dosDate = item.dosDate;
+        entry.uncompressedSize = item.fileSize;
+        entry.headerOffset = out->getPosition();
+
+        if (reuseIndex >= 0)
+        {
+            const EntryInfo& old = previousEntries.getReference (reuseIndex);
+            entry.method = old.method;
+            entry.crc = old.crc;
+            entry.compressedSize = old.compressedSize;
+
+            writeLocalHeader (*out, entry);
+            succeeded = copyRawData (*previousStream, old, *out);
+        }
+        else if (item.compress)
+        {
+            CompressJob* job = jobs[i];
+            pool.waitForJobToFinish (job, -1);
+
+            entry.method = 8;
+            entry.crc = job->crc;
+            entry.compressedSize = job->compressedSize;
+
+            succeeded = !job->failed;
+
+            if (succeeded)
+            {
+                writeLocalHeader (*out, entry);
+                succeeded = job->writeTo (*out);
+            }
+
+            jobs.remove (i);
+            jobsHolder.removeObject (job);
+        }
+        else
+        {
+            // the crc is known only after the file has been read, so patch it later
+            entry.method = 0;
+            entry.compressedSize = item.fileSize;
+
+            writeLocalHeader (*out, entry);
+            succeeded = storeFile (item, *out, entry.crc, threadToCheck);
+
+            if (succeeded)
+            {
+                const int64 endPos = out->getPosition();
+                out->setPosition (entry.headerOffset + 14);
+                out->writeInt ((int) entry.crc);
+                out->setPosition (endPos);
+            }
+        }
+
+        entries.add (entry);
+        doneBytes += item.fileSize;
+
+        if (listener != nullptr && totalBytes > 0)
+            listener->packingProgress ((double) doneBytes / (double) totalBytes);
+    }
+
+    pool.removeAllJobs (true, -1);
+
+    if (!succeeded)
+        return false;
+
+    // central directory
+    const int64 directoryStart = out->getPosition();
+
+    for (int i = 0; i < entries.size(); ++i)
+        writeCentralHeader (*out, entries.getReference (i));
+
+    writeEndOfCentralDirectory (*out, directoryStart, out->getPosition() - directoryStart, entries.size());
+    out->flush();
+
+    if (out->getStatus().failed())
+        return false;
+
+    out = nullptr;
+    previousStream = nullptr;   // the previous archive could be the target
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+//=================================================================================================
+const bool ZipPacker::writeToFileWithProgress (const File& zipFile,
+                                               const String& windowTitle,
+                                               const File& previousZip)
+{
+    struct PackThread : public ThreadWithProgressWindow,
+                        public ZipPacker::Listener
+    {
+        PackThread (ZipPacker& packer_, const File& zipFile_, const String& title, const File& previousZip_)
+            : ThreadWithProgressWindow (title, true, true),
+            packer (packer_), zipFile (zipFile_), previousZip (previousZip_), succeeded (false)
+        {
+        }
+
+        void run() override
+        {
+            succeeded = packer.writeToFile (zipFile, this, previousZip, this);
+        }
+
+        void packingProgress (const double progress) override
+        {
+            setProgress (progress);
+        }
+
+        ZipPacker& packer;
+        const File zipFile, previousZip;
+        bool succeeded;
+    };
+
+    PackThread thread (*this, zipFile, windowTitle, previousZip);
+
+    return thread.runThread() && thread.succeeded;
+}
+
+//=================================================================================================
+void ZipPacker::writeLocalHeader (OutputStream& out, const EntryInfo& entry)
+{
+    const bool zip64 = needsZip64Sizes (entry);
+    const size_t nameSize = entry.name.getNumBytesAsUTF8();
+
+    out.writeInt (0x04034b50);
+    out.writeShort (zip64 ? 45 : 20);
+    out.writeShort (0x0800);            // the name is utf-8
+    out.writeShort ((short) entry.method);
+    out.writeShort ((short) entry.dosTime);
+    out.writeShort ((short) entry.dosDate);
+    out.writeInt ((int) entry.crc);
+    out.writeInt (zip64 ? -1 : (int) entry.compressedSize);
+    out.writeInt (zip64 ? -1 : (int) entry.uncompressedSize);
+    out.writeShort ((short) nameSize);
+    out.writeShort ((short) (zip64 ? 20 : 0));
+    out.write (entry.name.toRawUTF8(), nameSize);
+
+    if (zip64)
+    {
+        out.writeShort (1);
+        out.writeShort (16);
+        out.writeInt64 (entry.uncompressedSize);
+        out.writeInt64 (entry.compressedSize);
+    }
+}
+
+//=================================================================================================
+void ZipPacker::writeCentralHeader (OutputStream& out, const EntryInfo& entry)
+{
+    const bool zip64 = needsZip64Sizes (entry) || entry.headerOffset >= maxUint32;
+    const size_t nameSize = entry.name.getNumBytesAsUTF8();
+
+    out.writeInt (0x02014b50);
+    out.writeShort (zip64 ? 45 : 20);   // made by
+    out.writeShort (zip64 ? 45 : 20);   // needed
+    out.writeShort (0x0800);
+    out.writeShort ((short) entry.method);
+    out.writeShort ((short) entry.dosTime);
+    out.writeShort ((short) entry.dosDate);
+    out.writeInt ((int) entry.crc);
+    out.writeInt (zip64 ? -1 : (int) entry.compressedSize);
+    out.writeInt (zip64 ? -1 : (int) entry.uncompressedSize);
+    out.writeShort ((short) nameSize);
+    out.writeShort ((short) (zip64 ? 28 : 0));
+    out.writeShort (0);                 // comment
+    out.writeShort (0);                 // disk number
+    out.writeShort (0);                 // internal attributes
+    out.writeInt (0);                   // external attributes
+    out.writeInt (zip64 ? -1 : (int) entry.headerOffset);
+    out.write (entry.name.toRawUTF8(), nameSize);
+
+    if (zip64)
+    {
+        out.writeShort (1);
+        out.writeShort (24);
+        out.writeInt64 (entry.uncompressedSize);
+        out.writeInt64 (entry.compressedSize);
+        out.writeInt64 (entry.headerOffset);
+    }
+}
+
+//=================================================================================================
+void ZipPacker::writeEndOfCentralDirectory (OutputStream& out,
+                                            const int64 directoryStart,
+                                            const int64 directorySize,
+                                            const int numEntries)
+{
+    const bool zip64 = numEntries >= maxUint16 || directoryStart >= maxUint32 || directorySize >= maxUint32;
+
+    if (zip64)
+    {
+        const int64 zip64EndPos = out.getPosition();
+
+        out.writeInt (0x06064b50);
+        out.writeInt64 (44);            // size of the rest of this record
+        out.writeShort (45);
+        out.writeShort (45);
+        out.writeInt (0);
+        out.writeInt (0);
+        out.writeInt64 (numEntries);
+        out.writeInt64 (numEntries);
+        out.writeInt64 (directorySize);
+        out.writeInt64 (directoryStart);
+
+        // locator
+        out.writeInt (0x07064b50);
+        out.writeInt (0);
+        out.writeInt64 (zip64EndPos);
+        out.writeInt (1);
+    }
+
+    out.writeInt (0x06054b50);
+    out.writeShort (0);
+    out.writeShort (0);
+    out.writeShort ((short) (zip64 ? -1 : numEntries));
+    out.writeShort ((short) (zip64 ? -1 : numEntries));
+    out.writeInt (zip64 ? -1 : (int) directorySize);
+    out.writeInt (zip64 ? -1 : (int) directoryStart);
+    out.writeShort (0);
+}
+
+//=================================================================================================
+const bool ZipPacker::copyRawData (InputStream& previousZip, const EntryInfo& entry, OutputStream& out)
+{
+    char header[localHeaderSize];
+
+    if (!previousZip.setPosition (entry.headerOffset)
+        || previousZip.read (header, localHeaderSize) != localHeaderSize
+        || ByteOrder::littleEndianInt (header) != 0x04034b50)
+        return false;
+
+    const int64 dataStart = entry.headerOffset + localHeaderSize
+        + ByteOrder::littleEndianShort (header + 26)
+        + ByteOrder::littleEndianShort (header + 28);
+
+    return previousZip.setPosition (dataStart)
+        && out.writeFromInputStream (previousZip, entry.compressedSize) == entry.compressedSize;
+}
+
+//=================================================================================================
+const bool ZipPacker::storeFile (const Item& item, OutputStream& out, uint32& crc, Thread* threadToCheck)
+{
+    FileInputStream in (item.file);
+
+    if (in.failedToOpen())
+        return false;
+
+    HeapBlock<char> buffer (bufferSize);
+    int64 numWritten = 0;
+    crc = 0;
+
+    for (;;)
+    {
+        if (threadToCheck != nullptr && threadToCheck->threadShouldExit())
+            return false;
+
+        const int numRead = in.read (buffer, bufferSize);
+
+        if (numRead <= 0)
+            break;
+
+        crc = updateCrc (crc, buffer, (size_t) numRead);
+
+        if (!out.write (buffer, (size_t) numRead))
+            return false;
+
+        numWritten += numRead;
+    }
+
+    // the file has been changed after it was added
+    return numWritten == item.fileSize;
+}
+
+//=================================================================================================
+const bool ZipPacker::readEntries (InputStream& zipStream, Array<EntryInfo>& entries)
+{
+    // the end of central directory is in the last 64 KB (the comment) + 22 bytes
+    const int64 totalLength = zipStream.getTotalLength();
+    const int tailSize = (int) jmin (totalLength, (int64) (65535 + endOfDirectorySize));
+
+    if (tailSize < endOfDirectorySize)
+        return false;
+
+    HeapBlock<char> tail (tailSize);
+
+    if (!zipStream.setPosition (totalLength - tailSize) || zipStream.read (tail, tailSize) != tailSize)
+        return false;
+
+    int endPos = -1;
+
+    for (int i = tailSize - endOfDirectorySize; i >= 0; --i)
+    {
+        if (ByteOrder::littleEndianInt (tail + i) == 0x06054b50)
+        {
+            endPos = i;
+            break;
+        }
+    }
+
+    if (endPos < 0)
+        return false;
+
+    int64 numEntries = ByteOrder::littleEndianShort (tail + endPos + 10);
+    int64 directorySize = ByteOrder::littleEndianInt (tail + endPos + 12);
+    int64 directoryStart = ByteOrder::littleEndianInt (tail + endPos + 16);
+
+    // zip64: the locator is just before the end of central directory
+    if ((numEntries == maxUint16 || directorySize == maxUint32 || directoryStart == maxUint32)
+        && endPos >= 20 && ByteOrder::littleEndianInt (tail + endPos - 20) == 0x07064b50)
+    {
+        char zip64End[56];
+
+        if (!zipStream.setPosition ((int64) readUint64 (tail + endPos - 12))
+            || zipStream.read (zip64End, 56) != 56
+            || ByteOrder::littleEndianInt (zip64End) != 0x06064b50)
+            return false;
+
+        numEntries = (int64) readUint64 (zip64End + 32);
+        directorySize = (int64) readUint64 (zip64End + 40);
+        directoryStart = (int64) readUint64 (zip64End + 48);
+    }
+
+    if (directoryStart + directorySize > totalLength || directorySize > std::numeric_limits<int>::max())
+        return false;
+
+    MemoryBlock directory;
+
+    if (!zipStream.setPosition (directoryStart)
+        || zipStream.readIntoMemoryBlock (directory, (ssize_t) directorySize) != (size_t) directorySize)
+        return false;
+
+    const char* const data = static_cast<const char*> (directory.getData());
+    size_t pos = 0;
+
+    for (int64 i = 0; i < numEntries; ++i)
+    {
+        if (pos + centralHeaderSize > directory.getSize()
+            || ByteOrder::littleEndianInt (data + pos) != 0x02014b50)
+            return false;
+
+        const char* const h = data + pos;
+        const int nameLength = ByteOrder::littleEndianShort (h + 28);
+        const int extraLength = ByteOrder::littleEndianShort (h + 30);
+        const int commentLength = ByteOrder::littleEndianShort (h + 32);
+
+        if (pos + centralHeaderSize + nameLength + extraLength + commentLength > directory.getSize())
+            return false;
+
+        EntryInfo entry;
+        entry.method = ByteOrder::littleEndianShort (h + 10);
+        entry.dosTime = ByteOrder::littleEndianShort (h + 12);
+        entry.dosDate = ByteOrder::littleEndianShort (h + 14);
+        entry.crc = ByteOrder::littleEndianInt (h + 16);
+        entry.compressedSize = ByteOrder::littleEndianInt (h + 20);
+        entry.uncompressedSize = ByteOrder::littleEndianInt (h + 24);
+        entry.headerOffset = ByteOrder::littleEndianInt (h + 42);
+        entry.name = String::fromUTF8 (h + centralHeaderSize, nameLength);
+
+        // zip64 extra field: only the fields which are 0xffffffff in the header, in this order
+        const char* extra = h + centralHeaderSize + nameLength;
+        const char* const extraEnd = extra + extraLength;
+
+        while (extra + 4 <= extraEnd)
+        {
+            const int id = ByteOrder::littleEndianShort (extra);
+            const int size = ByteOrder::littleEndianShort (extra + 2);
+            const char* field = extra + 4;
+            const char* const fieldEnd = jmin (field + size, extraEnd);
+
+            if (id == 1)
+            {
+                if (entry.uncompressedSize == maxUint32 && field + 8 <= fieldEnd)
+                {
+                    entry.uncompressedSize = (int64) readUint64 (field);
+                    field += 8;
+                }
+
+                if (entry.compressedSize == maxUint32 && field + 8 <= fieldEnd)
+                {
+                    entry.compressedSize = (int64) readUint64 (field);
+                    field += 8;
+                }
+
+                if (entry.headerOffset == maxUint32 && field + 8 <= fieldEnd)
+                    entry.headerOffset = (int64) readUint64 (field);
+            }
+
+            extra += 4 + size;
+        }
+
+        entries.add (entry);
+        pos += (size_t) (centralHeaderSize + nameLength + extraLength + commentLength);
+    }
+
+    return true;
+}
+
+//=================================================================================================
+const uint32 ZipPacker::updateCrc (uint32 crc, const void* data, const size_t numBytes)
+{
+    // built only once, and it's thread-safe since it's a local static object
+    struct CrcTable
+    {
+        CrcTable()
+        {
+            for (uint32 i = 0; i < 256; ++i)
+            {
+                uint32 c = i;
+
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) != 0 ? (0xedb88320 ^ (c >> 1)) : (c >> 1);
+
+                values[i] = c;
+            }
+        }
+
+        uint32 values[256];
+    };
+
+    static const CrcTable table;
+    const uint8* p = static_cast<const uint8*> (data);
+    crc = ~crc;
+
+    for (size_t i = 0; i < numBytes; ++i)
+        crc = table.values[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+
+    return ~crc;
+}
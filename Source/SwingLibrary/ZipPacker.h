@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    ZipPacker.h
+    Created: 19 Oct 2026 7:41:03pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef ZIPPACKER_H_INCLUDED
+#define ZIPPACKER_H_INCLUDED
+
+/** Pack lots of files into a zip archive, instead of ZipFile::Builder for big projects.
+
+    - the entries are compressed by a ThreadPool in parallel, then written into
+      the archive in order as soon as they're done.
+    - the files of an already-compressed format (jpg, png, mp3, mp4, zip...) will be
+      stored without compression, see isCompressedFormat().
+    - when a previous archive is given, its entries which are unchanged (same path, size
+      and modified time) will be copied into the new archive directly, without compress them again.
+    - zip64 will be used if the archive or any file is larger than 4 GB.
+
+    It's designed for running on a background thread, e.g. a ThreadWithProgressWindow.
+*/
+class ZipPacker
+{
+public:
+    ZipPacker (const int compressionLevel = 9);
+    ~ZipPacker();
+
+    /** arg-2 is the path and name inside the archive, the separators will be converted to '/' */
+    void addFile (const File& file, const String& storedPathName);
+    const int getNumFiles() const                        { return items.size(); }
+
+    //=================================================================================================
+    class Listener
+    {
+    public:
+        virtual ~Listener() { }
+
+        /** arg: 0.0 ~ 1.0, based on the bytes of the files. it'll be called by the packing thread */
+        virtual void packingProgress (const double progress) = 0;
+    };
+
+    /** write all the added files to arg-1, return false if failed or cancelled.
+        the archive is written to a temporary file first, so the target (and arg-3,
+        which could be the same file as arg-1) won't be broken when it failed.
+
+        arg-3: the previous archive whose unchanged entries will be reused, it could be nonexistent.
+        arg-4: if it's not nullptr, packing will be cancelled after its threadShouldExit() returns true. */
+    const bool writeToFile (const File& zipFile,
+                            Listener* listener = nullptr,
+                            const File& previousZip = File::nonexistent,
+                            Thread* threadToCheck = nullptr);
+
+    /** same as writeToFile(), but run it on a background thread and show a modal progress window.
+        return false if failed or the user cancelled it. */
+    const bool writeToFileWithProgress (const File& zipFile,
+                                        const String& windowTitle,
+                                        const File& previousZip = File::nonexistent);
+
+    /** png, jpg, mp3, mp4, zip, etc. compress them again is only a waste of time */
+    static const bool isCompressedFormat (const File& file);
+
+    //=================================================================================================
+    /** an entry of the central directory of a zip archive */
+    struct EntryInfo
+    {
+        EntryInfo() : method (0), dosTime (0), dosDate (0), crc (0),
+            compressedSize (0), uncompressedSize (0), headerOffset (0) { }
+
+        String name;
+        int method;     // 0: stored, 8: deflated
+        int dosTime, dosDate;
+        uint32 crc;
+        int64 compressedSize, uncompressedSize, headerOffset;
+    };
+
+    /** read the central directory of a zip archive (include zip64). return false if it's not a zip. */
+    static const bool readEntries (InputStream& zipStream, Array<EntryInfo>& entries);
+
+    /** arg-1 is the last result, 0 for the beginning */
+    static const uint32 updateCrc (uint32 crc, const void* data, const size_t numBytes);
+
+private:
+    //=================================================================================================
+    struct Item
+    {
+        File file;
+        String storedPathName;
+        int64 fileSize;
+        int dosTime, dosDate;
+        bool compress;
+    };
+
+    class CompressJob;
+
+    static void writeLocalHeader (OutputStream& out, const EntryInfo& entry);
+    static void writeCentralHeader (OutputStream& out, const EntryInfo& entry);
+    static void writeEndOfCentralDirectory (OutputStream& out, const int64 directoryStart,
+                                            const int64 directorySize, const int numEntries);
+
+    /** copy the compressed data of the arg-2 entry from the previous archive */
+    static const bool copyRawData (InputStream& previousZip, const EntryInfo& entry, OutputStream& out);
+
+    /** copy the file into the archive without compression, and calculate its crc */
+    static const bool storeFile (const Item& item, OutputStream& out, uint32& crc, Thread* threadToCheck);
+
+    //=================================================================================================
+    OwnedArray<Item> items;
+    const int compressionLevel;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipPacker)
+};
+
+
+#endif  // ZIPPACKER_H_INCLUDED
@@ -0,0 +1,336 @@
+/*
+  ==============================================================================
+
+    ZipUnpacker.cpp
+    Created: 19 Oct 2026 9:05:37pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+#include "ZipPacker.h"
+#include "ZipUnpacker.h"
+
+enum
+{
+    bufferSize = 64 * 1024,
+    localHeaderSize = 30
+};
+
+//=================================================================================================
+/** extract the entries one by one until there's nothing left */
+class ZipUnpacker::UnpackJob : public ThreadPoolJob
+{
+public:
+    UnpackJob (ZipUnpacker& owner_) : ThreadPoolJob ("ZipUnpack"), owner (owner_) { }
+
+    JobStatus runJob() override
+    {
+        while (!shouldExit())
+        {
+            const int index = owner.claimNextEntry();
+
+            if (index < 0)
+                break;
+
+            owner.finishEntry (index, owner.extractEntry (index));
+        }
+
+        const ScopedLock sl (owner.lock);
+
+        if (--owner.numJobsRunning == 0)
+            owner.triggerAsyncUpdate();
+
+        return jobHasFinished;
+    }
+
+private:
+    ZipUnpacker& owner;
+    JUCE_DECLARE_NON_COPYABLE (UnpackJob)
+};
+
+//=================================================================================================
+ZipUnpacker::ZipUnpacker (const File& zipFile_, const File& targetDir_)
+    : zipFile (zipFile_), targetDir (targetDir_),
+    nextInOrder (0), numJobsRunning (0), started (false),
+    listener (nullptr),
+    pool (jmax (1, SystemStats::getNumCpus()))
+{
+}
+
+//=================================================================================================
+ZipUnpacker::~ZipUnpacker()
+{
+    pool.removeAllJobs (true, -1);
+    cancelPendingUpdate();
+}
+
+//=================================================================================================
+const bool ZipUnpacker::open()
+{
+    FileInputStream in (zipFile);
+    entries.clear();
+
+    if (in.failedToOpen() || !ZipPacker::readEntries (in, entries) || entries.size() < 1)
+        return false;
+
+    states.insertMultiple (0, pending, entries.size());
+    return true;
+}
+
+//=================================================================================================
+const int ZipUnpacker::indexOfEntry (const String& name) const
+{
+    for (int i = entries.size(); --i >= 0; )
+    {
+        if (entries.getReference (i).name == name)
+            return i;
+    }
+
+    return -1;
+}
+
+//=================================================================================================
+const int ZipUnpacker::indexOfFile (const File& file) const
+{
+    if (!file.isAChildOf (targetDir))
+        return -1;
+
+    return indexOfEntry (file.getRelativePathFrom (targetDir).replace ("\\", "/"));
+}
+
+//=================================================================================================
+const bool ZipUnpacker::extractNow (const int index)
+{
+    if (index < 0 || index >= entries.size())
+        return false;
+
+    // claim it if nobody is extracting it, otherwise wait for the background
+    bool claimed = false;
+
+    {
+        const ScopedLock sl (lock);
+
+        if (states[index] == extracted)
+            return true;
+
+        if (states[index] == failed)
+            return false;
+
+        if (states[index] == pending)
+        {
+            states.set (index, extracting);
+            claimed = true;
+        }
+    }
+
+    if (claimed)
+    {
+        const bool succeeded = extractEntry (index);
+        finishEntry (index, succeeded);
+        return succeeded;
+    }
+
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (states[index] != extracting)
+                return states[index] == extracted;
+        }
+
+        entryFinished.wait (20);
+    }
+}
+
+//=================================================================================================
+void ZipUnpacker::start (Listener* listener_, const StringArray& firstPrefixes)
+{
+    const ScopedLock sl (lock);
+    jassert (!started);
+
+    listener = listener_;
+    started = true;
+
+    // the entries which should be extracted first, then the rest
+    Array<bool> ordered;
+    ordered.insertMultiple (0, false, entries.size());
+
+    for (int i = 0; i < firstPrefixes.size(); ++i)
+    {
+        for (int j = 0; j < entries.size(); ++j)
+        {
+            if (!ordered[j] && entries.getReference (j).name.startsWith (firstPrefixes[i]))
+            {
+                order.add (j);
+                ordered.set (j, true);
+            }
+        }
+    }
+
+    for (int j = 0; j < entries.size(); ++j)
+    {
+        if (!ordered[j])
+            order.add (j);
+    }
+
+    numJobsRunning = jmin (pool.getNumThreads(), entries.size());
+
+    for (int i = 0; i < numJobsRunning; ++i)
+        pool.addJob (new UnpackJob (*this), true);
+
+    if (numJobsRunning == 0)
+        triggerAsyncUpdate();
+}
+
+//=================================================================================================
+const bool ZipUnpacker::isFinished() const
+{
+    const ScopedLock sl (lock);
+    return started && numJobsRunning == 0;
+}
+
+//=================================================================================================
+const int ZipUnpacker::claimNextEntry()
+{
+    const ScopedLock sl (lock);
+
+    while (nextInOrder < order.size())
+    {
+        const int index = order[nextInOrder++];
+
+        if (states[index] == pending)
+        {
+            states.set (index, extracting);
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+//=================================================================================================
+void ZipUnpacker::finishEntry (const int index, const bool succeeded)
+{
+    {
+        const ScopedLock sl (lock);
+        states.set (index, succeeded ? extracted : failed);
+    }
+
+    entryFinished.signal();
+}
+
+//=================================================================================================
+const bool ZipUnpacker::extractEntry (const int index) const
+{
+    const ZipPacker::EntryInfo& entry = entries.getReference (index);
+    const File target (targetDir.getChildFile (entry.name));
+
+    // e.g. '../../xxx'
+    if (!target.isAChildOf (targetDir))
+        return false;
+
+    if (entry.name.endsWithChar ('/'))
+        return target.createDirectory().wasOk();
+
+    if (entry.method != 0 && entry.method != 8)
+        return false;
+
+    FileInputStream in (zipFile);
+    char header[localHeaderSize];
+
+    if (in.failedToOpen()
+        || !in.setPosition (entry.headerOffset)
+        || in.read (header, localHeaderSize) != localHeaderSize
+        || ByteOrder::littleEndianInt (header) != 0x04034b50)
+        return false;
+
+    const int64 dataStart = entry.headerOffset + localHeaderSize
+        + ByteOrder::littleEndianShort (header + 26)
+        + ByteOrder::littleEndianShort (header + 28);
+
+    SubregionStream region (&in, dataStart, entry.compressedSize, false);
+    ScopedPointer<GZIPDecompressorInputStream> decompressor;
+    InputStream* source = &region;
+
+    if (entry.method == 8)
+    {
+        decompressor = new GZIPDecompressorInputStream (&region, false,
+                                                        GZIPDecompressorInputStream::deflateFormat,
+                                                        entry.uncompressedSize);
+        source = decompressor;
+    }
+
+    if (!target.getParentDirectory().createDirectory().wasOk())
+        return false;
+
+    // write to a temp file, the target will only be replaced after the crc is correct
+    TemporaryFile tempFile (target);
+
+    {
+        ScopedPointer<FileOutputStream> out (tempFile.getFile().createOutputStream());
+
+        if (out == nullptr || out->failedToOpen())
+            return false;
+
+        HeapBlock<char> buffer (bufferSize);
+        uint32 crc = 0;
+        int64 numWritten = 0;
+
+        for (;;)
+        {
+            if (Thread::currentThreadShouldExit())
+                return false;
+
+            const int numRead = source->read (buffer, bufferSize);
+
+            if (numRead <= 0)
+                break;
+
+            crc = ZipPacker::updateCrc (crc, buffer, (size_t) numRead);
+
+            if (!out->write (buffer, (size_t) numRead))
+                return false;
+
+            numWritten += numRead;
+        }
+
+        out->flush();
+
+        if (out->getStatus().failed() || numWritten != entry.uncompressedSize || crc != entry.crc)
+            return false;
+    }
+
+    if (!tempFile.overwriteTargetFileWithTemporary())
+        return false;
+
+    // keep the time of the packed file, so packing it again could reuse the entry
+    target.setLastModificationTime (Time (((entry.dosDate >> 9) & 127) + 1980,
+                                          jmax (0, ((entry.dosDate >> 5) & 15) - 1),
+                                          jmax (1, entry.dosDate & 31),
+                                          (entry.dosTime >> 11) & 31,
+                                          (entry.dosTime >> 5) & 63,
+                                          (entry.dosTime & 31) * 2));
+    return true;
+}
+
+//=================================================================================================
+void ZipUnpacker::handleAsyncUpdate()
+{
+    StringArray failedEntries;
+
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = 0; i < entries.size(); ++i)
+        {
+            if (states[i] != extracted)
+                failedEntries.add (entries.getReference (i).name);
+        }
+    }
+
+    if (listener != nullptr)
+        listener->unpackingFinished (this, failedEntries);
+}
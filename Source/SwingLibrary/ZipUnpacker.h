@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    ZipUnpacker.h
+    Created: 19 Oct 2026 9:05:37pm
+    Author:  SwingCoder
+
+  ==============================================================================
+*/
+
+#ifndef ZIPUNPACKER_H_INCLUDED
+#define ZIPUNPACKER_H_INCLUDED
+
+/** Unpack a zip archive in background, instead of ZipFile::uncompressTo() for big projects.
+
+    - the entries are decompressed by a ThreadPool in parallel, and the crc of each
+      entry will be verified. a file is written to a temp file first, so that a broken
+      entry won't leave a half file.
+    - some entries could be extracted at once by extractNow() (e.g. the project file),
+      then the rest will be extracted in background after start().
+    - extractNow() could also be called while the background extracting is running,
+      it'll wait for or extract the arg entry directly, so it's ready after it returned.
+
+    Usage: create it, open(), extractNow() what needed at once, start(), and the
+    listener will be called on the message thread after all the rest were done.
+*/
+class ZipUnpacker : private AsyncUpdater
+{
+public:
+    ZipUnpacker (const File& zipFile, const File& targetDir);
+
+    /** it'll stop the background extracting, and wait for it */
+    ~ZipUnpacker();
+
+    /** read the central directory, return false if it's not a valid zip archive */
+    const bool open();
+
+    const int getNumEntries() const                    { return entries.size(); }
+    const String getEntryName (const int index) const  { return entries[index].name; }
+    const File& getTargetDir() const                   { return targetDir; }
+
+    /** return -1 if there's no this entry */
+    const int indexOfEntry (const String& name) const;
+
+    /** return -1 if the arg isn't inside the target dir or it's not an entry of the archive */
+    const int indexOfFile (const File& file) const;
+
+    /** extract the arg entry on the calling thread, if the background is extracting it,
+        wait until it's done. return false if it failed (e.g. the crc doesn't match) */
+    const bool extractNow (const int index);
+
+    //=================================================================================================
+    class Listener
+    {
+    public:
+        virtual ~Listener() { }
+
+        /** it'll be called on the message thread. arg-2: the entries which couldn't be extracted */
+        virtual void unpackingFinished (ZipUnpacker* unpacker, const StringArray& failedEntries) = 0;
+    };
+
+    /** extract all the entries which haven't been extracted in background.
+        the entries whose names start with one of arg-2 will be extracted first. */
+    void start (Listener* listener, const StringArray& firstPrefixes = StringArray());
+
+    const bool isFinished() const;
+
+private:
+    //=================================================================================================
+    enum EntryState { pending = 0, extracting, extracted, failed };
+
+    class UnpackJob;
+
+    /** return -1 if there's nothing to do */
+    const int claimNextEntry();
+    void finishEntry (const int index, const bool succeeded);
+    const bool extractEntry (const int index) const;
+
+    void handleAsyncUpdate() override;
+
+    //=================================================================================================
+    const File zipFile, targetDir;
+    Array<ZipPacker::EntryInfo> entries;
+
+    CriticalSection lock;
+    Array<int> states;
+    Array<int> order;
+    int nextInOrder, numJobsRunning;
+    bool started;
+    WaitableEvent entryFinished;
+
+    Listener* listener;
+    ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipUnpacker)
+};
+
+
+#endif  // ZIPUNPACKER_H_INCLUDED
@@ -92,11 +92,14 @@ TopToolBar::TopToolBar (FileTreeContainer* f,
     addAndMakeVisible (progressBar);
 
     setTooltips();
+    Mp3Encoder::getInstance()->setListener (this);
 }
 
 //=================================================================================================
 TopToolBar::~TopToolBar()
 {
+    Mp3Encoder::getInstance()->setListener (nullptr);
+
     if (isThreadRunning())
         stopThread (3000);
 }
@@ -332,6 +335,10 @@ void TopToolBar::popupSystemMenu()
     uiMenu.addItem (resetUiColor, TRANS ("Reset to Default"));
     m.addSubMenu (TRANS ("UI Color"), uiMenu);
     m.addItem (setupAudio, TRANS ("Setup Audio Device..."));    
+
+    if (Mp3Encoder::getInstance()->isEncoding())
+        m.addItem (cancelMp3Encoding, TRANS ("Cancel Audio Encoding"));
+
     m.addSeparator();
 
     if (newVersionIsReady)
@@ -426,6 +433,7 @@ void TopToolBar::systemMenuPerform (const int index)
     else if (index == setUiColor)       setUiColour();
     else if (index == resetUiColor)     resetUiColour();
     else if (index == setupAudio)       setupAudioDevice();
+    else if (index == cancelMp3Encoding) Mp3Encoder::getInstance()->cancelAll();
     else if (index == addExResource)    setExternalResource();
 
     else if (index == checkNewVersion)  URL ("http://underwaySoft.com/works/wdtp/download.html").launchInDefaultBrowser();
@@ -605,6 +613,9 @@ void TopToolBar::closeProject()
 //=================================================================================================
 void TopToolBar::cleanAndGenerateAll()
 {
+    if (FileTreeContainer::stillUnpacking (true))
+        return;
+
     if (AlertWindow::showOkCancelBox (AlertWindow::QuestionIcon,
                                       TRANS ("Confirm"),
                                       TRANS ("Cleanup all needless medias and regenerate the site?")))
@@ -617,7 +628,7 @@ void TopToolBar::cleanAndGenerateAll()
         site.findChildFiles (htmls, File::findFiles, true, "*.html");
 
         for (int i = htmls.size(); --i >= 0; )
-            htmls[i].deleteFile();
+            HtmlProcessor::deletePage (htmls[i]);
 
         // initial progress value
         totalItems = 0;
@@ -667,30 +678,89 @@ void TopToolBar::generateHtmlFiles (ValueTree tree)
 //=================================================================================================
 void TopToolBar::generateHtmlsIfNeeded()
 {
+    if (FileTreeContainer::stillUnpacking (true))
+        return;
+
     FileTreeContainer::projectTree.setProperty ("needCreateHtml", true, nullptr);
-    generateHtmlFilesIfNeeded (FileTreeContainer::projectTree);
-    FileTreeContainer::saveProject();
 
-    SHOW_MESSAGE (TRANS ("All changed items regenerate successful!"));
+    // a big site takes a while, so it runs in background and could be cancelled.
+    // the pages which haven't been generated keep their 'needCreateHtml'.
+    struct GenerateThread : public ThreadWithProgressWindow
+    {
+        GenerateThread() 
+            : ThreadWithProgressWindow (TRANS ("Generating the changed pages..."), true, true)
+        {
+        }
+
+        void run() override
+        {
+            setProgress (-1.0);
+            const HtmlProcessor::ProfilingScope profilingScope;
+
+            {
+                const HtmlProcessor::GenerationScope scope;
+
+                // an add-in file has been changed, so has its url in the pages
+                if (AssetManifest::getInstance()->needsFullUpdate())
+                {
+                    const MessageManagerLock mmLock;
+                    DocTreeViewItem::allChildrenNeedCreate (FileTreeContainer::projectTree);
+                }
+
+                generateHtmlFilesIfNeeded (FileTreeContainer::projectTree, this);
+            }
+
+            const Profiler::ScopedTimer timer ("saveIndexes");
+
+            // the pages which haven't been regenerated are still using the old copies
+            if (!threadShouldExit())
+                AssetManifest::getInstance()->fullUpdateDone();
+
+            AssetManifest::getInstance()->saveForProject();
+            PageDependencies::getInstance()->saveForProject();
+            ResponsiveImages::getInstance()->saveForProject();
+
+            const MessageManagerLock mmLock;
+            FileTreeContainer::saveProject();
+        }
+    };
+
+    GenerateThread thread;
+
+    if (thread.runThread())
+        SHOW_MESSAGE (TRANS ("All changed items regenerate successful!"));
+    else
+        SHOW_MESSAGE (TRANS ("The generation has been cancelled."));
 }
 
 //=================================================================================================
-void TopToolBar::generateHtmlFilesIfNeeded (ValueTree tree)
+void TopToolBar::generateHtmlFilesIfNeeded (ValueTree tree, Thread* threadToCheck)
 {
-    if ((bool)tree.getProperty ("needCreateHtml"))
+    if (threadToCheck != nullptr && threadToCheck->threadShouldExit())
+        return;
+
+    // a page which needs to be regenerated might be inside a dir which doesn't,
+    // so walk all of them. create...Html() only does it when it needs.
+    // the tree is used by the ui as well, so it's locked when it's called in background.
+    if (tree.getType().toString() == "doc")
     {
-        if (tree.getType().toString() == "doc")
-        {
+        const MessageManagerLock mmLock (threadToCheck);
+
+        if (mmLock.lockWasGained())
             HtmlProcessor::createArticleHtml (tree, false);
-        }
-        else
+    }
+    else
+    {
         {
-            HtmlProcessor::createIndexHtml (tree, false);
+            const MessageManagerLock mmLock (threadToCheck);
 
-            for (int i = tree.getNumChildren(); --i >= 0; )
-                generateHtmlFilesIfNeeded (tree.getChild (i));
+            if (mmLock.lockWasGained())
+                HtmlProcessor::createIndexHtml (tree, false);
         }
-    }    
+
+        for (int i = tree.getNumChildren(); --i >= 0; )
+            generateHtmlFilesIfNeeded (tree.getChild (i), threadToCheck);
+    }
 }
 
 //=================================================================================================
@@ -716,7 +786,23 @@ void TopToolBar::hasNewVersion()
 void TopToolBar::run()
 {
     //const uint32 startTime = Time::getMillisecondCounter();
-    generateHtmlFiles (FileTreeContainer::projectTree);
+    {
+        const HtmlProcessor::ProfilingScope profilingScope;
+
+        {
+            const HtmlProcessor::GenerationScope scope;
+            generateHtmlFiles (FileTreeContainer::projectTree);
+        }
+
+        const Profiler::ScopedTimer timer ("saveIndexes");
+        AssetManifest::getInstance()->fullUpdateDone();
+        AssetManifest::getInstance()->saveForProject();
+        PageDependencies::getInstance()->saveForProject();
+        ResponsiveImages::getInstance()->saveForProject();
+
+        FileTreeContainer::saveProject();
+    }
+
     accumulator = 0;
     progressValue = 0.999;
 
@@ -724,7 +810,6 @@ void TopToolBar::run()
                                  TRANS ("Congratulations"),
                                  TRANS ("The site regenerate successful!"));
 
-    FileTreeContainer::saveProject();
     progressValue = 0.0;
 
     const MessageManagerLock mmLock;
@@ -735,6 +820,9 @@ void TopToolBar::run()
 //=================================================================================================
 void TopToolBar::generateCurrentPage()
 {
+    if (FileTreeContainer::stillUnpacking (true))
+        return;
+
     ValueTree tree (editAndPreview->getCurrentTree());
     tree.setProperty ("needCreateHtml", true, nullptr);
 
@@ -949,15 +1037,36 @@ void TopToolBar::setupAudioDevice()
     systemFile->saveIfNeeded();
 }
 
+//=================================================================================================
+void TopToolBar::encodingProgressChanged (const double progress)
+{
+    // the progressBar is showing the generation now
+    if (!isThreadRunning())
+        progressValue = progress;
+}
+
+//=================================================================================================
+void TopToolBar::mp3EncodingFailed (const File& mp3File, const File& docFile)
+{
+    // not a splash, the user must fix the mark (or record it again)
+    AlertWindow::showMessageBoxAsync (AlertWindow::WarningIcon, TRANS ("Message"),
+                                      TRANS ("Can't save this audio, the mark in this doc points to a missing file:")
+                                      + newLine + newLine + docFile.getFullPathName()
+                                      + newLine + "media/" + mp3File.getFileName());
+}
+
 //=================================================================================================
 void TopToolBar::packProject()
 {
+    if (FileTreeContainer::stillUnpacking (true))
+        return;
+
     const File& projectFile (FileTreeContainer::projectFile);
     const String rootPath (projectFile.getParentDirectory().getFullPathName() + File::separatorString);
-    ZipFile::Builder builder;
+    ZipPacker packer;
 
     // add project file
-    builder.addFile (projectFile, 9, projectFile.getFileName());
+    packer.addFile (projectFile, projectFile.getFileName());
 
     // add all doc files (include all doc-dirs)
     const File& docsDir (projectFile.getSiblingFile ("docs"));
@@ -968,8 +1077,8 @@ void TopToolBar::packProject()
     {
         if (docFiles[i].getFileName() != "desktop.ini" 
             && docFiles[i].getFileName() != ".DS_Store")
-            builder.addFile (docFiles[i], 9, 
-                             docFiles[i].getFullPathName().fromFirstOccurrenceOf (rootPath, false, false));
+            packer.addFile (docFiles[i], 
+                            docFiles[i].getFullPathName().fromFirstOccurrenceOf (rootPath, false, false));
     }
     
     // add current themes
@@ -984,8 +1093,8 @@ void TopToolBar::packProject()
     {
         if (themeFiles[j].getFileName() != "desktop.ini" 
             && themeFiles[j].getFileName() != ".DS_Store")
-            builder.addFile (themeFiles[j], 9, 
-                             themeStr + File::separatorString + themeFiles[j].getFileName());
+            packer.addFile (themeFiles[j], 
+                            themeStr + File::separatorString + themeFiles[j].getFileName());
     }
 
     // add add-in dir and all its files
@@ -998,16 +1107,16 @@ void TopToolBar::packProject()
     for (int m = addFiles.size(); --m >= 0; )
     {
         if (addFiles[m].getFileName() != "desktop.ini" 
-            && themeFiles[m].getFileName() != ".DS_Store")
+            && addFiles[m].getFileName() != ".DS_Store")
         {
-            builder.addFile (addFiles[m], 9, addStr + File::separatorString
-                             + addFiles[m].getFileName());
+            packer.addFile (addFiles[m], addStr + File::separatorString
+                            + addFiles[m].getFileName());
         }
     }
 
     // add favicon.ico
-    builder.addFile (projectFile.getSiblingFile ("site").getChildFile ("favicon.ico"), 
-                     9, "site" + File::separatorString + "favicon.ico");
+    packer.addFile (projectFile.getSiblingFile ("site").getChildFile ("favicon.ico"), 
+                    "site" + File::separatorString + "favicon.ico");
 
     // to get the date string ("-2017-0209-0508-16") for zip's file name
     String packDate (SwingUtilities::getCurrentTimeString());
@@ -1018,15 +1127,22 @@ void TopToolBar::packProject()
     // write to zip file
     const File packZipFile (projectFile.getSiblingFile (projectFile.getFileNameWithoutExtension()
                                                         + packDate + ".wpck"));
-    packZipFile.deleteFile();
-    packZipFile.create();
 
-    ScopedPointer<FileOutputStream> out = packZipFile.createOutputStream();
+    // the entries which haven't been changed since the latest pack will be copied from it
+    Array<File> previousPacks;
+    projectFile.getParentDirectory().findChildFiles (previousPacks, File::findFiles, false,
+                                                     projectFile.getFileNameWithoutExtension() + "-*.wpck");
+    File latestPack;
 
-    if (builder.writeToStream (*out, nullptr))
+    for (int i = previousPacks.size(); --i >= 0; )
+    {
+        if (previousPacks[i] != packZipFile
+            && previousPacks[i].getLastModificationTime() > latestPack.getLastModificationTime())
+            latestPack = previousPacks[i];
+    }
+
+    if (packer.writeToFileWithProgress (packZipFile, TRANS ("Packing the project..."), latestPack))
     {
-        out->flush();
-        out = nullptr;
         SHOW_MESSAGE (TRANS ("Pack the project's data successful!"));
 
         packZipFile.revealToUser();
@@ -1289,36 +1405,26 @@ void TopToolBar::setSiteImgs (const int imgType)
 //=================================================================================================
 void TopToolBar::cleanNeedlessMedias (const bool showMessageWhenNoAnyNeedless)
 {
-    // exist medias
+    if (FileTreeContainer::stillUnpacking (true))
+        return;
+
+    // delete extra sub-dir of media (might be backup after external edited medias)
     Array<File> allDirs;
-    Array<File> allMediasOnLocal;
     FileTreeContainer::projectFile.getSiblingFile ("docs").findChildFiles (allDirs, File::findDirectories, true);
 
     for (int i = allDirs.size(); --i >= 0; )
     {
-        // delete extra sub-dir of media (might be backup after external edited medias)
         if (allDirs[i].getParentDirectory().getFileName() == "media")
         {
             allDirs[i].setReadOnly (false, true);
             allDirs[i].deleteRecursively();
         }
-
-        else if (allDirs[i].getFileName() != "media")
-            allDirs.remove (i);
-        
-        else
-            allDirs[i].findChildFiles (allMediasOnLocal, File::findFiles, false);
     }
 
-    // all medias in docs
-    Array<File> allDocs;
-    Array<File> allMediasInDocs;
-    FileTreeContainer::projectFile.getSiblingFile ("docs").findChildFiles (allDocs, File::findFiles, true);
-
-    for (int i = allDocs.size(); --i >= 0; )
-        DocTreeViewItem::getMdMediaFiles (allDocs[i], allMediasInDocs);
-
-    allMediasOnLocal.removeValuesIn (allMediasInDocs);
+    // the medias which no any doc uses, only the changed docs will be parsed again
+    Array<File> allMediasOnLocal;
+    MediaIndex::getInstance()->getNeedlessMedias (allMediasOnLocal);
+    MediaIndex::getInstance()->saveForProject();
 
     if (allMediasOnLocal.size() < 1)
     {
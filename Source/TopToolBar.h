@@ -20,6 +20,7 @@ class TopToolBar :  public Component,
                     private Button::Listener,
                     public ChangeListener,
                     public ApplicationCommandTarget,
+                    private Mp3Encoder::Listener,
                     private Thread
 {
 public:
@@ -44,7 +45,8 @@ public:
     virtual void getCommandInfo (CommandID commandID, ApplicationCommandInfo& result) override;
     virtual bool perform (const InvocationInfo& info) override;
 
-    static void generateHtmlFilesIfNeeded (ValueTree tree);
+    /** if arg-2 isn't nullptr, it's called on that thread, and it stops once the thread should exit */
+    static void generateHtmlFilesIfNeeded (ValueTree tree, Thread* threadToCheck = nullptr);
     
     enum LanguageID { English = 0, Chinese = 1 };
     void setUiLanguage (const LanguageID& id);
@@ -60,6 +62,10 @@ private:
     virtual void textEditorReturnKeyPressed (TextEditor&) override;
     virtual void textEditorEscapeKeyPressed (TextEditor&) override;
 
+    /** the recorded audio is encoding in background, show it by the progressBar */
+    virtual void encodingProgressChanged (const double progress) override;
+    virtual void mp3EncodingFailed (const File& mp3File, const File& docFile) override;
+
     void keywordSearch (const bool next);
     virtual void buttonClicked (Button*) override;
     void popupSystemMenu();
@@ -119,7 +125,7 @@ public:
         wdtpUpdateList, gettingStarted, syntax, faq, feedback, 
         addExResource, showAboutDialog, exitApp,
         switchEdit, silentMode, activeSearch,
-        minimizeTheApp
+        minimizeTheApp, cancelMp3Encoding
     };
 
 private:
@@ -14,12 +14,22 @@
 #include "JuceHeader.h"
 #include "SwingLibrary/SwingUtilities.h"
 #include "SwingLibrary/SwingLookAndFeel.h"
+#include "SwingLibrary/WorkerPool.h"
+#include "SwingLibrary/ImageProcessor.h"
+#include "SwingLibrary/MultiReplacer.h"
+#include "SwingLibrary/Profiler.h"
+#include "SwingLibrary/HtmlMinifier.h"
+#include "SwingLibrary/CodeHighlighter.h"
+#include "SwingLibrary/ZipPacker.h"
+#include "SwingLibrary/ZipUnpacker.h"
 #include "SwingLibrary/MD2Html.h"
 #include "SwingLibrary/AudioDataPlayer.h"
 #include "SwingLibrary/AudioRecorder.h"
 #include "MainComponent.h"
+#include "Mp3Encoder.h"
 #include "TopToolBar.h"
 #include "MarkdownEditor.h"
+#include "DocSaver.h"
 #include "EditAndPreview.h"
 #include "SetupPanel.h"
 #include "ThemeEditor.h"
@@ -31,5 +41,10 @@
 #include "KeywordsComp.h"
 #include "RecordComp.h"
 #include "TipsBank.h"
+#include "PageDependencies.h"
+#include "MediaIndex.h"
+#include "ResponsiveImages.h"
+#include "AssetManifest.h"
+#include "DocStatistics.h"
 
 #endif  // HEADERGUA
@@ -273,13 +273,59 @@ private:
     JUCE_LEAK_DETECTOR (UniformTextSection)
 };
 
+//==============================================================================
+// the glyphs of the atoms laid out at (0, 0). most atoms are a single char or a short word,
+// so the same few thousand ones are drawn again and again while scrolling or dragging.
+class TextEditor::GlyphCache
+{
+public:
+    GlyphCache() {}
+
+    const GlyphArrangement& get (const Font& font, const String& text)
+    {
+        if (font != cachedFont)
+        {
+            clear();
+            cachedFont = font;
+        }
+
+        if (GlyphArrangement* const cached = glyphs [text])
+            return *cached;
+
+        if (arrangements.size() >= maxNumArrangements)
+            clear();
+
+        GlyphArrangement* const ga = arrangements.add (new GlyphArrangement());
+        ga->addLineOfText (font, text, 0.0f, 0.0f);
+        glyphs.set (text, ga);
+
+        return *ga;
+    }
+
+    void clear()
+    {
+        glyphs.clear();
+        arrangements.clear();
+    }
+
+private:
+    enum { maxNumArrangements = 4096 };
+
+    Font cachedFont;
+    HashMap<String, GlyphArrangement*> glyphs;
+    OwnedArray<GlyphArrangement> arrangements;
+
+    JUCE_DECLARE_NON_COPYABLE (GlyphCache)
+};
+
 //==============================================================================
 class TextEditor::Iterator
 {
 public:
     Iterator (const OwnedArray<UniformTextSection>& sectionList,
               const float wrapWidth,
-              const juce_wchar passwordChar)
+              const juce_wchar passwordChar,
+              const LayoutCheckpoint* checkpoint = nullptr)
       : indexInText (0),
         lineY (0),
         lineHeight (0),
@@ -296,7 +342,25 @@ public:
     {
         jassert (wordWrapWidth > 0);
 
-        if (sections.size() > 0)
+        if (checkpoint != nullptr)
+        {
+            // continue from the end of a paragraph which has been laid out before,
+            // next() will begin the new line just as it did at that time
+            indexInText = checkpoint->indexInText;
+            lineY = checkpoint->lineY;
+            lineHeight = checkpoint->lineHeight;
+            maxDescent = checkpoint->maxDescent;
+            atomX = checkpoint->atomX;
+            atomRight = checkpoint->atomRight;
+            sectionIndex = checkpoint->sectionIndex;
+            atomIndex = checkpoint->atomIndex;
+
+            currentSection = sections.getUnchecked (sectionIndex);
+            atom = currentSection->atoms.getUnchecked (atomIndex - 1);
+
+            jassert (atom->isNewLine());
+        }
+        else if (sections.size() > 0)
         {
             currentSection = sections.getUnchecked (sectionIndex);
 
@@ -521,7 +585,7 @@ public:
     }
 
     //==============================================================================
-    void draw (Graphics& g, const UniformTextSection*& lastSection) const
+    void draw (Graphics& g, const UniformTextSection*& lastSection, GlyphCache& glyphCache) const
     {
         if (passwordCharacter != 0 || ! atom->isWhitespace())
         {
@@ -534,40 +598,21 @@ public:
 
             jassert (atom->getTrimmedText (passwordCharacter).isNotEmpty());
 
-            GlyphArrangement ga;
             const String& content (atom->getTrimmedText (passwordCharacter));
+            const juce_wchar firstChar = content[0];
 
             // simple syntax highlight
-            if (content.substring (0, 1) == "#"
-                || content.substring (0, 1) == "`"
-                || content.substring (0, 1) == "("
-                || content.substring (0, 1) == ")"
-                || content.substring (0, 1) == "-"
-                || content.substring (0, 1) == "+"
-                || content.substring (0, 1) == "^"
-                || content.substring (0, 1) == "\\"
-                || content.substring (0, 1) == "<"
-                || content.substring (0, 1) == ">"
-                || content.substring (0, 1) == "["
-                || content.substring (0, 1) == "]"
-                || content.substring (0, 1) == "="
-                || content.substring (0, 1) == "/"
-                || content.substring (0, 1) == "~"
-                || content.substring (0, 1) == "|"
-                || content.substring (0, 1) == "{"
-                || content.substring (0, 1) == "}")
+            if (CharPointer_ASCII ("#`()-+^\\<>[]=/~|{}").indexOf (firstChar) >= 0)
                 g.setColour (Colours::darkred);
 
-            else if (content.substring (0, 1) == "*")
+            else if (firstChar == '*')
                 g.setColour (Colours::darkgreen);
 
             else
                 g.setColour (currentSection->colour);
 
-            ga.addLineOfText (currentSection->font,
-                              content,
-                              atomX, (float) roundToInt (lineY + lineHeight - maxDescent - 2));
-            ga.draw (g);
+            glyphCache.get (currentSection->font, content)
+                .draw (g, AffineTransform::translation (atomX, (float) roundToInt (lineY + lineHeight - maxDescent - 2)));
         }
     }
 
@@ -695,6 +740,31 @@ public:
         return false;
     }
 
+    //==============================================================================
+    /** true if the current atom is a newline, the layout after it doesn't depend on anything before */
+    bool isAtEndOfParagraph() const noexcept
+    {
+        return atom != nullptr && atom != &tempAtom && atom->isNewLine();
+    }
+
+    LayoutCheckpoint getCheckpoint (const float maxRight) const
+    {
+        jassert (isAtEndOfParagraph());
+
+        LayoutCheckpoint checkpoint;
+        checkpoint.indexInText = indexInText;
+        checkpoint.sectionIndex = sectionIndex;
+        checkpoint.atomIndex = atomIndex;
+        checkpoint.lineY = lineY;
+        checkpoint.lineHeight = lineHeight;
+        checkpoint.maxDescent = maxDescent;
+        checkpoint.atomX = atomX;
+        checkpoint.atomRight = atomRight;
+        checkpoint.maxRight = maxRight;
+
+        return checkpoint;
+    }
+
     //==============================================================================
     int indexInText;
     float lineY, lineHeight, maxDescent;
@@ -956,7 +1026,11 @@ TextEditor::TextEditor (const String& name,
       caretPosition (0),
       passwordCharacter (passwordChar),
       keyboardType (TextInputTarget::textKeyboard),
-      dragType (notDragging)
+      dragType (notDragging),
+      checkpointsWrapWidth (0),
+      textCacheIsValid (false),
+      textVersion (0),
+      glyphCache (new GlyphCache())
 {
     setOpaque (true);
     setMouseCursor (MouseCursor::IBeamCursor);
@@ -1104,6 +1178,7 @@ void TextEditor::applyFontToAllText (const Font& newFont)
     }
 
     coalesceSimilarSections();
+    invalidateLayoutFrom (0);
     updateTextHolderSize();
     scrollToMakeSureCursorIsVisible();
     repaint();
@@ -1324,7 +1399,8 @@ void TextEditor::repaintText (const Range<int> range)
 
         if (wordWrapWidth > 0)
         {
-            Iterator i (sections, wordWrapWidth, passwordCharacter);
+            Iterator i (sections, wordWrapWidth, passwordCharacter,
+                        findCheckpointBeforeIndex (range.getStart()));
 
             i.getCharPosition (range.getStart(), x, y, lh);
 
@@ -1437,13 +1513,28 @@ void TextEditor::updateTextHolderSize()
 
     if (wordWrapWidth > 0)
     {
-        float maxWidth = 0.0f;
+        if (checkpointsWrapWidth != wordWrapWidth)
+        {
+            layoutCheckpoints.clearQuick();
+            checkpointsWrapWidth = wordWrapWidth;
+        }
+
+        // only lay out the paragraphs after the last one which hasn't been changed
+        const LayoutCheckpoint* const lastCheckpoint = (layoutCheckpoints.size() > 0)
+            ? &layoutCheckpoints.getReference (layoutCheckpoints.size() - 1) : nullptr;
 
-        Iterator i (sections, wordWrapWidth, passwordCharacter);
+        float maxWidth = (lastCheckpoint != nullptr) ? lastCheckpoint->maxRight : 0.0f;
+
+        Iterator i (sections, wordWrapWidth, passwordCharacter, lastCheckpoint);
 
         while (i.next())
+        {
             maxWidth = jmax (maxWidth, i.atomRight);
 
+            if (i.isAtEndOfParagraph())
+                layoutCheckpoints.add (i.getCheckpoint (maxWidth));
+        }
+
         const int w = leftIndent + roundToInt (maxWidth);
         const int h = topIndent + roundToInt (jmax (i.lineY + i.lineHeight,
                                                     currentFont.getHeight()));
@@ -1636,7 +1727,9 @@ void TextEditor::drawContent (Graphics& g)
         const Rectangle<int> clip (g.getClipBounds());
         Colour selectedTextColour;
 
-        Iterator i (sections, wordWrapWidth, passwordCharacter);
+        // the paragraphs above the clip needn't be laid out again
+        const LayoutCheckpoint* const checkpoint = findCheckpointAboveY ((float) clip.getY());
+        Iterator i (sections, wordWrapWidth, passwordCharacter, checkpoint);
 
         if (! selection.isEmpty())
         {
@@ -1671,7 +1764,7 @@ void TextEditor::drawContent (Graphics& g)
                 }
                 else
                 {
-                    i.draw (g, lastSection);
+                    i.draw (g, lastSection, *glyphCache);
                 }
             }
         }
@@ -1680,7 +1773,7 @@ void TextEditor::drawContent (Graphics& g)
         {
             const Range<int> underlinedSection = underlinedSections.getReference (j);
 
-            Iterator i2 (sections, wordWrapWidth, passwordCharacter);
+            Iterator i2 (sections, wordWrapWidth, passwordCharacter, checkpoint);
 
             while (i2.next() && i2.lineY < clip.getBottom())
             {
@@ -2286,7 +2379,10 @@ void TextEditor::insert (const String& text,
                 sections.add (new UniformTextSection (text, font, colour, passwordCharacter));
 
             coalesceSimilarSections();
+            invalidateLayoutFrom (insertIndex);
             totalNumChars = -1;
+            textCacheIsValid = false;
+            ++textVersion;
             valueTextNeedsUpdating = true;
 
             updateTextHolderSize();
@@ -2333,7 +2429,10 @@ void TextEditor::reinsert (const int insertIndex, const OwnedArray<UniformTextSe
     }
 
     coalesceSimilarSections();
+    invalidateLayoutFrom (insertIndex);
     totalNumChars = -1;
+    textCacheIsValid = false;
+    ++textVersion;
     valueTextNeedsUpdating = true;
 }
 
@@ -2420,7 +2519,10 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
             }
 
             coalesceSimilarSections();
+            invalidateLayoutFrom (range.getStart());
             totalNumChars = -1;
+            textCacheIsValid = false;
+            ++textVersion;
             valueTextNeedsUpdating = true;
 
             moveCaretTo (caretPositionToMoveTo, false);
@@ -2433,13 +2535,20 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
 //==============================================================================
 String TextEditor::getText() const
 {
-    MemoryOutputStream mo;
-    mo.preallocate ((size_t) getTotalNumChars());
+    // the editors call this on every key, it's only built again after the text changed
+    if (! textCacheIsValid)
+    {
+        MemoryOutputStream mo;
+        mo.preallocate ((size_t) getTotalNumChars());
 
-    for (int i = 0; i < sections.size(); ++i)
-        sections.getUnchecked (i)->appendAllText (mo);
+        for (int i = 0; i < sections.size(); ++i)
+            sections.getUnchecked (i)->appendAllText (mo);
 
-    return mo.toUTF8();
+        textCache = mo.toUTF8();
+        textCacheIsValid = true;
+    }
+
+    return textCache;
 }
 
 String TextEditor::getTextInRange (const Range<int>& range) const
@@ -2447,25 +2556,43 @@ String TextEditor::getTextInRange (const Range<int>& range) const
     if (range.isEmpty())
         return String();
 
+    if (textCacheIsValid)
+        return textCache.substring (range.getStart(), range.getEnd());
+
     MemoryOutputStream mo;
     mo.preallocate ((size_t) jmin (getTotalNumChars(), range.getLength()));
 
-    int index = 0;
+    // start from the paragraph which includes the range's start instead of the first atom
+    int index = 0, sectionIndex = 0, atomIndex = 0;
 
-    for (int i = 0; i < sections.size(); ++i)
+    if (const LayoutCheckpoint* const checkpoint = findCheckpointBeforeIndex (range.getStart(), false))
+    {
+        sectionIndex = checkpoint->sectionIndex;
+        atomIndex = checkpoint->atomIndex;
+        index = checkpoint->indexInText
+                  + sections.getUnchecked (sectionIndex)->atoms.getUnchecked (atomIndex - 1)->numChars;
+    }
+
+    for (int i = sectionIndex; i < sections.size(); ++i)
     {
         const UniformTextSection* const s = sections.getUnchecked (i);
-        const int nextIndex = index + s->getTotalLength();
 
-        if (range.getStart() < nextIndex)
+        for (int j = (i == sectionIndex ? atomIndex : 0); j < s->atoms.size(); ++j)
         {
+            const TextAtom* const atom = s->atoms.getUnchecked (j);
+            const int nextIndex = index + atom->numChars;
+
             if (range.getEnd() <= index)
-                break;
+                return mo.toUTF8();
 
-            s->appendSubstring (mo, range - index);
-        }
+            if (range.getStart() < nextIndex)
+            {
+                const Range<int> r ((range - index).getIntersectionWith (Range<int> (0, (int) atom->numChars)));
+                mo << atom->atomText.substring (r.getStart(), r.getEnd());
+            }
 
-        index = nextIndex;
+            index = nextIndex;
+        }
     }
 
     return mo.toUTF8();
@@ -2500,7 +2627,7 @@ void TextEditor::getCharPosition (const int index, float& cx, float& cy, float&
 
     if (wordWrapWidth > 0 && sections.size() > 0)
     {
-        Iterator i (sections, wordWrapWidth, passwordCharacter);
+        Iterator i (sections, wordWrapWidth, passwordCharacter, findCheckpointBeforeIndex (index));
 
         i.getCharPosition (index, cx, cy, lineHeight);
     }
@@ -2517,7 +2644,7 @@ int TextEditor::indexAtPosition (const float x, const float y)
 
     if (wordWrapWidth > 0)
     {
-        Iterator i (sections, wordWrapWidth, passwordCharacter);
+        Iterator i (sections, wordWrapWidth, passwordCharacter, findCheckpointAboveY (y));
 
         while (i.next())
         {
@@ -2610,3 +2737,60 @@ void TextEditor::coalesceSimilarSections()
         }
     }
 }
+
+//==============================================================================
+// the sections and atoms before a changed index are never touched by insert() / remove(),
+// so are the checkpoints whose newline atom is before it.
+void TextEditor::invalidateLayoutFrom (const int index)
+{
+    int numToKeep = layoutCheckpoints.size();
+
+    while (numToKeep > 0 && layoutCheckpoints.getReference (numToKeep - 1).indexInText >= index)
+        --numToKeep;
+
+    layoutCheckpoints.removeRange (numToKeep, layoutCheckpoints.size() - numToKeep);
+}
+
+const TextEditor::LayoutCheckpoint* TextEditor::findCheckpointBeforeIndex (const int index, const bool forLayout) const
+{
+    // the sections and atoms of a checkpoint are still right after the wrap width changed
+    if (forLayout && checkpointsWrapWidth != getWordWrapWidth())
+        return nullptr;
+
+    // the last one whose newline atom is before the index
+    int start = 0, end = layoutCheckpoints.size();
+
+    while (start < end)
+    {
+        const int middle = (start + end) / 2;
+
+        if (layoutCheckpoints.getReference (middle).indexInText < index)
+            start = middle + 1;
+        else
+            end = middle;
+    }
+
+    return (start > 0) ? &layoutCheckpoints.getReference (start - 1) : nullptr;
+}
+
+const TextEditor::LayoutCheckpoint* TextEditor::findCheckpointAboveY (const float y) const
+{
+    if (checkpointsWrapWidth != getWordWrapWidth())
+        return nullptr;
+
+    // the last one whose whole line is above y
+    int start = 0, end = layoutCheckpoints.size();
+
+    while (start < end)
+    {
+        const int middle = (start + end) / 2;
+        const LayoutCheckpoint& checkpoint = layoutCheckpoints.getReference (middle);
+
+        if (checkpoint.lineY + checkpoint.lineHeight <= y)
+            start = middle + 1;
+        else
+            end = middle;
+    }
+
+    return (start > 0) ? &layoutCheckpoints.getReference (start - 1) : nullptr;
+}
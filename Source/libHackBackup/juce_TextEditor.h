@@ -313,6 +313,11 @@ public:
     /** Returns a section of the contents of the editor. */
     String getTextInRange (const Range<int>& textRange) const override;
 
+    /** Returns a number which is increased each time the text is changed.
+        Comparing it is far more efficient than comparing the text with getText().
+    */
+    int getTextVersion() const noexcept                 { return textVersion; }
+
     /** Returns true if there are no characters in the editor.
         This is far more efficient than calling getText().isEmpty().
     */
@@ -663,6 +668,7 @@ protected:
 private:
     //==============================================================================
     class Iterator;
+    class GlyphCache;
     JUCE_PUBLIC_IN_DLL_BUILD (class UniformTextSection)
     class TextHolderComponent;
     class InsertAction;
@@ -716,6 +722,28 @@ private:
     ListenerList<Listener> listeners;
     Array<Range<int> > underlinedSections;
 
+    /** the layout state at the end of a paragraph (right after its newline atom).
+        the Iterator could start from one of these instead of the beginning of the text,
+        so that typing near the end of a long text won't lay out all the text again. */
+    struct LayoutCheckpoint
+    {
+        int indexInText, sectionIndex, atomIndex;
+        float lineY, lineHeight, maxDescent, atomX, atomRight;
+        float maxRight;  // the widest line until here
+    };
+
+    Array<LayoutCheckpoint> layoutCheckpoints;  // in the order of the text, see updateTextHolderSize()
+    float checkpointsWrapWidth;
+
+    void invalidateLayoutFrom (int index);
+    const LayoutCheckpoint* findCheckpointBeforeIndex (int index, bool forLayout = true) const;
+    const LayoutCheckpoint* findCheckpointAboveY (float y) const;
+
+    mutable String textCache;  // see getText()
+    mutable bool textCacheIsValid;
+    int textVersion;
+    ScopedPointer<GlyphCache> glyphCache;
+
     void moveCaret (int newCaretPos);
     void moveCaretTo (int newPosition, bool isSelecting);
     void recreateCaret();